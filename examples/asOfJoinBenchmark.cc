@@ -0,0 +1,111 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Measure AsOfJoin on two sorted streams of TAI times, compared with a
+ * binary search of the right stream for every left time.
+ *
+ * Usage: asOfJoinBenchmark [nRows [nThreads]]
+ *
+ * Each stream has nRows times; a second pass joins a left stream with one
+ * time for every thousand right times.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/AsOfJoin.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+long long const T0 = 1700000000000000000LL;
+
+template <typename F>
+void report(std::string const& label, std::size_t nRows, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(36) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << 1.0e9 * elapsed.count() / nRows << " ns/row" << std::endl;
+}
+
+// Sorted times with random gaps averaging `step`
+std::vector<long long> makeTimes(std::size_t n, long long step, std::mt19937_64& rng) {
+    std::uniform_int_distribution<long long> gap(0, 2 * step);
+    std::vector<long long> times(n);
+    long long t = T0;
+    for (auto& time : times) {
+        t += gap(rng);
+        time = t;
+    }
+    return times;
+}
+
+void compare(std::vector<long long> const& left, std::vector<long long> const& right, int nThreads) {
+    std::vector<long long> indices(left.size());
+    std::vector<long long> expected(left.size());
+    report("binary search per row", left.size(), [&]() {
+        for (std::size_t i = 0; i < left.size(); ++i) {
+            expected[i] = std::upper_bound(right.begin(), right.end(), left[i]) - right.begin() - 1;
+        }
+    });
+    std::vector<std::pair<std::string, dafBase::AsOfJoin::Direction>> const directions = {
+            {"backward", dafBase::AsOfJoin::BACKWARD},
+            {"forward", dafBase::AsOfJoin::FORWARD},
+            {"nearest", dafBase::AsOfJoin::NEAREST}};
+    for (auto const& direction : directions) {
+        dafBase::AsOfJoin const join(direction.second);
+        report("AsOfJoin " + direction.first, left.size(), [&]() {
+            join(left.data(), left.size(), right.data(), right.size(), indices.data(), nThreads);
+        });
+        if (direction.second == dafBase::AsOfJoin::BACKWARD && indices != expected) {
+            std::cerr << "Mismatch between AsOfJoin and binary search" << std::endl;
+            std::exit(1);
+        }
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const nRows = argc > 1 ? std::atol(argv[1]) : 100000000;
+    int const nThreads = argc > 2 ? std::atoi(argv[2]) : 0;
+    std::mt19937_64 rng(42);
+    std::vector<long long> const right = makeTimes(nRows, 1000, rng);
+
+    std::cout << "Dense left stream, " << nRows << " rows" << std::endl;
+    compare(makeTimes(nRows, 1000, rng), right, nThreads);
+
+    std::cout << "Sparse left stream, " << nRows / 1000 << " rows" << std::endl;
+    compare(makeTimes(nRows / 1000, 1000000, rng), right, nThreads);
+    return 0;
+}
@@ -0,0 +1,95 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Remove 1000 of the 5000 cards of a PropertyList, one name at a time, with
+ * a single remove of the whole list of names, and with removeIf.  The header
+ * is copied before each iteration, outside the timed region.
+ *
+ * Usage: bulkRemoveBenchmark [nIter]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+int const N_CARDS = 5000;
+int const N_REMOVED = 1000;
+
+template <typename F>
+void report(std::string const& label, int nIter, dafBase::PropertyList const& header, F func) {
+    std::chrono::duration<double> elapsed(0.0);
+    for (int i = 0; i < nIter; ++i) {
+        auto copy = std::static_pointer_cast<dafBase::PropertyList>(header.deepCopy());
+        auto const start = std::chrono::steady_clock::now();
+        func(*copy);
+        elapsed += std::chrono::steady_clock::now() - start;
+        if (copy->nameCount() != N_CARDS - N_REMOVED || copy->getOrderedNames().size() != copy->nameCount()) {
+            std::cerr << label << ": wrong number of cards left" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
+    }
+    std::cout << std::left << std::setw(30) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(3) << 1.0e3 * elapsed.count() / nIter << " ms" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 10;
+
+    // Every fifth card is instrument-specific, so removed cards are spread through the header
+    dafBase::PropertyList header;
+    std::vector<std::string> names;
+    for (int i = 0; i < N_CARDS; ++i) {
+        std::string name = (i % 5 == 0 ? "INST" : "KEY") + std::to_string(i);
+        header.set(name, i, "comment for " + name);
+        if (i % 5 == 0) {
+            names.push_back(name);
+        }
+    }
+
+    report("remove(name) loop", nIter, header, [&](dafBase::PropertyList& pl) {
+        for (auto const& name : names) {
+            pl.remove(name);
+        }
+    });
+    report("remove(names)", nIter, header, [&](dafBase::PropertyList& pl) { pl.remove(names); });
+    report("removeIf", nIter, header, [](dafBase::PropertyList& pl) {
+        pl.removeIf([](std::string const& name, std::type_info const&, boost::any const&) {
+            return name.compare(0, 4, "INST") == 0;
+        });
+    });
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the throughput of concurrent appends to an array-valued property
+ * with ConcurrentArray, compared with PropertySet::add under a mutex.
+ *
+ * Usage: concurrentArrayBenchmark [nAdds [maxThreads]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "lsst/daf/base/ConcurrentArray.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+// Run nAdds calls of func(value) spread over nThreads threads; return millions of calls per second
+template <typename F>
+double run(int nThreads, int nAdds, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = t; i < nAdds; i += nThreads) {
+                func(0.5 * i);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    return 1.0e-6 * nAdds / elapsed.count();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nAdds = argc > 1 ? std::atoi(argv[1]) : 4000000;
+    int const maxThreads = argc > 2 ? std::atoi(argv[2]) : 64;
+
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "mutex+add (M/s)" << std::setw(24)
+              << "ConcurrentArray (M/s)" << std::endl;
+    std::size_t sink = 0;
+    for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        dafBase::PropertySet ps;
+        std::mutex mutex;
+        double const locked = run(nThreads, nAdds, [&](double v) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ps.add("SAMPLES", v);
+        });
+        sink += ps.valueCount("SAMPLES");
+
+        dafBase::ConcurrentArray<double> array;
+        double const lockFree = run(nThreads, nAdds, [&array](double v) { array.add(v); });
+        sink += array.snapshot().size();
+
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2) << std::setw(20) << locked
+                  << std::setw(24) << lockFree << std::endl;
+    }
+    return sink == 0;
+}
@@ -0,0 +1,129 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the throughput of threads that each write to their own branch,
+ * "tasks.t<n>", of a shared PropertySet: under a single outer mutex, in
+ * concurrent mode by hierarchical name, and in concurrent mode through the
+ * branch itself.
+ *
+ * Usage: concurrentPropertySetBenchmark [nWrites [maxThreads]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/daf/base/PropertySet.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+int const N_KEYS = 16;  // distinct properties written by each thread
+
+// Run nWrites calls of func(thread, i) spread over nThreads threads; return millions of calls per second
+template <typename F>
+double run(int nThreads, int nWrites, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int i = t; i < nWrites; i += nThreads) {
+                func(t, i);
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    return 1.0e-6 * nWrites / elapsed.count();
+}
+
+// Full names of the properties written by each thread, so that the timing excludes formatting them
+std::vector<std::vector<std::string>> makeNames(int nThreads) {
+    std::vector<std::vector<std::string>> names(nThreads);
+    for (int t = 0; t < nThreads; ++t) {
+        for (int k = 0; k < N_KEYS; ++k) {
+            names[t].push_back("tasks.t" + std::to_string(t) + ".KEY" + std::to_string(k));
+        }
+    }
+    return names;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nWrites = argc > 1 ? std::atoi(argv[1]) : 4000000;
+    int const maxThreads = argc > 2 ? std::atoi(argv[2]) : 64;
+    std::vector<std::string> keys;
+    for (int k = 0; k < N_KEYS; ++k) {
+        keys.push_back("KEY" + std::to_string(k));
+    }
+
+    std::cout << std::setw(8) << "threads" << std::setw(20) << "outer mutex (M/s)" << std::setw(20)
+              << "concurrent (M/s)" << std::setw(20) << "via branch (M/s)" << std::endl;
+    std::size_t sink = 0;
+    for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        auto const names = makeNames(nThreads);
+
+        dafBase::PropertySet locked;
+        std::mutex mutex;
+        double const outer = run(nThreads, nWrites, [&](int t, int i) {
+            std::lock_guard<std::mutex> lock(mutex);
+            locked.set(names[t][i % N_KEYS], i);
+        });
+        sink += locked.nameCount(false);
+
+        dafBase::PropertySet concurrent;
+        concurrent.makeConcurrent();
+        double const byName = run(nThreads, nWrites, [&](int t, int i) {
+            concurrent.set(names[t][i % N_KEYS], i);
+        });
+        sink += concurrent.nameCount(false);
+
+        dafBase::PropertySet tree;
+        tree.makeConcurrent();
+        std::vector<dafBase::PropertySet::Ptr> branches;
+        for (int t = 0; t < nThreads; ++t) {
+            tree.set("tasks.t" + std::to_string(t), std::make_shared<dafBase::PropertySet>());
+            branches.push_back(tree.getAsPropertySetPtr("tasks.t" + std::to_string(t)));
+        }
+        double const byBranch = run(nThreads, nWrites, [&](int t, int i) {
+            branches[t]->set(keys[i % N_KEYS], i);
+        });
+        sink += tree.nameCount(false);
+
+        std::cout << std::setw(8) << nThreads << std::fixed << std::setprecision(2) << std::setw(20) << outer
+                  << std::setw(20) << byName << std::setw(20) << byBranch << std::endl;
+    }
+    return sink == 0;
+}
@@ -0,0 +1,89 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the cost of converting between DateTime and std::chrono time
+ * points, and of DateTime arithmetic with durations.
+ *
+ * Usage: dateTimeChronoBenchmark [nIter]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "lsst/daf/base/DateTime.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+long long sink = 0;
+
+template <typename F>
+void report(std::string const& label, int nIter, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        sink += func(i);
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(36) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << 1.0e9 * elapsed.count() / nIter << " ns" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 10000000;
+    using std::chrono::nanoseconds;
+    dafBase::DateTime const recent("2020-01-01T00:00:00Z", dafBase::DateTime::UTC);
+    dafBase::DateTime const early("1965-01-01T00:00:00Z", dafBase::DateTime::UTC);
+    long long const recentUtc = recent.nsecs(dafBase::DateTime::UTC);
+    long long const earlyUtc = early.nsecs(dafBase::DateTime::UTC);
+    auto const now = std::chrono::system_clock::now();
+
+    report("DateTime(nsecs, TAI)", nIter,
+           [&](int i) { return dafBase::DateTime(recent.nsecs() + i).nsecs(); });
+    report("DateTime(nsecs, UTC), recent", nIter,
+           [&](int i) { return dafBase::DateTime(recentUtc + i, dafBase::DateTime::UTC).nsecs(); });
+    report("DateTime(nsecs, UTC), 1965", nIter,
+           [&](int i) { return dafBase::DateTime(earlyUtc + i, dafBase::DateTime::UTC).nsecs(); });
+    report("DateTime(system_clock::time_point)", nIter,
+           [&](int i) { return dafBase::DateTime(now + nanoseconds(i)).nsecs(); });
+    report("DateTime::toSystemTime", nIter,
+           [&](int i) { return (recent + nanoseconds(i)).toSystemTime().time_since_epoch().count(); });
+    report("DateTime + duration - DateTime", nIter,
+           [&](int i) { return ((recent + nanoseconds(i)) - recent).count(); });
+#if LSST_DAF_BASE_HAVE_TAI_CLOCK
+    report("DateTime(tai_clock::time_point)", nIter, [&](int i) {
+        return dafBase::DateTime(recent.toTaiTime() + nanoseconds(i)).nsecs();
+    });
+    report("DateTime(utc_clock::time_point)", nIter, [&](int i) {
+        return dafBase::DateTime(recent.toUtcTime() + nanoseconds(i)).nsecs();
+    });
+#endif
+    return sink == 0;
+}
@@ -0,0 +1,99 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare PropertySet::getAsDateTime with parsing the value of a property
+ * on every read, for repeated reads of ISO8601 and MJD properties and for
+ * reads that follow every update, which always miss the cache.
+ *
+ * Usage: getAsDateTimeBenchmark [nIter]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+template <typename F>
+void report(std::string const& label, int nIter, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func(i);
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(40) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << 1.0e9 * elapsed.count() / nIter << " ns/read" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 50000;
+    dafBase::DateTime::Timescale const utc = dafBase::DateTime::UTC;
+    dafBase::PropertyList header;
+    for (int i = 0; i < 100; ++i) {
+        header.set("KEY" + std::to_string(i), i, "filler");
+    }
+    header.set("DATE-OBS", std::string("2023-01-15T03:04:05.123456Z"), "start of exposure");
+    header.set("DATE-BEG", std::string("2023-01-15T03:04:05.123456"), "start of exposure, FITS style");
+    header.set("MJD-OBS", 59959.127837, "start of exposure");
+    header.set("DATE-AVG", dafBase::DateTime("2023-01-15T03:04:20Z", utc), "middle of exposure");
+
+    long long sink = 0;
+    report("getAsString + DateTime(iso)", nIter, [&](int) {
+        sink += dafBase::DateTime(header.getAsString("DATE-OBS"), utc).nsecs();
+    });
+    report("getAsDateTime (ISO, repeated)", nIter,
+           [&](int) { sink += header.getAsDateTime("DATE-OBS", utc).nsecs(); });
+    report("getAsDouble + DateTime(mjd)", nIter, [&](int) {
+        sink += dafBase::DateTime(header.getAsDouble("MJD-OBS"), dafBase::DateTime::MJD, utc).nsecs();
+    });
+    report("getAsDateTime (MJD, repeated)", nIter,
+           [&](int) { sink += header.getAsDateTime("MJD-OBS", utc).nsecs(); });
+    report("get<DateTime>", nIter, [&](int) { sink += header.get<dafBase::DateTime>("DATE-AVG").nsecs(); });
+    report("getAsDateTime (DateTime)", nIter,
+           [&](int) { sink += header.getAsDateTime("DATE-AVG", utc).nsecs(); });
+    report("getAsDateTime (ISO, alternating scale)", nIter, [&](int i) {
+        sink += header.getAsDateTime("DATE-BEG", i % 2 ? utc : dafBase::DateTime::TAI).nsecs();
+    });
+
+    std::string const dates[] = {"2023-01-15T03:04:05.123456Z", "2023-01-15T03:04:35.123456Z"};
+    report("set + getAsDateTime (always misses)", nIter / 10, [&](int i) {
+        header.set("DATE-OBS", dates[i % 2]);
+        sink += header.getAsDateTime("DATE-OBS", utc).nsecs();
+    });
+    report("set + getAsString + DateTime(iso)", nIter / 10, [&](int i) {
+        header.set("DATE-OBS", dates[i % 2]);
+        sink += dafBase::DateTime(header.getAsString("DATE-OBS"), utc).nsecs();
+    });
+    return sink == 0;
+}
@@ -0,0 +1,133 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure HeaderCache throughput as the number of threads grows, compared
+ * with reading every header again.  Headers are parsed from "NAME=VALUE"
+ * text files written to a temporary directory.
+ *
+ * Usage: headerCacheBenchmark [nFiles [nCards [nGets]]]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "lsst/daf/base/HeaderCache.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+std::shared_ptr<dafBase::PropertyList> readHeader(std::string const& path, int) {
+    auto header = std::make_shared<dafBase::PropertyList>();
+    std::ifstream is(path);
+    std::string line;
+    while (std::getline(is, line)) {
+        auto const eq = line.find('=');
+        header->set(line.substr(0, eq), line.substr(eq + 1), "");
+    }
+    return header;
+}
+
+// Run nGets requests for random files spread over nThreads threads; return requests per second
+template <typename F>
+double run(int nThreads, int nGets, std::vector<std::string> const& paths, F func) {
+    std::atomic<std::size_t> sink(0);
+    auto const start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 rng(t);
+            std::uniform_int_distribution<std::size_t> pick(0, paths.size() - 1);
+            std::size_t n = 0;
+            for (int i = t; i < nGets; i += nThreads) {
+                n += func(paths[pick(rng)]);
+            }
+            sink += n;
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    return sink > 0 ? nGets / elapsed.count() : 0.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nFiles = argc > 1 ? std::atoi(argv[1]) : 200;
+    int const nCards = argc > 2 ? std::atoi(argv[2]) : 300;
+    int const nGets = argc > 3 ? std::atoi(argv[3]) : 200000;
+
+    char dir[] = "/tmp/headerCacheBenchmark_XXXXXX";
+    if (!mkdtemp(dir)) {
+        std::cerr << "Cannot create temporary directory" << std::endl;
+        return 1;
+    }
+    std::vector<std::string> paths;
+    for (int f = 0; f < nFiles; ++f) {
+        paths.push_back(std::string(dir) + "/header" + std::to_string(f) + ".txt");
+        std::ofstream os(paths.back());
+        for (int i = 0; i < nCards; ++i) {
+            os << "KEY" << i << "=value " << f * nCards + i << '\n';
+        }
+    }
+
+    dafBase::HeaderCache cache;
+    int const maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << std::setw(8) << "threads" << std::setw(16) << "uncached/s" << std::setw(16) << "cached/s"
+              << std::endl;
+    for (int nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+        double const uncached = run(nThreads, nGets / 100, paths, [](std::string const& path) {
+            return readHeader(path, 0)->nameCount();
+        });
+        cache.clear();
+        double const cached = run(nThreads, nGets, paths, [&cache](std::string const& path) {
+            return cache.get(path, 0, readHeader)->nameCount();
+        });
+        std::cout << std::setw(8) << nThreads << std::setw(16) << std::fixed << std::setprecision(0)
+                  << uncached << std::setw(16) << cached << std::endl;
+    }
+    auto const stats = cache.getStatistics();
+    std::cout << "last run: " << stats.hits << " hits, " << stats.misses << " misses, " << stats.entries
+              << " headers, " << stats.bytes / 1024 << " KiB" << std::endl;
+
+    for (auto const& path : paths) {
+        std::remove(path.c_str());
+    }
+    rmdir(dir);
+    return 0;
+}
@@ -0,0 +1,119 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the throughput of MessagePack encoding and decoding of a FITS-like
+ * PropertyList and of the equivalent hierarchical PropertySet, in MB/s of
+ * encoded data, with toString as a reference.
+ *
+ * Usage: messagePackBenchmark [nCards [nIter]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "lsst/daf/base/MessagePack.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+dafBase::PropertyList::Ptr makeHeader(int nCards) {
+    dafBase::PropertyList::Ptr pl(new dafBase::PropertyList);
+    for (int i = 0; i < nCards; ++i) {
+        std::string const name = "KEY" + std::to_string(i);
+        switch (i % 5) {
+            case 0:
+                pl->set(name, i, "an integer");
+                break;
+            case 1:
+                pl->set(name, 0.5 * i, "a double");
+                break;
+            case 2:
+                pl->set(name, "value " + std::to_string(i), "a string");
+                break;
+            case 3:
+                pl->set(name, dafBase::DateTime(1600000000000000000LL + i, dafBase::DateTime::TAI),
+                        "a date");
+                break;
+            default:
+                pl->set(name, (i % 10) == 4, "a bool");
+                break;
+        }
+    }
+    return pl;
+}
+
+template <typename F>
+void report(std::string const& label, int nIter, std::size_t nBytes, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func();
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(28) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << 1.0e-6 * nBytes * nIter / elapsed.count() << " MB/s"
+              << std::setw(10) << 1.0e6 * elapsed.count() / nIter << " us/header" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nCards = argc > 1 ? std::atoi(argv[1]) : 500;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 2000;
+    auto const header = makeHeader(nCards);
+    auto const set = std::make_shared<dafBase::PropertySet>();
+    for (auto const& name : header->getOrderedNames()) {
+        set->copy(name, header, name);
+    }
+
+    std::size_t sink = 0;
+    std::string const listData = dafBase::MessagePackWriter::encode(*header);
+    std::string const setData = dafBase::MessagePackWriter::encode(*set);
+    std::cout << nCards << " cards: " << listData.size() << " bytes as a PropertyList, " << setData.size()
+              << " bytes as a PropertySet" << std::endl;
+
+    std::string buffer;
+    report("encode PropertyList", nIter, listData.size(), [&]() {
+        buffer.clear();
+        dafBase::MessagePackWriter::encode(*header, buffer);
+        sink += buffer.size();
+    });
+    report("decode PropertyList", nIter, listData.size(),
+           [&]() { sink += dafBase::MessagePackReader::decode(listData)->nameCount(); });
+    report("encode PropertySet", nIter, setData.size(), [&]() {
+        buffer.clear();
+        dafBase::MessagePackWriter::encode(*set, buffer);
+        sink += buffer.size();
+    });
+    report("decode PropertySet", nIter, setData.size(),
+           [&]() { sink += dafBase::MessagePackReader::decode(setData)->nameCount(); });
+    std::size_t const textSize = header->toString().size();
+    report("toString (text size)", nIter, textSize, [&]() { sink += header->toString().size(); });
+    return sink == 0;
+}
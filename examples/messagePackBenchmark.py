@@ -0,0 +1,76 @@
+#!/usr/bin/env python
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Compare MessagePack encoding of a PropertyList from Python with pickling
+and with JSON encoding of its ``toDict`` representation, in MB/s of encoded
+data.
+
+Usage: messagePackBenchmark.py [nCards [nIter]]
+"""
+
+import json
+import pickle
+import sys
+import time
+
+import lsst.daf.base as dafBase
+
+
+def makeHeader(nCards):
+    header = dafBase.PropertyList()
+    for i in range(nCards):
+        name = "KEY%d" % i
+        if i % 4 == 0:
+            header.set(name, i, "an integer")
+        elif i % 4 == 1:
+            header.set(name, 0.5*i, "a double")
+        elif i % 4 == 2:
+            header.set(name, "value %d" % i, "a string")
+        else:
+            header.set(name, i % 8 == 3, "a bool")
+    return header
+
+
+def report(label, nIter, func):
+    start = time.perf_counter()
+    for i in range(nIter):
+        data = func()
+    elapsed = time.perf_counter() - start
+    print("%-28s %10.1f MB/s %10.1f us/header" % (label, 1e-6*len(data)*nIter/elapsed, 1e6*elapsed/nIter))
+    return data
+
+
+def main():
+    nCards = int(sys.argv[1]) if len(sys.argv) > 1 else 500
+    nIter = int(sys.argv[2]) if len(sys.argv) > 2 else 200
+    header = makeHeader(nCards)
+
+    data = report("encodeMessagePack", nIter, lambda: dafBase.encodeMessagePack(header))
+    report("decodeMessagePack", nIter, lambda: (dafBase.decodeMessagePack(data), data)[1])
+    pickled = report("pickle.dumps", nIter, lambda: pickle.dumps(header))
+    report("pickle.loads", nIter, lambda: (pickle.loads(pickled), pickled)[1])
+    text = report("json.dumps(toDict())", nIter, lambda: json.dumps(header.toDict()))
+    report("json.loads", nIter, lambda: (json.loads(text), text)[1])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,165 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compute MinHash signatures of many synthetic headers, index them with a
+ * MinHashIndex, and compare its queries with a linear scan of all the
+ * signatures.  The headers belong to nModes instrument configurations that
+ * share half of their cards; within a configuration they differ in a few
+ * per-exposure cards.  Headers are built in batches outside the timed region.
+ *
+ * Usage: minHashBenchmark [nHeaders [nModes [nThreads]]]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/MinHash.h"
+#include "lsst/daf/base/MinHashIndex.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+int const N_HASHES = 64;
+int const N_BANDS = 8;
+int const ROWS_PER_BAND = 8;
+int const BATCH = 10000;
+double const THRESHOLD = 0.8;
+
+std::shared_ptr<dafBase::PropertyList> makeHeader(int i, int nModes) {
+    static char const* const filters[] = {"u", "g", "r", "i", "z", "y"};
+    int const mode = static_cast<int>((static_cast<long long>(i) * 7919) % nModes);
+    auto header = std::make_shared<dafBase::PropertyList>();
+    header->set("INSTRUME", std::string("LSSTCam"), "instrument");
+    for (int j = 0; j < 60; ++j) {
+        header->set("KEY" + std::to_string(j), j < 30 ? j : mode * 100 + j, "configuration");
+    }
+    header->set("EXPID", i, "exposure id");
+    header->set("DATE-OBS", std::string("2026-01-15T03:04:05.") + std::to_string(i % 1000000), "start");
+    header->set("EXPTIME", 15.0 * (i % 4), "exposure time");
+    header->set("FILTER", std::string(filters[i % 6]), "filter");
+    return header;
+}
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(std::string const& label, double elapsed, double count, std::string const& unit) {
+    std::cout << std::left << std::setw(32) << label << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << 1.0e6 * elapsed / count << " us/" << unit << std::setw(10)
+              << std::setprecision(2) << elapsed << " s total" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nHeaders = argc > 1 ? std::atoi(argv[1]) : 1000000;
+    int const nModes = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int const nThreads = argc > 3 ? std::atoi(argv[3]) : 0;
+
+    dafBase::MinHash const minHash(N_HASHES, {"EXPID", "DATE-OBS"});
+    std::vector<dafBase::MinHash::Signature> signatures;
+    signatures.reserve(nHeaders);
+    double serial = 0.0;
+    double parallel = 0.0;
+    for (int first = 0; first < nHeaders; first += BATCH) {
+        std::vector<dafBase::PropertySet::ConstPtr> headers;
+        for (int i = first; i < std::min(first + BATCH, nHeaders); ++i) {
+            headers.push_back(makeHeader(i, nModes));
+        }
+        if (first == 0) {
+            auto const start = std::chrono::steady_clock::now();
+            for (auto const& header : headers) {
+                signatures.push_back(minHash(*header));
+            }
+            serial = seconds(start);
+            signatures.clear();
+        }
+        auto const start = std::chrono::steady_clock::now();
+        std::vector<dafBase::MinHash::Signature> batch = minHash(headers, nThreads);
+        parallel += seconds(start);
+        std::move(batch.begin(), batch.end(), std::back_inserter(signatures));
+    }
+    report("signature, serial", serial, std::min(BATCH, nHeaders), "header");
+    report("signature, batch", parallel, nHeaders, "header");
+
+    dafBase::MinHashIndex index(N_BANDS, ROWS_PER_BAND);
+    auto start = std::chrono::steady_clock::now();
+    index.insert(signatures, nThreads);
+    report("index insert", seconds(start), nHeaders, "header");
+
+    int const nQueries = 1000;
+    std::vector<dafBase::MinHash::Signature> queries;
+    for (int q = 0; q < nQueries; ++q) {
+        queries.push_back(signatures[(static_cast<long long>(q) * 104729) % nHeaders]);
+    }
+    start = std::chrono::steady_clock::now();
+    std::size_t nFound = 0;
+    for (auto const& query : queries) {
+        nFound += index.query(query, THRESHOLD).size();
+    }
+    report("LSH query", seconds(start), nQueries, "query");
+    std::cout << "    " << nFound / nQueries << " similar headers per query" << std::endl;
+
+    // Recall of the index relative to an exhaustive comparison
+    int const nScans = 10;
+    std::size_t nExact = 0;
+    std::size_t nRecalled = 0;
+    start = std::chrono::steady_clock::now();
+    std::vector<std::set<std::size_t>> exact(nScans);
+    for (int q = 0; q < nScans; ++q) {
+        for (std::size_t i = 0; i < signatures.size(); ++i) {
+            if (dafBase::MinHash::similarity(queries[q], signatures[i]) >= THRESHOLD) {
+                exact[q].insert(i);
+            }
+        }
+    }
+    report("linear scan", seconds(start), nScans, "query");
+    for (int q = 0; q < nScans; ++q) {
+        nExact += exact[q].size();
+        for (std::size_t id : index.query(queries[q], THRESHOLD)) {
+            nRecalled += exact[q].count(id);
+        }
+    }
+    std::cout << "    recall " << std::setprecision(4) << static_cast<double>(nRecalled) / nExact
+              << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    std::vector<std::size_t> labels = index.cluster(THRESHOLD);
+    report("cluster", seconds(start), nHeaders, "header");
+    std::sort(labels.begin(), labels.end());
+    std::cout << "    " << std::unique(labels.begin(), labels.end()) - labels.begin() << " groups for "
+              << nModes << " configurations" << std::endl;
+    return 0;
+}
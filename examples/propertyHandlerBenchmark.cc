@@ -0,0 +1,167 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare the cost of walking a PropertyList with a PropertyHandler against
+ * PropertyList::toString and PropertySet::deepCopy.
+ *
+ * Usage: propertyHandlerBenchmark [nCards [nIter]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "lsst/daf/base/PropertyBuilder.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+// Handler that only counts events, to measure the cost of the walk itself
+class Counter : public dafBase::PropertyHandler {
+public:
+    void key(std::string const&) override { ++n; }
+    void value(bool) override { ++n; }
+    void value(char) override { ++n; }
+    void value(signed char) override { ++n; }
+    void value(unsigned char) override { ++n; }
+    void value(short) override { ++n; }
+    void value(unsigned short) override { ++n; }
+    void value(int) override { ++n; }
+    void value(unsigned int) override { ++n; }
+    void value(long) override { ++n; }
+    void value(unsigned long) override { ++n; }
+    void value(long long) override { ++n; }
+    void value(unsigned long long) override { ++n; }
+    void value(float) override { ++n; }
+    void value(double) override { ++n; }
+    void value(std::nullptr_t) override { ++n; }
+    void value(std::string const&) override { ++n; }
+    void value(dafBase::DateTime const&) override { ++n; }
+    void value(dafBase::Persistable::Ptr const&) override { ++n; }
+
+    std::size_t n = 0;
+};
+
+// Handler that writes "name = value // comment" lines, like toString
+class Writer : public dafBase::PropertyHandler {
+public:
+    explicit Writer(std::ostream& os) : _os(os) { _os << std::showpoint; }
+
+    void key(std::string const& name) override { _os << name << " = "; }
+    void comment(std::string const& comment) override {
+        _os << '\n';
+        if (!comment.empty()) _os << "// " << comment << '\n';
+    }
+    void value(bool v) override { _os << v; }
+    void value(char v) override { _os << v; }
+    void value(signed char v) override { _os << v; }
+    void value(unsigned char v) override { _os << v; }
+    void value(short v) override { _os << v; }
+    void value(unsigned short v) override { _os << v; }
+    void value(int v) override { _os << v; }
+    void value(unsigned int v) override { _os << v; }
+    void value(long v) override { _os << v; }
+    void value(unsigned long v) override { _os << v; }
+    void value(long long v) override { _os << v; }
+    void value(unsigned long long v) override { _os << v; }
+    void value(float v) override { _os << std::setprecision(7) << v; }
+    void value(double v) override { _os << std::setprecision(14) << v; }
+    void value(std::nullptr_t) override { _os << "<Unknown>"; }
+    void value(std::string const& v) override { _os << '"' << v << '"'; }
+    void value(dafBase::DateTime const& v) override { _os << v.toString(dafBase::DateTime::UTC); }
+    void value(dafBase::Persistable::Ptr const&) override { _os << "<Persistable>"; }
+
+private:
+    std::ostream& _os;
+};
+
+dafBase::PropertyList::Ptr makeHeader(int nCards) {
+    dafBase::PropertyList::Ptr pl(new dafBase::PropertyList);
+    for (int i = 0; i < nCards; ++i) {
+        std::string const name = "KEY" + std::to_string(i);
+        switch (i % 4) {
+            case 0:
+                pl->set(name, i, "an integer");
+                break;
+            case 1:
+                pl->set(name, 0.5 * i, "a double");
+                break;
+            case 2:
+                pl->set(name, "value " + std::to_string(i), "a string");
+                break;
+            default:
+                pl->set(name, (i % 8) == 3, "a bool");
+                break;
+        }
+    }
+    return pl;
+}
+
+template <typename F>
+void report(std::string const& label, int nIter, std::size_t nCards, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nIter; ++i) {
+        func();
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(24) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << 1.0e9 * elapsed.count() / (nIter * nCards) << " ns/card"
+              << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nCards = argc > 1 ? std::atoi(argv[1]) : 500;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 2000;
+    auto const header = makeHeader(nCards);
+
+    std::size_t sink = 0;
+    report("toString", nIter, nCards, [&]() { sink += header->toString().size(); });
+    report("walk (count events)", nIter, nCards, [&]() {
+        Counter counter;
+        header->walk(counter);
+        sink += counter.n;
+    });
+    report("walk (write text)", nIter, nCards, [&]() {
+        std::ostringstream os;
+        Writer writer(os);
+        header->walk(writer);
+        sink += os.str().size();
+    });
+    report("deepCopy", nIter, nCards, [&]() { sink += header->deepCopy()->nameCount(); });
+    report("walk (PropertyBuilder)", nIter, nCards, [&]() {
+        dafBase::PropertyBuilder builder(std::make_shared<dafBase::PropertyList>());
+        header->walk(builder);
+        sink += builder.getTarget()->nameCount();
+    });
+    return sink == 0;
+}
@@ -0,0 +1,128 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare filtering headers with a PropertyPredicate, serially and in
+ * several threads, with the equivalent hand-written PropertySet::get code.
+ *
+ * Usage: propertyPredicateBenchmark [nHeaders [nIter [nThreads]]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/PropertyPredicate.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+std::vector<dafBase::PropertySet::ConstPtr> makeHeaders(int nHeaders) {
+    static char const* const filters[] = {"u", "g", "r", "i", "z", "y"};
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < nHeaders; ++i) {
+        auto header = std::make_shared<dafBase::PropertyList>();
+        // Typical header size, with the fields of interest among the others
+        for (int j = 0; j < 200; ++j) {
+            header->set("KEY" + std::to_string(j), j, "filler");
+        }
+        header->set("INSTRUME", std::string(i % 2 ? "LATISS" : "LSSTCam"), "instrument");
+        header->set("FILTER", std::string(filters[i % 6]), "filter");
+        header->set("EXPTIME", static_cast<double>(i % 60), "exposure time");
+        header->set("AIRMASS", 1.0 + (i % 100) / 100.0, "airmass");
+        headers.push_back(header);
+    }
+    return headers;
+}
+
+template <typename F>
+void report(std::string const& label, std::size_t nEvaluations, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    std::size_t const n = func();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(28) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << 1.0e9 * elapsed.count() / nEvaluations << " ns/header"
+              << std::setw(10) << n << " selected" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nHeaders = argc > 1 ? std::atoi(argv[1]) : 10000;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 100;
+    int const nThreads = argc > 3 ? std::atoi(argv[3]) : 0;
+    auto const headers = makeHeaders(nHeaders);
+    std::size_t const nEvaluations = static_cast<std::size_t>(nHeaders) * nIter;
+
+    report("get<>", nEvaluations, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                if (header->exists("EXPTIME") && header->get<double>("EXPTIME") > 30 &&
+                    header->get<double>("AIRMASS") < 1.5 &&
+                    header->get<std::string>("INSTRUME") == "LATISS") {
+                    std::string const filter = header->get<std::string>("FILTER");
+                    n += filter == "g" || filter == "r" || filter == "i";
+                }
+            }
+        }
+        return n;
+    });
+
+    dafBase::PropertyPredicate const predicate(
+            "EXPTIME > 30 and AIRMASS < 1.5 and INSTRUME == 'LATISS' and FILTER in ('g', 'r', 'i')");
+    report("PropertyPredicate", nEvaluations, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                n += predicate(*header);
+            }
+        }
+        return n;
+    });
+    report("PropertyPredicate, 1 thread", nEvaluations, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (bool selected : predicate(headers, 1)) {
+                n += selected;
+            }
+        }
+        return n;
+    });
+    report("PropertyPredicate, threads", nEvaluations, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (bool selected : predicate(headers, nThreads)) {
+                n += selected;
+            }
+        }
+        return n;
+    });
+    return 0;
+}
@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Compare selecting headers with a PropertyPredicate from Python with the
+equivalent Python expression built from ``getScalar`` calls.
+
+Usage: propertyPredicateBenchmark.py [nHeaders]
+"""
+
+import sys
+import time
+
+import lsst.daf.base as dafBase
+
+
+def makeHeaders(nHeaders):
+    filters = ["u", "g", "r", "i", "z", "y"]
+    headers = []
+    for i in range(nHeaders):
+        header = dafBase.PropertyList()
+        for j in range(200):
+            header.set("KEY%d" % j, j, "filler")
+        header.set("INSTRUME", "LATISS" if i % 2 else "LSSTCam", "instrument")
+        header.set("FILTER", filters[i % 6], "filter")
+        header.set("EXPTIME", float(i % 60), "exposure time")
+        header.set("AIRMASS", 1.0 + (i % 100)/100.0, "airmass")
+        headers.append(header)
+    return headers
+
+
+def report(label, nHeaders, func):
+    start = time.perf_counter()
+    result = func()
+    elapsed = time.perf_counter() - start
+    print("%-28s %10.1f ns/header" % (label, 1e9*elapsed/nHeaders))
+    return result
+
+
+def main():
+    nHeaders = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    headers = makeHeaders(nHeaders)
+
+    def select(h):
+        return ("EXPTIME" in h and h.getScalar("EXPTIME") > 30 and h.getScalar("AIRMASS") < 1.5
+                and h.getScalar("INSTRUME") == "LATISS" and h.getScalar("FILTER") in ("g", "r", "i"))
+
+    predicate = dafBase.PropertyPredicate(
+        "EXPTIME > 30 and AIRMASS < 1.5 and INSTRUME == 'LATISS' and FILTER in ('g', 'r', 'i')")
+    expected = report("Python expression", nHeaders, lambda: [bool(select(h)) for h in headers])
+    single = report("PropertyPredicate", nHeaders, lambda: [predicate(h) for h in headers])
+    batch = report("PropertyPredicate(list)", nHeaders, lambda: predicate(headers))
+    assert single == expected and batch == expected
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,143 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare rendering a PropertyTemplate with building the same string from
+ * individual PropertySet::get calls.
+ *
+ * Usage: propertyTemplateBenchmark [nHeaders [nIter]]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/PropertyTemplate.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+std::vector<dafBase::PropertySet::ConstPtr> makeHeaders(int nHeaders) {
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < nHeaders; ++i) {
+        auto header = std::make_shared<dafBase::PropertyList>();
+        // Typical header size, with the fields of interest among the others
+        for (int j = 0; j < 200; ++j) {
+            header->set("KEY" + std::to_string(j), j, "filler");
+        }
+        header->set("INSTRUME", std::string("LATISS"), "instrument");
+        header->set("DATE-OBS", std::string("2023-01-15T03:04:05.123"), "start of exposure");
+        header->set("EXPID", 2023011500000LL + i, "exposure id");
+        header->set("EXPTIME", 30.5, "exposure time");
+        headers.push_back(header);
+    }
+    return headers;
+}
+
+template <typename F>
+void report(std::string const& label, std::size_t nRenders, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    std::size_t const n = func();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(28) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << 1.0e9 * elapsed.count() / nRenders << " ns/string"
+              << (n == 0 ? " (no output)" : "") << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nHeaders = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int const nIter = argc > 2 ? std::atoi(argv[2]) : 1000;
+    auto const headers = makeHeaders(nHeaders);
+    std::size_t const nRenders = static_cast<std::size_t>(nHeaders) * nIter;
+
+    report("get + ostringstream", nRenders, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                std::string const date = header->get<std::string>("DATE-OBS");
+                std::ostringstream os;
+                os << header->get<std::string>("INSTRUME") << '/' << date.substr(0, 4) << date.substr(5, 2)
+                   << date.substr(8, 2) << '/' << std::setfill('0') << std::setw(6)
+                   << header->get<long long>("EXPID") << '_' << std::setprecision(2) << std::fixed
+                   << header->get<double>("EXPTIME");
+                n += os.str().size();
+            }
+        }
+        return n;
+    });
+    report("get + snprintf", nRenders, [&]() {
+        std::size_t n = 0;
+        char buffer[256];
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                std::string const date = header->get<std::string>("DATE-OBS");
+                n += std::snprintf(buffer, sizeof(buffer), "%s/%.4s%.2s%.2s/%06lld_%.2f",
+                                   header->get<std::string>("INSTRUME").c_str(), date.c_str(),
+                                   date.c_str() + 5, date.c_str() + 8, header->get<long long>("EXPID"),
+                                   header->get<double>("EXPTIME"));
+            }
+        }
+        return n;
+    });
+
+    dafBase::PropertyTemplate const path("{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}_{EXPTIME:.2f}");
+    report("PropertyTemplate", nRenders, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                n += path.render(*header).size();
+            }
+        }
+        return n;
+    });
+    report("PropertyTemplate, reused", nRenders, [&]() {
+        std::size_t n = 0;
+        std::string buffer;
+        for (int iter = 0; iter < nIter; ++iter) {
+            for (auto const& header : headers) {
+                buffer.clear();
+                path.render(*header, buffer);
+                n += buffer.size();
+            }
+        }
+        return n;
+    });
+    report("PropertyTemplate, batch", nRenders, [&]() {
+        std::size_t n = 0;
+        for (int iter = 0; iter < nIter; ++iter) {
+            n += path.render(headers).size();
+        }
+        return n;
+    });
+    return 0;
+}
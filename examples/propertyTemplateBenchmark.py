@@ -0,0 +1,73 @@
+#!/usr/bin/env python
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Compare rendering a PropertyTemplate from Python with formatting the
+same string from one ``get`` call per field.
+
+Usage: propertyTemplateBenchmark.py [nHeaders]
+"""
+
+import sys
+import time
+
+import lsst.daf.base as dafBase
+
+
+def makeHeaders(nHeaders):
+    headers = []
+    for i in range(nHeaders):
+        header = dafBase.PropertyList()
+        for j in range(200):
+            header.set("KEY%d" % j, j, "filler")
+        header.set("INSTRUME", "LATISS", "instrument")
+        header.set("DATE-OBS", "2023-01-15T03:04:05.123", "start of exposure")
+        header.set("EXPID", 2023011500000 + i, "exposure id")
+        headers.append(header)
+    return headers
+
+
+def report(label, nHeaders, func):
+    start = time.perf_counter()
+    result = func()
+    elapsed = time.perf_counter() - start
+    print("%-28s %10.1f ns/string" % (label, 1e9*elapsed/nHeaders))
+    return result
+
+
+def main():
+    nHeaders = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    headers = makeHeaders(nHeaders)
+
+    def byGet():
+        return ["%s/%s/%06d" % (h.getScalar("INSTRUME"), h.getScalar("DATE-OBS")[:10].replace("-", ""),
+                                h.getScalar("EXPID"))
+                for h in headers]
+
+    template = dafBase.PropertyTemplate("{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}")
+    expected = report("getScalar + % formatting", nHeaders, byGet)
+    single = report("PropertyTemplate.render", nHeaders, lambda: [template.render(h) for h in headers])
+    batch = report("PropertyTemplate.render(list)", nHeaders, lambda: template.render(headers))
+    assert single == expected and batch == expected
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,116 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare two ways of making a few edits to a large header that may have to
+ * be abandoned: editing a deep copy, which is kept or discarded, and editing
+ * in place after a savepoint, which is released or rolled back.
+ *
+ * Usage: savepointBenchmark [nEdits [nTrials]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+dafBase::PropertyList::Ptr makeHeader(int nKeys, std::vector<std::string>& keys) {
+    auto header = std::make_shared<dafBase::PropertyList>();
+    keys.clear();
+    for (int k = 0; k < nKeys; ++k) {
+        keys.push_back("KEY" + std::to_string(k));
+        header->set(keys.back(), 0.5 * k, "comment " + std::to_string(k));
+    }
+    return header;
+}
+
+// Replace nEdits values and comments, and append a property
+void edit(dafBase::PropertyList& header, std::vector<std::string> const& keys, int nEdits, int trial) {
+    for (int e = 0; e < nEdits; ++e) {
+        header.set(keys[(7 * trial + 13 * e) % keys.size()], 1.0 * trial, "edited");
+    }
+    header.set("EXTRA", trial, "appended");
+}
+
+// Run func(trial) nTrials times; return microseconds per call
+template <typename F>
+double run(int nTrials, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    for (int trial = 0; trial < nTrials; ++trial) {
+        func(trial);
+    }
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    return 1.0e6 * elapsed.count() / nTrials;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nEdits = argc > 1 ? std::atoi(argv[1]) : 8;
+    int const nTrials = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+    std::cout << std::setw(8) << "keys" << std::setw(16) << "deepCopy (us)" << std::setw(16)
+              << "rollback (us)" << std::setw(16) << "release (us)" << std::endl;
+    std::size_t sink = 0;
+    std::vector<std::string> keys;
+    for (int nKeys = 100; nKeys <= 10000; nKeys *= 10) {
+        auto header = makeHeader(nKeys, keys);
+        double const copied = run(nTrials, [&](int trial) {
+            auto work = std::static_pointer_cast<dafBase::PropertyList>(header->deepCopy());
+            edit(*work, keys, nEdits, trial);
+            if (trial % 2 == 0) {
+                header = work;
+            }
+        });
+        sink += header->nameCount();
+
+        header = makeHeader(nKeys, keys);
+        double const rolledBack = run(nTrials, [&](int trial) {
+            header->savepoint();
+            edit(*header, keys, nEdits, trial);
+            header->rollback();
+        });
+        sink += header->nameCount();
+
+        double const released = run(nTrials, [&](int trial) {
+            header->savepoint();
+            edit(*header, keys, nEdits, trial);
+            header->release();
+        });
+        sink += header->nameCount();
+
+        std::cout << std::setw(8) << nKeys << std::fixed << std::setprecision(2) << std::setw(16) << copied
+                  << std::setw(16) << rolledBack << std::setw(16) << released << std::endl;
+    }
+    return sink == 0;
+}
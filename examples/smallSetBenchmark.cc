@@ -0,0 +1,141 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Build a provenance-like tree of many small nested PropertySets, and report
+ * the heap memory it uses, the time to build it, and the time to look up
+ * values in it by hierarchical name and within a single small set.
+ *
+ * Usage: smallSetBenchmark [nTasks [nLookups]]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertySet.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+// Heap bytes currently allocated through operator new
+std::size_t liveBytes = 0;
+
+// Room for the size of each allocation, keeping the alignment of malloc
+std::size_t const HEADER = alignof(std::max_align_t);
+
+void report(std::string const& label, double value, std::string const& unit) {
+    std::cout << std::left << std::setw(32) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(1) << value << " " << unit << std::endl;
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    char* p = static_cast<char*>(std::malloc(size + HEADER));
+    if (p == nullptr) throw std::bad_alloc();
+    *reinterpret_cast<std::size_t*>(p) = size;
+    liveBytes += size;
+    return p + HEADER;
+}
+
+void operator delete(void* p) noexcept {
+    if (p == nullptr) return;
+    char* base = static_cast<char*>(p) - HEADER;
+    liveBytes -= *reinterpret_cast<std::size_t*>(base);
+    std::free(base);
+}
+
+void operator delete(void* p, std::size_t) noexcept { operator delete(p); }
+
+int main(int argc, char** argv) {
+    int const nTasks = argc > 1 ? std::atoi(argv[1]) : 100000;
+    int const nLookups = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    // Names are built before measuring, so only the tree is counted
+    std::vector<std::string> prefixes;
+    for (int i = 0; i < nTasks; ++i) {
+        prefixes.push_back("task" + std::to_string(i));
+    }
+    char const* const configKeys[] = {"doWrite", "maxIter", "nSigma", "method", "connections"};
+    char const* const metadataKeys[] = {"startTime", "endTime", "maxRss"};
+
+    std::size_t const before = liveBytes;
+    auto start = std::chrono::steady_clock::now();
+    auto tree = std::make_shared<dafBase::PropertySet>();
+    for (int i = 0; i < nTasks; ++i) {
+        auto task = std::make_shared<dafBase::PropertySet>();
+        auto config = std::make_shared<dafBase::PropertySet>();
+        for (int j = 0; j < 5; ++j) {
+            config->set(configKeys[j], i + j);
+        }
+        auto metadata = std::make_shared<dafBase::PropertySet>();
+        for (int j = 0; j < 3; ++j) {
+            metadata->set(metadataKeys[j], 0.5 * (i + j));
+        }
+        task->set("config", config);
+        task->set("metadata", metadata);
+        task->set("status", 0);
+        tree->set(prefixes[i], task);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    int const nSets = 3 * nTasks;
+    report("memory", static_cast<double>(liveBytes - before) / nSets, "bytes/set");
+    report("build", 1.0e9 * elapsed.count() / nSets, "ns/set");
+
+    std::vector<std::string> names;
+    for (int i = 0; i < 1000; ++i) {
+        names.push_back(prefixes[(i * 7919) % nTasks] + ".config." + configKeys[i % 5]);
+    }
+    long long sink = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookups; ++i) {
+        sink += tree->getAsInt(names[i % names.size()]);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    report("hierarchical lookup", 1.0e9 * elapsed.count() / nLookups, "ns/lookup");
+
+    auto const config = tree->getAsPropertySetPtr(prefixes[0] + ".config");
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookups; ++i) {
+        sink += config->get<int>(configKeys[i % 5]);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    report("lookup in a small set", 1.0e9 * elapsed.count() / nLookups, "ns/lookup");
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < nLookups; ++i) {
+        sink += config->exists("missing");
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    report("miss in a small set", 1.0e9 * elapsed.count() / nLookups, "ns/lookup");
+
+    return sink == 42 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
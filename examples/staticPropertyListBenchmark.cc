@@ -0,0 +1,125 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Compare the latency of filling in the metadata of one readout with a
+ * StaticPropertyList and with a PropertyList, reporting the median and the
+ * tail of the distribution, which is what matters to a control loop.
+ *
+ * Usage: staticPropertyListBenchmark [nReadouts]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/StaticPropertyList.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+int const N_KEYS = 32;
+
+// Names as C strings, prepared off the timed path
+struct Names {
+    Names() {
+        for (int i = 0; i < N_KEYS; ++i) {
+            std::snprintf(names[i], sizeof(names[i]), "KEY%d", i);
+        }
+    }
+    char names[N_KEYS][8];
+};
+
+// Set the metadata of one readout
+template <typename List>
+void fill(List& md, Names const& n, int readout, dafBase::DateTime const& date) {
+    for (int i = 0; i < N_KEYS; ++i) {
+        switch (i % 4) {
+            case 0:
+                md.set(n.names[i], readout, "an integer");
+                break;
+            case 1:
+                md.set(n.names[i], 0.5 * readout, "a double");
+                break;
+            case 2:
+                md.set(n.names[i], "a string value", "a string");
+                break;
+            default:
+                md.set(n.names[i], date, "a date");
+                break;
+        }
+    }
+}
+
+template <typename F>
+void report(std::string const& label, int nReadouts, F func) {
+    std::vector<double> latency(nReadouts);
+    for (int i = 0; i < nReadouts; ++i) {
+        auto const start = std::chrono::steady_clock::now();
+        func(i);
+        std::chrono::duration<double, std::nano> const elapsed = std::chrono::steady_clock::now() - start;
+        latency[i] = elapsed.count();
+    }
+    std::sort(latency.begin(), latency.end());
+    auto quantile = [&](double q) { return latency[std::min<std::size_t>(q * nReadouts, nReadouts - 1)]; };
+    std::cout << std::left << std::setw(32) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << quantile(0.5) << std::setw(10) << quantile(0.99) << std::setw(10)
+              << quantile(0.999) << std::setw(12) << latency.back() << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nReadouts = argc > 1 ? std::atoi(argv[1]) : 100000;
+    Names const names;
+    dafBase::DateTime const date(1600000000000000000LL, dafBase::DateTime::TAI);
+
+    std::cout << "ns per readout of " << N_KEYS << " keys" << std::endl;
+    std::cout << std::left << std::setw(32) << "" << std::right << std::setw(10) << "median" << std::setw(10)
+              << "p99" << std::setw(10) << "p99.9" << std::setw(12) << "max" << std::endl;
+
+    dafBase::StaticPropertyList<64, 4096> md;
+    report("StaticPropertyList (clear)", nReadouts, [&](int i) {
+        md.clear();
+        fill(md, names, i, date);
+    });
+    report("StaticPropertyList (reuse)", nReadouts, [&](int i) { fill(md, names, i, date); });
+
+    std::size_t sink = 0;
+    report("PropertyList (new)", nReadouts, [&](int i) {
+        dafBase::PropertyList pl;
+        fill(pl, names, i, date);
+        sink += pl.nameCount();
+    });
+    dafBase::PropertyList pl;
+    report("PropertyList (reuse)", nReadouts, [&](int i) { fill(pl, names, i, date); });
+    return sink == 0;
+}
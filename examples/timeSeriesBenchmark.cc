@@ -0,0 +1,132 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure appending to and querying a TimeSeries, compared with the
+ * alternative of parallel arrays of values and DateTimes in a PropertySet.
+ *
+ * Usage: timeSeriesBenchmark [nSamples [nQueries]]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertySet.h"
+#include "lsst/daf/base/TimeSeries.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+long long const T0 = 1700000000000000000LL;
+long long const STEP = 100000000LL;  // 10 Hz
+
+template <typename F>
+double report(std::string const& label, std::size_t nOps, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    double const result = func();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(36) << label << std::right << std::setw(12) << std::fixed
+              << std::setprecision(1) << 1.0e9 * elapsed.count() / nOps << " ns/op" << std::endl;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    std::size_t const nSamples = argc > 1 ? std::atol(argv[1]) : 10000000;
+    std::size_t const nQueries = argc > 2 ? std::atol(argv[2]) : 1000000;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<long long> when(T0, T0 + STEP * nSamples);
+    std::vector<dafBase::DateTime> queries;
+    for (std::size_t i = 0; i < nQueries; ++i) {
+        queries.emplace_back(when(rng), dafBase::DateTime::TAI);
+    }
+    double sink = 0.0;
+
+    dafBase::PropertySet properties;
+    report("TimeSeries set(name, value, time)", nSamples, [&]() {
+        for (std::size_t i = 0; i < nSamples; ++i) {
+            properties.set("TEMP", 0.001 * i, dafBase::DateTime(T0 + STEP * i, dafBase::DateTime::TAI));
+        }
+        return 0.0;
+    });
+    auto const series = properties.getTimeSeries("TEMP");
+
+    dafBase::TimeSeries ring(nSamples / 10);
+    report("TimeSeries append, ring of n/10", nSamples, [&]() {
+        for (std::size_t i = 0; i < nSamples; ++i) {
+            ring.append(dafBase::DateTime(T0 + STEP * i, dafBase::DateTime::TAI), 0.001 * i);
+        }
+        return 0.0;
+    });
+    sink += report("TimeSeries valueAt", nQueries, [&]() {
+        double sum = 0.0;
+        for (auto const& t : queries) {
+            sum += series->valueAt(t);
+        }
+        return sum;
+    });
+    sink += report("TimeSeries range of n/10", 1000, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < 1000; ++i) {
+            auto const end = queries[i] + std::chrono::nanoseconds(STEP * nSamples / 10);
+            sum += series->range(queries[i], end)->size();
+        }
+        return sum;
+    });
+    sink += report("TimeSeries downsample to 1 min means", nSamples, [&]() {
+        return series->downsample(std::chrono::minutes(1))->size();
+    });
+
+    // Parallel arrays: one value and one DateTime per sample
+    dafBase::PropertySet arrays;
+    report("PropertySet add value and DateTime", nSamples, [&]() {
+        for (std::size_t i = 0; i < nSamples; ++i) {
+            arrays.add("TEMP", 0.001 * i);
+            arrays.add("TEMP_TIME", dafBase::DateTime(T0 + STEP * i, dafBase::DateTime::TAI));
+        }
+        return 0.0;
+    });
+    std::size_t const nArrayQueries = std::min<std::size_t>(nQueries, 10);
+    sink += report("PropertySet getArray + binary search", nArrayQueries, [&]() {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < nArrayQueries; ++i) {
+            auto const times = arrays.getArray<dafBase::DateTime>("TEMP_TIME");
+            auto const earlier = [](long long t, dafBase::DateTime const& d) { return t < d.nsecs(); };
+            auto const n = std::upper_bound(times.begin(), times.end(), queries[i].nsecs(), earlier) -
+                           times.begin();
+            sum += arrays.getArray<double>("TEMP")[n - 1];
+        }
+        return sum;
+    });
+    return sink == 0.0;
+}
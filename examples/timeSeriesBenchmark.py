@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Measure moving TimeSeries samples between numpy and C++, compared with
+the arrays of a PropertySet, which are copied element by element.
+
+Usage: timeSeriesBenchmark.py [nSamples]
+"""
+
+import sys
+import time
+
+import numpy as np
+
+import lsst.daf.base as dafBase
+
+
+def report(label, n, func):
+    start = time.perf_counter()
+    result = func()
+    elapsed = time.perf_counter() - start
+    print("%-32s %10.3f ns/sample" % (label, 1e9*elapsed/n))
+    return result
+
+
+def main():
+    nSamples = int(sys.argv[1]) if len(sys.argv) > 1 else 10**7
+    times = 1700000000*10**9 + 10**8*np.arange(nSamples, dtype=np.int64)
+    values = np.random.default_rng(42).normal(size=nSamples)
+
+    series = dafBase.TimeSeries()
+    report("TimeSeries.append(arrays)", nSamples, lambda: series.append(times, values))
+    viewed = report("TimeSeries.getValues", nSamples, series.getValues)
+    assert np.array_equal(viewed, values)
+    report("TimeSeries.downsample(1 min)", nSamples, lambda: series.downsample(60.0))
+
+    container = dafBase.PropertySet()
+    report("PropertySet.setDouble(list)", nSamples, lambda: container.setDouble("TEMP", values.tolist()))
+    copied = report("PropertySet.getArray", nSamples, lambda: np.array(container.getArray("TEMP")))
+    assert np.array_equal(copied, values)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,119 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Measure the overhead of tracing: of a bare span, and of the spans in
+ * PropertyList::deepCopy, with tracing disabled, enabled and sampled.
+ *
+ * Usage: traceBenchmark [nIter [traceFile]]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/Trace.h"
+
+namespace dafBase = lsst::daf::base;
+
+namespace {
+
+template <typename F>
+void report(std::string const& label, std::size_t nIter, F func) {
+    auto const start = std::chrono::steady_clock::now();
+    func();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << std::left << std::setw(32) << label << std::right << std::setw(10) << std::fixed
+              << std::setprecision(2) << 1.0e9 * elapsed.count() / nIter << " ns/op" << std::endl;
+}
+
+void drain(std::string const& traceFile) {
+    if (traceFile.empty()) {
+        std::ostringstream os;
+        dafBase::Trace::flush(os);
+    } else {
+        dafBase::Trace::flush(traceFile);
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int const nIter = argc > 1 ? std::atoi(argv[1]) : 10000;
+    std::string const traceFile = argc > 2 ? argv[2] : "";
+    int const nSpans = 1000 * nIter;
+
+    report("empty loop", nSpans, [&]() {
+        for (int i = 0; i < nSpans; ++i) {
+            asm volatile("" ::: "memory");
+        }
+    });
+    report("span, disabled", nSpans, [&]() {
+        for (int i = 0; i < nSpans; ++i) {
+            LSST_DAF_BASE_TRACE_SPAN("span");
+            asm volatile("" ::: "memory");
+        }
+    });
+    dafBase::Trace::enable(100);
+    report("span, 1 in 100 sampled", nSpans, [&]() {
+        for (int i = 0; i < nSpans; ++i) {
+            LSST_DAF_BASE_TRACE_SPAN("span");
+            asm volatile("" ::: "memory");
+        }
+    });
+    dafBase::Trace::enable();
+    std::size_t const nEnabled = dafBase::Trace::BUFFER_SIZE;
+    report("span, enabled", nEnabled, [&]() {
+        for (std::size_t i = 0; i < nEnabled; ++i) {
+            LSST_DAF_BASE_TRACE_SPAN("span");
+            asm volatile("" ::: "memory");
+        }
+    });
+    dafBase::Trace::disable();
+    dafBase::Trace::clear();
+
+    dafBase::PropertyList header;
+    for (int j = 0; j < 200; ++j) {
+        header.set("KEY" + std::to_string(j), j, "filler");
+    }
+    report("deepCopy, disabled", nIter, [&]() {
+        for (int i = 0; i < nIter; ++i) {
+            header.deepCopy();
+        }
+    });
+    dafBase::Trace::enable();
+    report("deepCopy, enabled", nIter, [&]() {
+        for (int i = 0; i < nIter; ++i) {
+            header.deepCopy();
+        }
+    });
+    dafBase::Trace::disable();
+    report("flush", 3 * nIter, [&]() { drain(traceFile); });
+    std::cout << "dropped: " << dafBase::Trace::getDropped() << std::endl;
+    return 0;
+}
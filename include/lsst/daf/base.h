@@ -26,6 +26,19 @@
 #include "lsst/daf/base/DateTime.h"
 #include "lsst/daf/base/Persistable.h"
 #include "lsst/daf/base/PropertySet.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/PropertyBuilder.h"
 #include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/HeaderCache.h"
+#include "lsst/daf/base/ConcurrentArray.h"
+#include "lsst/daf/base/PropertyPredicate.h"
+#include "lsst/daf/base/PropertyTemplate.h"
+#include "lsst/daf/base/TimeSeries.h"
+#include "lsst/daf/base/Trace.h"
+#include "lsst/daf/base/MessagePack.h"
+#include "lsst/daf/base/StaticPropertyList.h"
+#include "lsst/daf/base/MinHash.h"
+#include "lsst/daf/base/MinHashIndex.h"
+#include "lsst/daf/base/AsOfJoin.h"
 
 #endif
@@ -0,0 +1,144 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_ASOFJOIN
+#define LSST_DAF_BASE_ASOFJOIN
+
+/** @class lsst::daf::base::AsOfJoin
+ * @brief Matches each time in one sorted stream to a time in another, such
+ * as each exposure to the most recent telemetry sample before it.
+ *
+ * For each "left" time the join returns the index of a "right" time:
+ *
+ *  - BACKWARD: the last right time not after it;
+ *  - FORWARD: the first right time not before it;
+ *  - NEAREST: whichever of those two is closer, the earlier if they are
+ *    equally close.
+ *
+ * If exact matches are not allowed, "not after" becomes "before" and "not
+ * before" becomes "after".  A match further away than the tolerance, or no
+ * match at all, gives NO_MATCH.  These are the semantics of
+ * `pandas.merge_asof`.  Among equal right times, BACKWARD picks the last and
+ * FORWARD the first.
+ *
+ * Times are TAI nanoseconds, as returned by DateTime::nsecs and
+ * TimeSeries::getTimes, and both streams must be sorted in nondecreasing
+ * order.  Invalid times (DateTime::invalid_nsecs) sort first; they never
+ * match and are never matched.
+ *
+ * The left stream is split into chunks that are joined in parallel.  Each
+ * chunk binary-searches its starting point in the right stream and then
+ * merges the two, so a join takes time linear in the size of the streams.
+ *
+ * @ingroup daf_base
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT AsOfJoin {
+public:
+    /// Which right time matches a left time.
+    enum Direction { BACKWARD, FORWARD, NEAREST };
+
+    /// Index returned for a left time without a match.
+    constexpr static long long NO_MATCH = -1;
+
+    /**
+     * Construct a join.
+     *
+     * @param[in] direction Which right time matches a left time.
+     * @param[in] tolerance Largest time difference of a match.
+     * @param[in] allowExactMatches Whether equal times match.
+     * @throws InvalidParameterError tolerance is negative.
+     */
+    explicit AsOfJoin(Direction direction = BACKWARD,
+                      std::chrono::nanoseconds tolerance = std::chrono::nanoseconds::max(),
+                      bool allowExactMatches = true);
+
+    /// Return which right time matches a left time.
+    Direction getDirection() const noexcept { return _direction; }
+
+    /// Return the largest time difference of a match.
+    std::chrono::nanoseconds getTolerance() const noexcept { return _tolerance; }
+
+    /// Return whether equal times match.
+    bool getAllowExactMatches() const noexcept { return _allowExactMatches; }
+
+    /**
+     * Join two sorted arrays of TAI nanoseconds.
+     *
+     * @param[in] left Times to find matches for.
+     * @param[in] nLeft Number of left times.
+     * @param[in] right Times to match.
+     * @param[in] nRight Number of right times.
+     * @param[out] indices For each left time, the index of its match in `right`, or NO_MATCH;
+     *                     must have room for nLeft values.
+     * @param[in] nThreads Maximum number of threads to use; 0 for the number of hardware threads.
+     * @throws InvalidParameterError left or right is not sorted.
+     */
+    void operator()(long long const* left, std::size_t nLeft, long long const* right, std::size_t nRight,
+                    long long* indices, int nThreads = 0) const;
+
+    /**
+     * Join two sorted vectors of TAI nanoseconds.
+     *
+     * @return For each left time, the index of its match in `right`, or NO_MATCH.
+     * @throws InvalidParameterError left or right is not sorted.
+     */
+    std::vector<long long> operator()(std::vector<long long> const& left, std::vector<long long> const& right,
+                                      int nThreads = 0) const;
+
+    /**
+     * Join two sorted vectors of DateTimes.
+     *
+     * @return For each left time, the index of its match in `right`, or NO_MATCH.
+     * @throws InvalidParameterError left or right is not sorted.
+     */
+    std::vector<long long> operator()(std::vector<DateTime> const& left, std::vector<DateTime> const& right,
+                                      int nThreads = 0) const;
+
+private:
+    // Join the left times in [begin, end)
+    void _join(long long const* left, std::size_t begin, std::size_t end, long long const* right,
+               std::size_t nRight, long long* indices) const;
+
+    Direction _direction;
+    std::chrono::nanoseconds _tolerance;
+    bool _allowExactMatches;
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
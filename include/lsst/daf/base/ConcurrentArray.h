@@ -0,0 +1,159 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_CONCURRENTARRAY
+#define LSST_DAF_BASE_CONCURRENTARRAY
+
+/** @class lsst::daf::base::ConcurrentArray
+ * @brief Append-only array supporting lock-free concurrent appends.
+ *
+ * A ConcurrentArray accumulates the values of an array-valued property,
+ * such as HISTORY cards or per-thread timing samples, that many threads
+ * append to at once.  A PropertySet is not thread-safe unless
+ * PropertySet::makeConcurrent has been called, and even then every add to
+ * the same property takes that property set's unique lock, so the writers
+ * would serialize on it.
+ *
+ * Storage is a list of segments of doubling size that are never moved.  An
+ * append allocates the segment that will hold its index if no other thread
+ * has, reserves the index with a compare-and-swap on the size, constructs
+ * the value in place and marks it ready.  Appends therefore never block one
+ * another, and an append whose allocation fails reserves nothing.
+ *
+ * snapshot returns the values in index order.  It includes every append
+ * that completed before it was called, waiting for appends that had already
+ * reserved an index to finish, so the result is always a prefix of the final
+ * contents.  The snapshot is then typically stored in a PropertySet:
+ * @code
+ * ConcurrentArray<std::string> history;
+ * // ... history.add(card) from many threads ...
+ * header->set("HISTORY", history.snapshot());
+ * @endcode
+ *
+ * The array may only be destroyed once all appends have completed.
+ *
+ * @ingroup daf_base
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+template <typename T>
+class ConcurrentArray {
+public:
+    ConcurrentArray() noexcept;
+
+    ~ConcurrentArray() noexcept;
+
+    ConcurrentArray(ConcurrentArray const&) = delete;
+    ConcurrentArray& operator=(ConcurrentArray const&) = delete;
+    ConcurrentArray(ConcurrentArray&&) = delete;
+    ConcurrentArray& operator=(ConcurrentArray&&) = delete;
+
+    /**
+     * Append a value.  May be called concurrently from any number of threads.
+     *
+     * @param[in] value Value to append.
+     * @return Index of the new value.
+     *
+     * If copying the value throws, the exception is passed on and the
+     * reserved index is left empty; it does not appear in snapshots.
+     */
+    std::size_t add(T const& value);
+
+    /**
+     * Append several values, which are given consecutive indices.
+     *
+     * @param[in] values Values to append.
+     * @return Index of the first value.
+     */
+    std::size_t add(std::vector<T> const& values);
+
+    /// Number of indices reserved so far, including appends still in progress.
+    std::size_t size() const noexcept { return _size.load(std::memory_order_acquire); }
+
+    /// Return a copy of the values appended so far, in index order.
+    std::vector<T> snapshot() const;
+
+    /**
+     * Store a snapshot of the values in a PropertySet, replacing any existing
+     * values of the property.  As with PropertySet::set, nothing is stored if
+     * there are no values.
+     *
+     * @param[out] target Container to store the values in.
+     * @param[in] name Property name.
+     */
+    void snapshot(PropertySet& target, std::string const& name) const;
+
+private:
+    enum State : std::uint8_t { EMPTY = 0, READY = 1, FAILED = 2 };
+
+    struct Slot {
+        Slot() noexcept : state(EMPTY) {}
+
+        std::atomic<std::uint8_t> state;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+        T& value() { return *reinterpret_cast<T*>(&storage); }
+        T const& value() const { return *reinterpret_cast<T const*>(&storage); }
+    };
+
+    // Segment s holds FIRST_SEGMENT << s slots
+    static constexpr unsigned FIRST_SEGMENT_BITS = 5;
+    static constexpr std::size_t FIRST_SEGMENT = std::size_t(1) << FIRST_SEGMENT_BITS;
+    static constexpr unsigned MAX_SEGMENTS = 40;
+
+    // Index of the segment holding an index, and the first index of a segment
+    static unsigned _segmentOf(std::size_t index) noexcept;
+    static std::size_t _segmentBegin(unsigned s) noexcept {
+        return ((std::size_t(1) << s) - 1) << FIRST_SEGMENT_BITS;
+    }
+
+    // Reserve n consecutive indices, after allocating the segments that hold them; return the first
+    std::size_t _reserve(std::size_t n);
+
+    // Slot of a reserved index, whose segment is therefore allocated
+    Slot& _slot(std::size_t index) const noexcept;
+    void _construct(std::size_t index, T const& value);
+
+    std::atomic<std::size_t> _size;
+    mutable std::atomic<Slot*> _segments[MAX_SEGMENTS];  // allocated on first use, by any thread
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
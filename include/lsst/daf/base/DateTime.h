@@ -41,6 +41,7 @@
  * @ingroup daf_base
  */
 
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <limits>
@@ -50,6 +51,13 @@
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
 
+// Whether the standard library provides std::chrono::tai_clock and utc_clock
+#if defined(__cpp_lib_chrono) && __cpp_lib_chrono >= 201907L
+#define LSST_DAF_BASE_HAVE_TAI_CLOCK 1
+#else
+#define LSST_DAF_BASE_HAVE_TAI_CLOCK 0
+#endif
+
 // Forward declaration of the boost::serialization::access class.
 namespace boost {
 namespace serialization {
@@ -74,6 +82,15 @@ public:
     // an invalid DateTime has _nsec == invalid_nsecs
     constexpr static long long invalid_nsecs = std::numeric_limits<std::int64_t>::min();
 
+    /// A std::chrono::system_clock time, which is UTC without leap seconds, in nanoseconds
+    typedef std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> SystemTime;
+#if LSST_DAF_BASE_HAVE_TAI_CLOCK
+    /// A std::chrono::tai_clock time in nanoseconds
+    typedef std::chrono::time_point<std::chrono::tai_clock, std::chrono::nanoseconds> TaiTime;
+    /// A std::chrono::utc_clock time in nanoseconds
+    typedef std::chrono::time_point<std::chrono::utc_clock, std::chrono::nanoseconds> UtcTime;
+#endif
+
     /**
      * Default constructor: construct an invalid DateTime
      */
@@ -133,6 +150,48 @@ public:
      */
     explicit DateTime(std::string const& iso8601, Timescale scale);
 
+    /**
+     * Construct a DateTime from a std::chrono::system_clock time
+     *
+     * The system clock keeps UTC without leap seconds, so this is equivalent
+     * to constructing from nanoseconds in the UTC time scale.
+     *
+     * @param[in] time  time to convert; truncated to nanoseconds
+     * @throw lsst.pex.exceptions.DomainError if the date is before 1961-01-01
+     */
+    template <typename Duration>
+    explicit DateTime(std::chrono::time_point<std::chrono::system_clock, Duration> const& time)
+            : DateTime(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count(),
+                       UTC) {}
+
+#if LSST_DAF_BASE_HAVE_TAI_CLOCK
+    /**
+     * Construct a DateTime from a std::chrono::tai_clock time
+     *
+     * This only shifts the epoch, and is usable in constant expressions.
+     *
+     * @param[in] time  time to convert; truncated to nanoseconds
+     */
+    template <typename Duration>
+    constexpr explicit DateTime(std::chrono::time_point<std::chrono::tai_clock, Duration> const& time)
+            : _nsecs(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count() +
+                     TAI_CLOCK_EPOCH_NSECS) {}
+
+    /**
+     * Construct a DateTime from a std::chrono::utc_clock time
+     *
+     * The UTC clock counts leap seconds, so since 1972-01-01, when TAI-UTC
+     * became an integral number of seconds, this only shifts the epoch and is
+     * usable in constant expressions.  Earlier times are not supported.
+     *
+     * @param[in] time  time to convert; truncated to nanoseconds
+     */
+    template <typename Duration>
+    constexpr explicit DateTime(std::chrono::time_point<std::chrono::utc_clock, Duration> const& time)
+            : _nsecs(std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count() +
+                     UTC_CLOCK_OFFSET_NSECS) {}
+#endif
+
     /**
      * Get date as nanoseconds since the unix epoch
      *
@@ -197,13 +256,68 @@ public:
      */
     struct timeval timeval(Timescale scale) const;
 
+    /**
+     * Get date as a std::chrono::system_clock time, which is UTC without leap seconds
+     *
+     * @throw lsst.pex.exceptions.DomainError if the UTC date is before 1961-01-01
+     * @throw lsst.pex.exceptions.RuntimeError if DateTime is invalid
+     */
+    SystemTime toSystemTime() const;
+
+#if LSST_DAF_BASE_HAVE_TAI_CLOCK
+    /**
+     * Get date as a std::chrono::tai_clock time
+     *
+     * @throw lsst.pex.exceptions.RuntimeError if DateTime is invalid
+     */
+    constexpr TaiTime toTaiTime() const {
+        return isValid() ? TaiTime(std::chrono::nanoseconds(_nsecs - TAI_CLOCK_EPOCH_NSECS))
+                         : (_assertValid(), TaiTime());
+    }
+
+    /**
+     * Get date as a std::chrono::utc_clock time; only supported since 1972-01-01
+     *
+     * @throw lsst.pex.exceptions.RuntimeError if DateTime is invalid
+     */
+    constexpr UtcTime toUtcTime() const {
+        return isValid() ? UtcTime(std::chrono::nanoseconds(_nsecs - UTC_CLOCK_OFFSET_NSECS))
+                         : (_assertValid(), UtcTime());
+    }
+#endif
+
     /**
      * Is this date valid?
      */
-    bool isValid() const { return _nsecs != DateTime::invalid_nsecs; };
+    constexpr bool isValid() const { return _nsecs != DateTime::invalid_nsecs; };
 
     bool operator==(DateTime const& rhs) const;
 
+    /**
+     * Add or subtract a duration, which is measured in TAI (SI seconds)
+     *
+     * The result of adding to an invalid DateTime is invalid.
+     */
+    constexpr DateTime operator+(std::chrono::nanoseconds const& delta) const {
+        return isValid() ? DateTime(_nsecs + delta.count(), TaiNsecs()) : *this;
+    }
+    constexpr DateTime operator-(std::chrono::nanoseconds const& delta) const {
+        return isValid() ? DateTime(_nsecs - delta.count(), TaiNsecs()) : *this;
+    }
+    DateTime& operator+=(std::chrono::nanoseconds const& delta) { return *this = *this + delta; }
+    DateTime& operator-=(std::chrono::nanoseconds const& delta) { return *this = *this - delta; }
+
+    /**
+     * Get the duration between two dates, in TAI (SI seconds)
+     *
+     * @throw lsst.pex.exceptions.RuntimeError if either DateTime is invalid
+     */
+    constexpr std::chrono::nanoseconds operator-(DateTime const& rhs) const {
+        return (isValid() && rhs.isValid())
+                       ? std::chrono::nanoseconds(_nsecs - rhs._nsecs)
+                       : (_assertValid(), rhs._assertValid(), std::chrono::nanoseconds());
+    }
+
     /// Return a hash of this object.
     std::size_t hash_value() const noexcept;
 
@@ -226,6 +340,17 @@ public:
 private:
     long long _nsecs;  ///< TAI nanoseconds since Unix epoch
 
+    /// Start of std::chrono::tai_clock (1958-01-01 TAI) in TAI nanoseconds since the Unix epoch
+    constexpr static long long TAI_CLOCK_EPOCH_NSECS = -378691200LL * 1000000000LL;
+
+    /// TAI - UTC, in nanoseconds, at the start of std::chrono::utc_clock's leap second count (1972-01-01)
+    constexpr static long long UTC_CLOCK_OFFSET_NSECS = 10LL * 1000000000LL;
+
+    /// Tag selecting the constructor that takes TAI nanoseconds without conversion
+    struct TaiNsecs {};
+
+    constexpr DateTime(long long nsecs, TaiNsecs) : _nsecs(nsecs) {}
+
     /// Raise RuntimeError if DateTime is not valid
     void _assertValid() const {
         if (!isValid()) {
@@ -0,0 +1,187 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_HEADERCACHE
+#define LSST_DAF_BASE_HEADERCACHE
+
+/** @class lsst::daf::base::HeaderCache
+ * @brief Thread-safe LRU cache of headers read from files.
+ *
+ * Headers are cached by file path and HDU, and are only reused while the
+ * identity of the file (device, inode, modification time and size) is
+ * unchanged, so a file that is rewritten is read again.  Reading is
+ * delegated to a loader function supplied by the caller, such as a FITS
+ * metadata reader.
+ *
+ * Cached headers are frozen: they are returned as pointers to const and are
+ * shared by all callers.  Use deepCopy to obtain a header that may be
+ * modified.
+ *
+ * The cache holds at most a configurable number of bytes, as estimated by
+ * estimateBytes, evicting the least recently used headers first.  Concurrent
+ * requests for a header that is not yet cached invoke the loader only once;
+ * the other callers wait for its result.
+ *
+ * A process-wide instance is available from getInstance.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT HeaderCache {
+public:
+    /// Function that reads the header of HDU `hdu` of the file at `path`.
+    typedef std::function<std::shared_ptr<PropertyList>(std::string const& path, int hdu)> Loader;
+
+    /// Counters describing the activity of a HeaderCache.
+    struct Statistics {
+        std::uint64_t hits;       ///< Requests satisfied without calling the loader
+        std::uint64_t misses;     ///< Requests that called the loader
+        std::uint64_t evictions;  ///< Headers removed to stay within the memory budget
+        std::size_t entries;      ///< Headers currently cached
+        std::size_t bytes;        ///< Estimated size of the headers currently cached
+    };
+
+    /**
+     * Construct an empty cache.
+     *
+     * @param[in] maxBytes Memory budget, as estimated by estimateBytes.
+     */
+    explicit HeaderCache(std::size_t maxBytes = 256 * 1024 * 1024);
+
+    ~HeaderCache() noexcept;
+
+    HeaderCache(HeaderCache const&) = delete;
+    HeaderCache& operator=(HeaderCache const&) = delete;
+    HeaderCache(HeaderCache&&) = delete;
+    HeaderCache& operator=(HeaderCache&&) = delete;
+
+    /// Return the process-wide cache.
+    static HeaderCache& getInstance();
+
+    /**
+     * Return the header of an HDU of a file, calling `loader` only if it is
+     * not cached or the file has changed since it was cached.
+     *
+     * @param[in] path Path to the file.
+     * @param[in] hdu HDU number; passed to the loader.
+     * @param[in] loader Function that reads the header.
+     * @return The cached header.
+     * @throws IoError The file cannot be examined.
+     * @throws InvalidParameterError The loader returned a null pointer.
+     *
+     * Exceptions raised by the loader are passed on to every caller waiting
+     * for that header, and nothing is cached.
+     */
+    std::shared_ptr<PropertyList const> get(std::string const& path, int hdu, Loader const& loader);
+
+    /// Remove the header of an HDU of a file, if it is cached.
+    void erase(std::string const& path, int hdu);
+
+    /// Remove all headers and reset the counters.
+    void clear();
+
+    /// Set the memory budget, evicting headers if necessary.
+    void setMaxBytes(std::size_t maxBytes);
+
+    /// Get the memory budget.
+    std::size_t getMaxBytes() const;
+
+    /// Get a snapshot of the counters.
+    Statistics getStatistics() const;
+
+    /**
+     * Estimate the memory used by a PropertySet or PropertyList, including
+     * names, values and comments.
+     */
+    static std::size_t estimateBytes(PropertySet const& header);
+
+private:
+    // Identity of the contents of a file
+    struct FileId {
+        std::uint64_t device;
+        std::uint64_t inode;
+        std::int64_t mtime;  // nanoseconds
+        std::int64_t size;
+
+        bool operator==(FileId const& other) const {
+            return device == other.device && inode == other.inode && mtime == other.mtime &&
+                   size == other.size;
+        }
+    };
+
+    typedef std::pair<std::string, int> Key;
+
+    struct KeyHash {
+        std::size_t operator()(Key const& key) const noexcept {
+            return std::hash<std::string>()(key.first) ^
+                   (std::hash<int>()(key.second) * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    struct Entry {
+        FileId id;
+        std::shared_future<std::shared_ptr<PropertyList const>> header;
+        bool ready;                           // header has been loaded and counted in _bytes
+        std::size_t bytes;                    // estimated size, once ready
+        std::list<Key>::iterator lruPos;      // position in _lru, once ready
+    };
+
+    typedef std::unordered_map<Key, std::shared_ptr<Entry>, KeyHash> EntryMap;
+
+    static FileId _identify(std::string const& path);
+    void _remove(EntryMap::iterator i);
+    void _evict();
+
+    mutable std::mutex _mutex;
+    EntryMap _entries;
+    std::list<Key> _lru;  // ready entries, most recently used first
+    std::size_t _maxBytes;
+    std::size_t _bytes;
+    std::uint64_t _hits;
+    std::uint64_t _misses;
+    std::uint64_t _evictions;
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,201 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_MESSAGEPACK
+#define LSST_DAF_BASE_MESSAGEPACK
+
+/** @class lsst::daf::base::MessagePackWriter
+ * @brief PropertyHandler that encodes a container as MessagePack.
+ *
+ * A PropertySet is written as a map from names to values, with
+ * subproperties as nested maps.  A PropertyList is written as an array of
+ * `[name, value, comment]` entries in order.  Multiple values are written as
+ * arrays, and arrays of subproperties as arrays of maps.
+ *
+ * Every value is written with the fixed-width format of its C++ type
+ * (int16 for short, int32 for int, int64 for long and long long, uint64 for
+ * unsigned long and unsigned long long, and so on), never with the smallest
+ * format that fits, so that widths survive a round trip.  DateTime values use
+ * extension type DATETIME_EXT_TYPE with the big-endian TAI nanoseconds as an
+ * 8-byte payload.  Persistable values cannot be encoded.
+ *
+ * @ingroup daf_base
+ */
+
+/** @class lsst::daf::base::MessagePackReader
+ * @brief Decoder of MessagePack documents into PropertyHandler events.
+ *
+ * The reader accepts the output of MessagePackWriter and the corresponding
+ * output of other encoders.  Integers that other encoders write in the most
+ * compact format are read as int, 8-bit integers as signed or unsigned char,
+ * and arrays of integers in a mixture of formats as long long.  Binary data is
+ * read as strings, and the standard timestamp extension (type -1) as a UTC
+ * DateTime.
+ *
+ * A buffer may hold several documents, which are read one at a time.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertyHandler.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class PropertySet;
+
+class LSST_EXPORT MessagePackWriter : public PropertyHandler {
+public:
+    /// MessagePack extension type of DateTime values.
+    static constexpr std::int8_t DATETIME_EXT_TYPE = 1;
+
+    /**
+     * Construct a writer that appends to a buffer.
+     *
+     * @param[out] out Buffer to append the encoded events to.
+     * @param[in] ordered Write the outermost set as an array of
+     *                    `[name, value, comment]` entries, as for a PropertyList.
+     */
+    explicit MessagePackWriter(std::string& out, bool ordered = false);
+
+    ~MessagePackWriter() noexcept override;
+
+    MessagePackWriter(MessagePackWriter const&) = delete;
+    MessagePackWriter& operator=(MessagePackWriter const&) = delete;
+
+    /**
+     * Append the encoding of a container to a buffer.
+     *
+     * @param[in] container PropertySet or PropertyList to encode.
+     * @param[out] out Buffer to append to; reusing it avoids reallocation.
+     * @throws TypeError The container holds a Persistable.
+     */
+    static void encode(PropertySet const& container, std::string& out);
+
+    /// Return the encoding of a container.
+    static std::string encode(PropertySet const& container);
+
+    void beginSet(std::size_t size) override;
+    void endSet() override;
+    void key(std::string const& name) override;
+    void comment(std::string const& comment) override;
+    void beginArray(std::size_t size) override;
+
+    void value(bool v) override;
+    void value(char v) override;
+    void value(signed char v) override;
+    void value(unsigned char v) override;
+    void value(short v) override;
+    void value(unsigned short v) override;
+    void value(int v) override;
+    void value(unsigned int v) override;
+    void value(long v) override;
+    void value(unsigned long v) override;
+    void value(long long v) override;
+    void value(unsigned long long v) override;
+    void value(float v) override;
+    void value(double v) override;
+    void value(std::nullptr_t v) override;
+    void value(std::string const& v) override;
+    void value(DateTime const& v) override;
+    void value(Persistable::Ptr const& v) override;
+
+private:
+    template <typename U>
+    void _put(std::uint8_t format, U v);
+    void _header(std::size_t size, std::uint8_t fix, std::uint8_t fixMax, std::uint8_t format16);
+
+    std::string& _out;
+    bool _ordered;
+    std::size_t _depth;  // number of sets begun and not ended
+};
+
+class LSST_EXPORT MessagePackReader {
+public:
+    /**
+     * Construct a reader of a buffer, which must outlive it.
+     *
+     * @param[in] data Start of the encoded documents.
+     * @param[in] size Size of the buffer in bytes.
+     */
+    MessagePackReader(char const* data, std::size_t size);
+
+    /// Return true if all documents have been read.
+    bool atEnd() const { return _pos == _size; }
+
+    /// Return the offset of the next document in the buffer.
+    std::size_t getPosition() const { return _pos; }
+
+    /**
+     * Return true if the next document is an array of `[name, value, comment]`
+     * entries rather than a map.
+     *
+     * @throws InvalidParameterError There are no more documents.
+     */
+    bool isOrdered() const;
+
+    /**
+     * Read the next document, sending its contents to a handler as they are
+     * decoded.  Entries of an ordered document produce a `comment` event.
+     *
+     * @param[in] handler Receiver of the events, usually a PropertyBuilder.
+     * @throws InvalidParameterError The data are malformed or truncated.
+     * @throws TypeError The data hold a value that cannot be stored in a
+     *                   PropertySet, such as an array of arrays.
+     */
+    void read(PropertyHandler& handler);
+
+    /**
+     * Decode a buffer holding a single document.
+     *
+     * @param[in] data Start of the encoded document.
+     * @param[in] size Size of the buffer in bytes.
+     * @return A PropertyList for an ordered document, otherwise a PropertySet.
+     * @throws InvalidParameterError The data are malformed, truncated or
+     *                               followed by other data.
+     * @throws TypeError The data hold a value that cannot be stored.
+     */
+    static std::shared_ptr<PropertySet> decode(char const* data, std::size_t size);
+
+    /// Decode a string holding a single document.
+    static std::shared_ptr<PropertySet> decode(std::string const& data);
+
+private:
+    char const* _data;
+    std::size_t _size;
+    std::size_t _pos;  // offset of the next document
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
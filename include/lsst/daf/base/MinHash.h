@@ -0,0 +1,154 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_MINHASH
+#define LSST_DAF_BASE_MINHASH
+
+/** @class lsst::daf::base::MinHash
+ * @brief Computes MinHash signatures of the contents of PropertySets, for
+ * estimating their similarity without comparing them.
+ *
+ * A container is treated as the set of its (name, value) pairs, with names
+ * in full hierarchical form and each element of an array contributing its
+ * own pair.  Values are normalized before hashing so that formatting
+ * differences do not count as changes:
+ *
+ *  - integers, and floating-point values with an integral value, are
+ *    compared as 64-bit integers, whatever their declared type;
+ *  - other floating-point values are rounded to a number of significant
+ *    digits;
+ *  - leading and trailing blanks are removed from strings;
+ *  - DateTimes are compared by their TAI nanoseconds;
+ *  - Persistables only record that the name is present.
+ *
+ * Comments are not included.  Properties that vary from one file to the
+ * next, such as dates or checksums, should usually be ignored.
+ *
+ * The fraction of equal entries in two signatures estimates the Jaccard
+ * similarity of the two sets; with 128 hashes its standard error is at most
+ * about 0.045.  Signatures are only comparable if computed with the same
+ * number of hashes and seed.  Use MinHashIndex to find similar signatures
+ * among many.
+ *
+ * Computing a signature does not modify the MinHash, so one may be shared
+ * between threads.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT MinHash {
+public:
+    /// Minimum of each hash function over the elements of a set.
+    typedef std::vector<std::uint32_t> Signature;
+
+    /**
+     * Construct a MinHash.
+     *
+     * @param[in] nHashes Number of hash functions, and length of the signatures.
+     * @param[in] ignore Full names of properties to leave out of the signatures, with
+     *                   any properties nested beneath them.
+     * @param[in] precision Significant digits kept in non-integral floating-point values.
+     * @param[in] seed Seed of the hash functions.
+     * @throws InvalidParameterError nHashes or precision is not positive.
+     */
+    explicit MinHash(int nHashes = 128, std::vector<std::string> const& ignore = std::vector<std::string>(),
+                     int precision = 6, std::uint64_t seed = 0);
+
+    ~MinHash() noexcept;
+
+    MinHash(MinHash const&);
+    MinHash(MinHash&&);
+    MinHash& operator=(MinHash const&);
+    MinHash& operator=(MinHash&&);
+
+    /// Return the number of hash functions.
+    int getNumHashes() const { return static_cast<int>(_a.size()); }
+
+    /// Return the names of the properties left out of the signatures.
+    std::vector<std::string> getIgnored() const;
+
+    /// Return the number of significant digits kept in floating-point values.
+    int getPrecision() const { return _precision; }
+
+    /// Return the seed of the hash functions.
+    std::uint64_t getSeed() const { return _seed; }
+
+    /**
+     * Compute the signature of a container.  Every entry of the signature of
+     * an empty container is the largest 32-bit value.
+     */
+    Signature operator()(PropertySet const& properties) const;
+
+    /**
+     * Compute the signatures of many containers.
+     *
+     * @param[in] properties Containers to compute the signatures of.
+     * @param[in] nThreads Maximum number of threads to use; 0 for the number of hardware threads.
+     * @return The signature of each container, in the same order.
+     * @throws InvalidParameterError One of the containers is null.
+     */
+    std::vector<Signature> operator()(std::vector<PropertySet::ConstPtr> const& properties,
+                                      int nThreads = 0) const;
+
+    /**
+     * Estimate the Jaccard similarity of the sets two signatures were
+     * computed from.
+     *
+     * @param[in] a, b Signatures of the same length.
+     * @return The fraction of equal entries, between 0 and 1.
+     * @throws LengthError The signatures differ in length or are empty.
+     */
+    static double similarity(Signature const& a, Signature const& b);
+
+private:
+    // Hash the (name, value) pairs of a container into elements
+    void _elements(PropertySet const& properties, std::vector<std::uint64_t>& elements) const;
+
+    // Compute the signature of a set of elements
+    void _sign(std::vector<std::uint64_t> const& elements, Signature& signature) const;
+
+    std::vector<std::uint64_t> _a;  // odd multipliers of the hash functions
+    std::vector<std::uint64_t> _b;  // increments of the hash functions
+    std::unordered_set<std::string> _ignore;
+    int _precision;
+    std::uint64_t _seed;
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,188 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_MINHASHINDEX
+#define LSST_DAF_BASE_MINHASHINDEX
+
+/** @class lsst::daf::base::MinHashIndex
+ * @brief Locality-sensitive hashing index of MinHash signatures, for finding
+ * similar containers among many without comparing every pair.
+ *
+ * The first `nBands * rowsPerBand` entries of each signature are split into
+ * bands of `rowsPerBand` entries, and each band is hashed into a bucket.
+ * Signatures that agree on all the entries of at least one band are
+ * candidates for each other.  Two containers of Jaccard similarity s are
+ * candidates with probability 1 - (1 - s^rowsPerBand)^nBands, which rises
+ * steeply around getThreshold(); for example 32 bands of 4 rows find more
+ * than 99.9% of pairs with s = 0.7 but only 23% of pairs with s = 0.3.  Candidates are then
+ * filtered by the similarity estimated from their full signatures.
+ *
+ * Signatures are numbered in order of insertion, starting at 0.  All must
+ * have the same length.  Memory use is 4 bytes per signature entry plus
+ * 4 bytes per signature and band, and up to about 40 bytes more per
+ * distinct bucket.
+ *
+ * Queries do not modify the index, so they may run concurrently with each
+ * other, but not with insertions.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/MinHash.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT MinHashIndex {
+public:
+    /**
+     * Construct an empty index.
+     *
+     * @param[in] nBands Number of bands.
+     * @param[in] rowsPerBand Number of signature entries in each band.
+     * @throws InvalidParameterError nBands or rowsPerBand is not positive.
+     */
+    explicit MinHashIndex(int nBands = 32, int rowsPerBand = 4);
+
+    ~MinHashIndex() noexcept;
+
+    MinHashIndex(MinHashIndex const&);
+    MinHashIndex(MinHashIndex&&);
+    MinHashIndex& operator=(MinHashIndex const&);
+    MinHashIndex& operator=(MinHashIndex&&);
+
+    /// Return the number of bands.
+    int getNumBands() const { return _nBands; }
+
+    /// Return the number of signature entries in each band.
+    int getRowsPerBand() const { return _rowsPerBand; }
+
+    /// Return the similarity at which signatures are candidates with a probability of about one half.
+    double getThreshold() const;
+
+    /// Return the number of signatures in the index.
+    std::size_t size() const { return _next.size() / _nBands; }
+
+    /// Remove all signatures.
+    void clear();
+
+    /**
+     * Add a signature to the index.
+     *
+     * @param[in] signature Signature to add.
+     * @return The number of the signature.
+     * @throws LengthError The signature is shorter than nBands * rowsPerBand, or differs in
+     *         length from those already in the index.
+     */
+    std::size_t insert(MinHash::Signature const& signature);
+
+    /**
+     * Add many signatures to the index, hashing their bands in parallel.
+     *
+     * @param[in] signatures Signatures to add.
+     * @param[in] nThreads Maximum number of threads to use; 0 for the number of hardware threads.
+     * @return The number of the first signature; the others follow in order.
+     * @throws LengthError As for insert(MinHash::Signature const&); no signature is then added.
+     */
+    std::size_t insert(std::vector<MinHash::Signature> const& signatures, int nThreads = 0);
+
+    /**
+     * Return the signature with a given number.
+     *
+     * @throws OutOfRangeError There is no such signature.
+     */
+    MinHash::Signature getSignature(std::size_t id) const;
+
+    /**
+     * Find the signatures similar to a given one.
+     *
+     * @param[in] signature Signature to look for.
+     * @param[in] threshold Smallest estimated similarity to report.
+     * @return The numbers of the candidates whose estimated similarity is at
+     *         least `threshold`, most similar first and then in order of number.
+     * @throws LengthError The signature differs in length from those in the index.
+     */
+    std::vector<std::size_t> query(MinHash::Signature const& signature, double threshold = 0.0) const;
+
+    /**
+     * Find the signatures similar to each of many.
+     *
+     * @param[in] signatures Signatures to look for.
+     * @param[in] threshold Smallest estimated similarity to report.
+     * @param[in] nThreads Maximum number of threads to use; 0 for the number of hardware threads.
+     * @return The result of query(MinHash::Signature const&, double) for each signature.
+     * @throws LengthError One of the signatures differs in length from those in the index.
+     */
+    std::vector<std::vector<std::size_t>> query(std::vector<MinHash::Signature> const& signatures,
+                                                double threshold, int nThreads = 0) const;
+
+    /**
+     * Group the signatures in the index.
+     *
+     * Within each bucket, every signature whose estimated similarity to the
+     * most recently inserted one is at least `threshold` joins its group,
+     * and groups that share a signature are merged.  This takes time linear
+     * in the size of the index, even when many signatures are identical.
+     *
+     * @param[in] threshold Smallest estimated similarity for joining a group.
+     * @return For each signature, the smallest number in its group.
+     */
+    std::vector<std::size_t> cluster(double threshold) const;
+
+private:
+    static std::uint32_t const NONE;
+
+    // Hash of band `band` of a signature
+    std::uint64_t _bandHash(std::uint32_t const* signature, int band) const;
+
+    // Check the length of a signature against those in the index
+    void _checkLength(MinHash::Signature const& signature) const;
+
+    // Estimated similarity of signature `id` to another
+    double _similarity(std::size_t id, std::uint32_t const* signature) const;
+
+    // Add a signature whose band hashes are known
+    void _insert(std::uint32_t const* signature, std::uint64_t const* hashes);
+
+    int _nBands;
+    int _rowsPerBand;
+    std::size_t _length;                  // length of every signature; 0 while empty
+    std::vector<std::uint32_t> _entries;  // signatures, one after the other
+    // Per band: latest signature in each bucket, keyed by the hash of the band
+    std::vector<std::unordered_map<std::uint64_t, std::uint32_t>> _buckets;
+    std::vector<std::uint32_t> _next;  // per signature and band: previous signature in the bucket, or NONE
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
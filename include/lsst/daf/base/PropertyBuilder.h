@@ -0,0 +1,145 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_PROPERTYBUILDER
+#define LSST_DAF_BASE_PROPERTYBUILDER
+
+/** @class lsst::daf::base::PropertyBuilder
+ * @brief PropertyHandler that fills in a PropertySet or PropertyList.
+ *
+ * The outermost `beginSet` corresponds to the target container itself.
+ * Each key replaces any existing values, as PropertySet::set does; arrays
+ * are assembled in place and stored with a single insertion.
+ *
+ * Nested sets become subproperties of a hierarchical PropertySet.  When the
+ * target is flat (a PropertyList) they are flattened into dotted names, and
+ * `comment` events are recorded for the most recent key.
+ * Subproperties of a concurrent target are made concurrent before they are
+ * inserted, so other threads may read the target while it is being filled.
+ *
+ * A copy of any container can thus be made with
+ * @code
+ * PropertyBuilder builder(target);
+ * source.walk(builder);
+ * @endcode
+ * and a format reader only needs to turn its input into events.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "boost/any.hpp"
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class PropertyList;
+
+class LSST_EXPORT PropertyBuilder : public PropertyHandler {
+public:
+    /**
+     * Construct a builder that adds properties to an existing container.
+     *
+     * @param[in] target Container to fill; it is usually empty.
+     * @throws InvalidParameterError target is null.
+     */
+    explicit PropertyBuilder(PropertySet::Ptr target);
+
+    ~PropertyBuilder() noexcept override;
+
+    PropertyBuilder(PropertyBuilder const&) = delete;
+    PropertyBuilder& operator=(PropertyBuilder const&) = delete;
+
+    /// Return the container being filled.
+    PropertySet::Ptr getTarget() const { return _target; }
+
+    void beginSet(std::size_t size) override;
+    void endSet() override;
+    void key(std::string const& name) override;
+    void comment(std::string const& comment) override;
+    void beginArray(std::size_t size) override;
+    void endArray() override;
+
+    void value(bool v) override;
+    void value(char v) override;
+    void value(signed char v) override;
+    void value(unsigned char v) override;
+    void value(short v) override;
+    void value(unsigned short v) override;
+    void value(int v) override;
+    void value(unsigned int v) override;
+    void value(long v) override;
+    void value(unsigned long v) override;
+    void value(long long v) override;
+    void value(unsigned long long v) override;
+    void value(float v) override;
+    void value(double v) override;
+    void value(std::nullptr_t v) override;
+    void value(std::string const& v) override;
+    void value(DateTime const& v) override;
+    void value(Persistable::Ptr const& v) override;
+
+private:
+    typedef std::shared_ptr<std::vector<boost::any>> AnyVectorPtr;
+
+    // One level of set nesting
+    struct Frame {
+        PropertySet::Ptr set;  // container receiving values at this level
+        std::string prefix;    // prepended to keys when flattening into a flat container
+        bool append;           // add rather than set (sets within an array, flattened)
+        std::string key;       // most recent key at this level
+        AnyVectorPtr array;    // elements of the array being built, if any
+        bool stored;           // array has already been inserted into set
+    };
+
+    Frame& _top();
+    void _put(Frame& frame, AnyVectorPtr const& vp);
+
+    // Lock the container of a frame for writing if its array is already stored there, and it is concurrent
+    std::unique_lock<PropertySet::Mutex> _lockArray(Frame const& frame) const;
+
+    template <typename T>
+    void _value(T const& v);
+
+    PropertySet::Ptr _target;
+    PropertyList* _list;  // _target, if it is a PropertyList
+    std::vector<Frame> _frames;  // reused between sets to keep the capacity of their strings
+    std::size_t _depth;          // number of active frames
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
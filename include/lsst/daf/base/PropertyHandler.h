@@ -0,0 +1,129 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_PROPERTYHANDLER
+#define LSST_DAF_BASE_PROPERTYHANDLER
+
+/** @class lsst::daf::base::PropertyHandler
+ * @brief Receiver of the events produced by walking a PropertySet.
+ *
+ * PropertySet::walk describes the contents of a container as a stream of
+ * events, in the style of a SAX parser:
+ *
+ * @code
+ * beginSet(2)
+ *     key("a")  value(int)                          // scalar
+ *     key("b")  beginArray(3)  value(double) x 3  endArray()
+ *     key("c")  beginSet(1)  key("d")  value(std::string)  endSet()
+ * endSet()
+ * @endcode
+ *
+ * A PropertyList additionally emits a `comment` event after the value(s)
+ * of every key.  Names and values are passed by reference to the storage of
+ * the container being walked, so walking does not copy or allocate.
+ *
+ * Format writers implement this interface; format readers drive a
+ * PropertyBuilder, which implements it by filling in a container.
+ *
+ * The structural events have empty default implementations; every value
+ * type must be handled explicitly.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <string>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/Persistable.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT PropertyHandler {
+public:
+    PropertyHandler() = default;
+    PropertyHandler(PropertyHandler const&) = default;
+    PropertyHandler& operator=(PropertyHandler const&) = default;
+
+    virtual ~PropertyHandler() noexcept;
+
+    /**
+     * Start a (possibly nested) set of properties.
+     *
+     * @param[in] size Number of keys that will follow at this level.
+     */
+    virtual void beginSet(std::size_t size) {}
+
+    /// End the set most recently started by beginSet.
+    virtual void endSet() {}
+
+    /**
+     * Name of the property whose value(s) follow.
+     *
+     * @param[in] name Property name; hierarchical for PropertyList, a single component otherwise.
+     */
+    virtual void key(std::string const& name) {}
+
+    /// Comment for the property most recently named by key (PropertyList only).
+    virtual void comment(std::string const& comment) {}
+
+    /**
+     * Start an array of values or of sets.  Properties with a single value
+     * are reported as scalars without an enclosing array.
+     *
+     * @param[in] size Number of elements that will follow.
+     */
+    virtual void beginArray(std::size_t size) {}
+
+    /// End the array most recently started by beginArray.
+    virtual void endArray() {}
+
+    virtual void value(bool v) = 0;
+    virtual void value(char v) = 0;
+    virtual void value(signed char v) = 0;
+    virtual void value(unsigned char v) = 0;
+    virtual void value(short v) = 0;
+    virtual void value(unsigned short v) = 0;
+    virtual void value(int v) = 0;
+    virtual void value(unsigned int v) = 0;
+    virtual void value(long v) = 0;
+    virtual void value(unsigned long v) = 0;
+    virtual void value(long long v) = 0;
+    virtual void value(unsigned long long v) = 0;
+    virtual void value(float v) = 0;
+    virtual void value(double v) = 0;
+    virtual void value(std::nullptr_t v) = 0;
+    virtual void value(std::string const& v) = 0;
+    virtual void value(DateTime const& v) = 0;
+    virtual void value(Persistable::Ptr const& v) = 0;
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
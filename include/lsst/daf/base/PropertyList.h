@@ -142,6 +142,18 @@ public:
     /// @copydoc PropertySet::toString()
     virtual std::string toString(bool topLevelOnly = false, std::string const& indent = "") const;
 
+    /**
+     * Describe the contents of the PropertyList as a sequence of events sent
+     * to a PropertyHandler.
+     *
+     * Names are reported in the order they were added, each followed by its
+     * value(s) and then a `comment` event.
+     *
+     * @param[in] handler Receiver of the events.
+     */
+    virtual void walk(PropertyHandler& handler) const;
+    using PropertySet::walk;
+
     // Modifiers
 
     /// @copydoc PropertySet::set(std::string const &, T const &)
@@ -165,6 +177,9 @@ public:
     /// @copydoc PropertySet::set(std::string const &, char const*)
     void set(std::string const& name, char const* value);
 
+    /// @copydoc PropertySet::set(std::string const&, double, DateTime const&)
+    void set(std::string const& name, double value, DateTime const& time);
+
     /// @copydoc PropertySet::add(std::string const&, T const&)
     template <typename T>
     void add(std::string const& name, T const& value);
@@ -283,16 +298,51 @@ public:
     /// @copydoc PropertySet::remove
     virtual void remove(std::string const& name);
 
+    /// @copydoc PropertySet::remove(std::vector<std::string> const&)
+    virtual std::size_t remove(std::vector<std::string> const& names);
+
+    /// @copydoc PropertySet::removeIf
+    virtual std::size_t removeIf(RemovePredicate const& predicate);
+
+    /// @copydoc PropertySet::savepoint
+    virtual void savepoint();
+
+    /// @copydoc PropertySet::rollback
+    virtual void rollback();
+
+    /// @copydoc PropertySet::release
+    virtual void release();
+
 private:
+    friend class PropertyBuilder;
 
     typedef std::unordered_map<std::string, std::string> CommentMap;
 
+    // Changes to the order and comments made since the outermost savepoint
+    struct OrderLog;
+
     virtual void _set(std::string const& name, std::shared_ptr<std::vector<boost::any> > vp);
     virtual void _moveToEnd(std::string const& name);
     virtual void _commentOrderFix(std::string const& name, std::string const& comment);
 
+    // Drop the order and comment entries of names no longer in the base map, in one pass
+    void _compactOrder();
+
+    /*
+     * Modify the order and comments, recording the change if there is a
+     * savepoint.  Nodes of _order are spliced rather than copied, so that
+     * the iterators in the log stay valid.
+     */
+    void _pushName(std::string const& name);              // append a name, with an empty comment
+    void _moveName(std::list<std::string>::iterator i);   // move a name to the end
+    void _eraseName(std::list<std::string>::iterator i);  // drop a name and its comment
+    void _eraseName(std::string const& name);             // drop a name and its comment, if present
+    void _setComment(std::string const& name, std::string const& comment);
+    void _eraseComment(std::string const& name);
+
     CommentMap _comments;
     std::list<std::string> _order;
+    std::unique_ptr<OrderLog> _orderLog;  // null unless there is a savepoint
 };
 
 #if defined(__ICC)
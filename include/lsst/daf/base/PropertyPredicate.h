@@ -0,0 +1,184 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_PROPERTYPREDICATE
+#define LSST_DAF_BASE_PROPERTYPREDICATE
+
+/** @class lsst::daf::base::PropertyPredicate
+ * @brief Boolean expression over the values in a PropertySet, compiled once
+ * and evaluated against many containers.
+ *
+ * For example,
+ * @code
+ * PropertyPredicate const selected("EXPTIME > 30 and FILTER in ('r', 'i') and DATE-OBS > '2026-01-01'");
+ * if (selected(*header)) { ... }
+ * @endcode
+ *
+ * The grammar is
+ * @code
+ * expr       := expr 'or' expr | expr 'and' expr | 'not' expr | '(' expr ')'
+ *             | operand op operand | NAME ['not'] 'in' '(' literal (',' literal)* ')'
+ *             | 'exists' '(' NAME ')' | NAME | 'true' | 'false'
+ * op         := '==' | '!=' | '<' | '<=' | '>' | '>='
+ * operand    := NAME | literal
+ * literal    := number | 'string' | "string"
+ * @endcode
+ * where `and` binds more tightly than `or`, keywords are not case sensitive,
+ * and a NAME is a property name such as `DATE-OBS` or `a.b.c`; names that
+ * are not valid identifiers may be quoted with backticks.
+ *
+ * The expression is compiled into a sequence of instructions in which each
+ * distinct name is replaced by a slot, which is looked up at most once per
+ * evaluation, and each comparison is specialized for the type of its
+ * literal: numeric literals compare numerically with integer and
+ * floating-point values, and string literals compare with string values
+ * and, if the literal is an ISO8601 date, with DateTime values.  A date
+ * without a final Z is taken to be TAI, as in DateTime's ISO8601
+ * constructor, and a date without a time refers to its start.
+ *
+ * The last value of an array property is used.  A comparison involving a
+ * missing property, or values of incompatible types, is false.  A bare NAME
+ * is true if the property is a true bool or a nonzero number.
+ *
+ * Evaluation does not modify the predicate, so a predicate may be shared
+ * between threads.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstdint>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT PropertyPredicate {
+public:
+    /**
+     * Compile an expression.
+     *
+     * @param[in] expression Expression to compile.
+     * @throws InvalidParameterError The expression is malformed.
+     */
+    explicit PropertyPredicate(std::string const& expression);
+
+    ~PropertyPredicate() noexcept;
+
+    PropertyPredicate(PropertyPredicate const&);
+    PropertyPredicate(PropertyPredicate&&);
+    PropertyPredicate& operator=(PropertyPredicate const&);
+    PropertyPredicate& operator=(PropertyPredicate&&);
+
+    /// Return the expression.
+    std::string const& getExpression() const { return _expression; }
+
+    /// Return the names of the properties used by the expression, in order of first use.
+    std::vector<std::string> const& getNames() const { return _names; }
+
+    /// Evaluate the expression for a container.
+    bool operator()(PropertySet const& properties) const;
+
+    /**
+     * Evaluate the expression for each of many containers.
+     *
+     * @param[in] properties Containers to evaluate the expression for.
+     * @param[in] nThreads Maximum number of threads to use; 0 for the number of hardware threads.
+     * @return The value of the expression for each container, in the same order.
+     * @throws InvalidParameterError One of the containers is null.
+     */
+    std::vector<bool> operator()(std::vector<PropertySet::ConstPtr> const& properties,
+                                 int nThreads = 0) const;
+
+private:
+    enum class OpCode : std::uint8_t {
+        CONSTANT,        // push a (bool)
+        TRUTH,           // push the truth of slot a
+        EXISTS,          // push whether slot a exists
+        COMPARE_LITERAL, // push slot a <cmp> literal b
+        COMPARE_SLOTS,   // push slot a <cmp> slot b
+        IN,              // push whether slot a is in set b
+        NOT,             // negate the top of the stack
+        AND,             // if the top is false jump to a, else pop
+        OR               // if the top is true jump to a, else pop
+    };
+
+    enum Comparison : std::uint8_t { EQ, NE, LT, LE, GT, GE };
+
+    struct Instruction {
+        OpCode op;
+        Comparison cmp;
+        std::uint32_t a;
+        std::uint32_t b;
+    };
+
+    // A literal, in each of the forms it may be compared in
+    struct Literal {
+        std::string string;
+        bool isString;
+        bool isNumber;
+        bool isInteger;  // number is exactly representable as integer
+        bool isDate;     // string is an ISO8601 date
+        long long integer;
+        double number;
+        long long date;  // TAI nanoseconds
+    };
+
+    // The literals of an 'in' expression, in each of the forms they may be compared in
+    struct LiteralSet {
+        std::unordered_set<std::string> strings;
+        std::vector<long long> integers;  // sorted
+        std::vector<double> numbers;      // sorted
+        std::vector<long long> dates;     // sorted
+    };
+
+    // Value of a property, as seen by the expression
+    struct Value;
+
+    class Parser;
+
+    static void _resolve(PropertySet const& properties, std::string const& name, Value& value);
+    bool _evaluate(PropertySet const& properties, Value* slots, bool* resolved, bool* stack) const;
+    bool _compare(Value const& value, Comparison cmp, Literal const& literal) const;
+    static bool _compare(Value const& lhs, Comparison cmp, Value const& rhs);
+    static bool _contains(LiteralSet const& set, Value const& value);
+
+    std::string _expression;
+    std::vector<std::string> _names;  // name of each slot
+    std::vector<Instruction> _code;
+    std::vector<Literal> _literals;
+    std::vector<LiteralSet> _sets;
+    std::size_t _maxDepth;  // maximum depth of the evaluation stack
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -40,19 +40,30 @@
  * dotted paths but is not actually hierarchical in structure.  This is used to
  * support PropertyList.
  *
+ * A hierarchical PropertySet can be made concurrent, so that threads may
+ * read and modify it at the same time.  Each nested PropertySet then has its
+ * own lock, so that writers to disjoint subproperties, such as "tasks.a.x"
+ * and "tasks.b.y", do not wait for each other; see makeConcurrent.
+ *
  * @ingroup daf_base
  */
 
+#include <atomic>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <typeinfo>
-#include <unordered_map>
 #include <vector>
 
 #include "boost/any.hpp"
 
 #include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
 #include "lsst/daf/base/Persistable.h"
+#include "lsst/daf/base/detail/SmallMap.h"
 #include "lsst/pex/exceptions.h"
 
 namespace lsst {
@@ -64,12 +75,24 @@ namespace base {
 #pragma warning(disable : 444)
 #endif
 
+class PropertyBuilder;
+class PropertyHandler;
+class TimeSeries;
+
 class LSST_EXPORT PropertySet {
 public:
     // Typedefs
     typedef std::shared_ptr<PropertySet> Ptr;
     typedef std::shared_ptr<PropertySet const> ConstPtr;
 
+    /**
+     * Predicate used by removeIf.  Called with the name of a property, the
+     * type of its values and its last value; returns true to remove it.
+     */
+    typedef std::function<bool(std::string const& name, std::type_info const& type,
+                               boost::any const& value)>
+            RemovePredicate;
+
     /**
      * Construct an empty PropertySet
      *
@@ -329,6 +352,35 @@ public:
      */
     Persistable::Ptr getAsPersistablePtr(std::string const& name) const;
 
+    /**
+     * Get the last value for a DateTime, ISO8601 string or MJD property name
+     * (possibly hierarchical).
+     *
+     * Strings are parsed as by the DateTime constructor, except that a
+     * missing time zone "Z" is accepted for UTC, as in FITS headers, and a
+     * date alone means the start of that day.  Numbers other than bool are
+     * MJDs.  The result of a conversion is cached until the property is set,
+     * added to or removed, so repeated calls only cost a lookup.
+     *
+     * @param[in] name Property name to examine, possibly hierarchical.
+     * @param[in] scale Time scale of string and MJD values; ignored for DateTime values.
+     * @return Value as a DateTime.
+     * @throws NotFoundError Property does not exist.
+     * @throws TypeError Value cannot be converted to DateTime.
+     */
+    DateTime getAsDateTime(std::string const& name, DateTime::Timescale scale) const;
+
+    /**
+     * Get the TimeSeries stored under a property name (possibly hierarchical).
+     *
+     * @param[in] name Property name to examine, possibly hierarchical.
+     * @return TimeSeries, shared with this PropertySet.
+     *
+     * @throws NotFoundError Property does not exist.
+     * @throws TypeError Value is not a TimeSeries.
+     */
+    std::shared_ptr<TimeSeries> getTimeSeries(std::string const& name) const;
+
     /**
      * Generate a string representation of the PropertySet.
      *
@@ -340,6 +392,27 @@ public:
      */
     virtual std::string toString(bool topLevelOnly = false, std::string const& indent = "") const;
 
+    /**
+     * Describe the contents of the PropertySet, including subproperties, as a
+     * sequence of events sent to a PropertyHandler.
+     *
+     * The events are bracketed by `beginSet` and `endSet`; subproperties are
+     * reported as nested sets.  No names or values are copied.
+     *
+     * @param[in] handler Receiver of the events.
+     */
+    virtual void walk(PropertyHandler& handler) const;
+
+    /**
+     * Send the value(s) of a single property name (possibly hierarchical) to
+     * a PropertyHandler, without a `key` event.
+     *
+     * @param[in] name Property name to examine, possibly hierarchical.
+     * @param[in] handler Receiver of the events.
+     * @throws NotFoundError Property does not exist.
+     */
+    void walk(std::string const& name, PropertyHandler& handler) const;
+
     // Modifiers
 
     /**
@@ -373,6 +446,22 @@ public:
      */
     void set(std::string const& name, char const* value);
 
+    /**
+     * Record a time-stamped value for a property name (possibly hierarchical).
+     *
+     * If the property holds a TimeSeries the sample is added to it;
+     * otherwise all values are replaced by a new TimeSeries, without a
+     * capacity limit, holding this sample.  To limit the number of samples
+     * retained, first set the property to an empty TimeSeries of the desired
+     * capacity, as a Persistable::Ptr.
+     *
+     * @param[in] name Property name to set, possibly hierarchical.
+     * @param[in] value Value of the sample.
+     * @param[in] time Time of the sample.
+     * @throws InvalidParameterError time is not valid.
+     */
+    void set(std::string const& name, double value, DateTime const& time);
+
     /**
      * Append a single value to the vector of values for a property name
      * (possibly hierarchical).  Sets the value if the property does not exist.
@@ -450,6 +539,98 @@ public:
      */
     virtual void remove(std::string const& name);
 
+    /**
+     * Remove all values for several property names (possibly hierarchical).
+     * Names that do not exist are ignored.
+     *
+     * @param[in] names Property names to remove, possibly hierarchical.
+     * @return Number of properties removed.
+     */
+    virtual std::size_t remove(std::vector<std::string> const& names);
+
+    /**
+     * Remove every top-level property for which a predicate is true, in a
+     * single pass over the container.  In a PropertyList every name is
+     * top-level.
+     *
+     * @param[in] predicate Called once for each property; returns true to remove it.
+     * @return Number of properties removed.
+     *
+     * @warning If the predicate throws, the properties already tested may
+     *          have been removed.
+     */
+    virtual std::size_t removeIf(RemovePredicate const& predicate);
+
+    // Concurrency
+
+    /**
+     * Let threads read and modify this PropertySet, and its subproperties,
+     * at the same time.
+     *
+     * Each nested PropertySet gets its own readers-writer lock.  A lookup
+     * locks the sets along a hierarchical name one at a time for reading, and
+     * a modification locks the set holding the property for writing, so that
+     * operations on disjoint subproperties proceed in parallel.  Creating a
+     * subproperty locks its parent for writing only while it is inserted.
+     * Subproperties that are created, set or added later are made concurrent
+     * too.  Getting a subproperty and modifying it directly avoids locking its
+     * ancestors altogether.
+     *
+     * Each member function is atomic with respect to the set holding the
+     * properties it names.  Functions over a whole set, such as names,
+     * toString or deepCopy, see each nested set atomically but not the tree
+     * as a whole.  The predicate of removeIf must not access this set.
+     *
+     * Must be called before the set is shared between threads.  Deep copies
+     * are not concurrent.
+     *
+     * @throws LogicError This set, or one of its subproperties, is flat, or
+     *         this set has a savepoint.
+     */
+    void makeConcurrent();
+
+    /// Return whether makeConcurrent has been called.
+    bool isConcurrent() const noexcept { return static_cast<bool>(_mutex); }
+
+    // Savepoints
+
+    /**
+     * Start recording changes, so that they can be undone by rollback
+     * instead of restoring a deep copy made beforehand.
+     *
+     * The first time a property is set, added to or removed after the
+     * savepoint, its vector of values and their number are recorded; values
+     * are only appended in place, so rollback takes time proportional to the
+     * number of properties changed.  A TimeSeries is copied before its first
+     * new sample.  A PropertyList also records changes to its order and
+     * comments.
+     *
+     * Savepoints nest: rollback and release apply to the most recent one.
+     * Changes made directly to a subproperty, through its PropertySet::Ptr,
+     * are not recorded.
+     *
+     * @throws LogicError This set is concurrent.
+     */
+    virtual void savepoint();
+
+    /**
+     * Undo the changes made since the most recent savepoint, and end it.
+     *
+     * @throws LogicError There is no savepoint.
+     */
+    virtual void rollback();
+
+    /**
+     * End the most recent savepoint, keeping the changes made since.  They
+     * are still undone by rolling back an enclosing savepoint.
+     *
+     * @throws LogicError There is no savepoint.
+     */
+    virtual void release();
+
+    /// Return whether there is a savepoint to roll back to.
+    bool hasSavepoint() const noexcept { return static_cast<bool>(_undo); }
+
 protected:
     /*
      * Find the property name (possibly hierarchical) and set or replace its
@@ -476,24 +657,73 @@ protected:
     virtual std::string _format(std::string const& name) const;
 
 private:
+    friend class PropertyBuilder;
+    friend class PropertyPredicate;
+
+    // Nested sets usually hold only a few properties, which this finds without hashing
+    typedef detail::SmallMap<std::shared_ptr<std::vector<boost::any> > > AnyMap;
 
-    typedef std::unordered_map<std::string, std::shared_ptr<std::vector<boost::any> > > AnyMap;
+    // Results of getAsDateTime conversions
+    struct DateTimeCache;
+
+    // Changes made since the outermost savepoint
+    struct UndoLog;
+
+    // Lock of a concurrent set
+    typedef std::shared_timed_mutex Mutex;
+
+    /*
+     * Entry of a property found by _find, used like an AnyMap iterator.  In
+     * concurrent mode it keeps the set holding the entry locked, and alive,
+     * until it is destroyed.
+     */
+    template <typename Iterator, typename LockType>
+    class Found {
+    public:
+        typedef LockType Lock;
+
+        Found() : _entry(nullptr) {}
+
+        Iterator operator->() const noexcept { return _entry; }
+        bool operator==(std::nullptr_t) const noexcept { return _entry == nullptr; }
+        bool operator!=(std::nullptr_t) const noexcept { return _entry != nullptr; }
+
+        // Whether the entry can only be used until this is destroyed
+        bool isLocked() const noexcept { return _lock.owns_lock(); }
+
+    private:
+        friend class PropertySet;
+
+        ConstPtr _owner;  // set holding the entry, if a locked subproperty; released after _lock
+        Lock _lock;
+        Iterator _entry;
+    };
+
+    typedef Found<AnyMap::iterator, std::unique_lock<Mutex> > Entry;
+    typedef Found<AnyMap::const_iterator, std::shared_lock<Mutex> > ConstEntry;
 
     /*
-     * Find the property name (possibly hierarchical).
+     * Find the property name (possibly hierarchical), locking the set that
+     * holds it for writing.
      *
      * @param[in] name Property name to find, possibly hierarchical.
-     * @return unordered_map::iterator to the property or end() if nonexistent.
+     * @return Entry of the property, in this set or a subproperty, or null
+     *         if nonexistent.
      */
-    AnyMap::iterator _find(std::string const& name);
+    Entry _find(std::string const& name);
 
     /*
-     * Find the property name (possibly hierarchical).  Const version.
+     * Find the property name (possibly hierarchical), locking the set that
+     * holds it for reading.  Const version.
      *
      * @param[in] name Property name to find, possibly hierarchical.
-     * @return unordered_map::const_iterator to the property or end().
+     * @return Entry of the property, or null if nonexistent.
      */
-    AnyMap::const_iterator _find(std::string const& name) const;
+    ConstEntry _find(std::string const& name) const;
+
+    // Implementation of both versions of _find
+    template <typename Result, typename Self>
+    static Result _findIn(Self& self, std::string const& name);
 
     /*
      * Find the property name (possibly hierarchical) and set or replace its
@@ -501,15 +731,60 @@ private:
      *
      * @param[in] name Property name to find, possibly hierarchical.
      * @param[in] vp shared_ptr to vector of values.
+     * @param[in] append Append to the values of an existing property instead of replacing them.
      * @throws InvalidParameterError Hierarchical name uses non-PropertySet.
+     * @throws TypeError append is true and the type does not match existing values.
      */
-    virtual void _findOrInsert(std::string const& name, std::shared_ptr<std::vector<boost::any> > vp);
+    virtual void _findOrInsert(std::string const& name, std::shared_ptr<std::vector<boost::any> > vp,
+                               bool append = false);
+
+    /*
+     * Get the subproperty that is the first component of a hierarchical
+     * name.  Does not lock this set.
+     *
+     * @param[in] prefix First component of the name.
+     * @param[out] p The subproperty, if it exists.
+     * @return Whether the subproperty exists.
+     * @throws InvalidParameterError prefix exists but is not a PropertySet::Ptr.
+     */
+    bool _findSubset(std::string const& prefix, Ptr& p) const;
+
+    // Remove a property (possibly hierarchical); return whether it existed
+    bool _remove(std::string const& name);
+
     void _cycleCheckPtrVec(std::vector<Ptr> const& v, std::string const& name);
     void _cycleCheckAnyVec(std::vector<boost::any> const& v, std::string const& name);
     void _cycleCheckPtr(Ptr const& v, std::string const& name);
 
+    // Make subproperties about to be inserted concurrent, if this set is
+    void _shareAnyVec(std::vector<boost::any> const& v);
+
+    // Lock this set for reading or writing, if it is concurrent
+    std::shared_lock<Mutex> _lockShared() const;
+    std::unique_lock<Mutex> _lockUnique() const;
+
+    // Return the cache of getAsDateTime, creating it on first use
+    DateTimeCache& _getDateTimeCache() const;
+
+    // Record the values of a property (possibly hierarchical) about to change, if there is a savepoint
+    void _touch(std::string const& name) {
+        if (_undo) {
+            _record(name);
+        }
+    }
+
+    // Record the values of a property, or its absence, unless already recorded since the savepoint
+    void _record(std::string const& name);
+    void _record(PropertySet* owner, Ptr const& hold, std::string const& key);
+
+    // Record the samples of a TimeSeries about to be added to, if there is a savepoint
+    void _recordSeries(std::shared_ptr<TimeSeries> const& series);
+
     AnyMap _map;
     bool _flat;
+    mutable std::atomic<DateTimeCache*> _dateTimeCache;  // owned; null until first needed
+    std::unique_ptr<Mutex> _mutex;                        // null unless concurrent
+    std::unique_ptr<UndoLog> _undo;                       // null unless there is a savepoint
 };
 
 #if defined(__ICC)
@@ -0,0 +1,156 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_PROPERTYTEMPLATE
+#define LSST_DAF_BASE_PROPERTYTEMPLATE
+
+/** @class lsst::daf::base::PropertyTemplate
+ * @brief String template whose fields are filled in from a PropertySet.
+ *
+ * The template is parsed once, when it is constructed, into a sequence of
+ * literal text and property steps; rendering then only looks up and formats
+ * the properties.  For example,
+ * @code
+ * PropertyTemplate const path("{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}");
+ * std::string const name = path.render(*header);  // e.g. "LATISS/20230115/000042"
+ * @endcode
+ *
+ * Fields are written as `{NAME}` or `{NAME:SPEC}`, where NAME is a property
+ * name as accepted by PropertySet::get, and `{{` and `}}` stand for literal
+ * braces.  SPEC follows the Python format specification mini-language,
+ * `[[fill]align][sign][0][width][.precision][type]`, with types
+ * `s d x X o e E f F g G %`.  A SPEC that starts with one of the directives
+ * `%Y %y %m %d %j %H %M %S %f %%` formats a date instead; it applies to
+ * DateTime values, which are expressed in UTC, and to ISO8601 strings such
+ * as FITS DATE-OBS values, whose fields are used as they are.
+ *
+ * Without a type, integers are written in decimal, floating-point values as
+ * the shortest string that reads back exactly, in fixed notation for decimal
+ * exponents in [-4, 16) and in scientific notation otherwise (as Python's
+ * `repr` does), booleans as `True` or `False`, undefined values as `None`
+ * and DateTime values as ISO8601 UTC strings.  The last value of an array is
+ * used.
+ *
+ * @ingroup daf_base
+ */
+
+#include <string>
+#include <vector>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT PropertyTemplate {
+public:
+    /**
+     * Parse a template.
+     *
+     * @param[in] format Template string.
+     * @throws InvalidParameterError The template or one of its format specifications is malformed.
+     */
+    explicit PropertyTemplate(std::string const& format);
+
+    ~PropertyTemplate() noexcept;
+
+    PropertyTemplate(PropertyTemplate const&);
+    PropertyTemplate(PropertyTemplate&&);
+    PropertyTemplate& operator=(PropertyTemplate const&);
+    PropertyTemplate& operator=(PropertyTemplate&&);
+
+    /// Return the template string.
+    std::string const& getFormat() const { return _format; }
+
+    /// Return the names of the properties used by the template, in order of first use.
+    std::vector<std::string> getNames() const;
+
+    /**
+     * Fill in the template.
+     *
+     * @param[in] properties Container holding the values of the fields.
+     * @return The rendered string.
+     * @throws NotFoundError A property used by the template does not exist.
+     * @throws TypeError A property value cannot be formatted as requested.
+     */
+    std::string render(PropertySet const& properties) const;
+
+    /**
+     * Fill in the template, appending the result to a string.
+     *
+     * Reusing the same string for many renderings avoids allocation once it
+     * has grown to the length of the result.
+     *
+     * @param[in] properties Container holding the values of the fields.
+     * @param[in,out] out String to append to.
+     * @throws NotFoundError A property used by the template does not exist.
+     * @throws TypeError A property value cannot be formatted as requested.
+     */
+    void render(PropertySet const& properties, std::string& out) const;
+
+    /**
+     * Fill in the template for each of many containers.
+     *
+     * @param[in] properties Containers holding the values of the fields.
+     * @return The rendered strings, in the same order.
+     * @throws NotFoundError A property used by the template does not exist in one of the containers.
+     * @throws TypeError A property value cannot be formatted as requested.
+     */
+    std::vector<std::string> render(std::vector<PropertySet::ConstPtr> const& properties) const;
+
+private:
+    // Format specification of a field
+    struct Spec {
+        char fill;               // padding character
+        char align;              // '<', '>', '^' or '=' (pad after the sign); 0 for the default
+        char sign;               // '+', ' ' or 0
+        int width;               // minimum width
+        int precision;           // -1 if not given
+        char type;               // presentation type, or 0
+        std::string dateFormat;  // date format, if the specification starts with a directive
+    };
+
+    // Literal text or a property to format
+    struct Step {
+        bool isField;
+        std::string text;  // literal text, or property name
+        Spec spec;
+    };
+
+    // PropertyHandler that formats the value of a field
+    class Renderer;
+
+    static Spec _parseSpec(std::string const& spec);
+
+    std::string _format;
+    std::vector<Step> _steps;
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,254 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_STATICPROPERTYLIST
+#define LSST_DAF_BASE_STATICPROPERTYLIST
+
+/** @class lsst::daf::base::StaticPropertyList
+ * @brief Ordered, commented scalar properties in fixed-capacity inline storage.
+ *
+ * A StaticPropertyList holds up to NKeys properties, whose names, string
+ * values and comments share an arena of NBytes bytes stored in the object
+ * itself.  Nothing is allocated after construction, so the object can be
+ * filled on code paths with strict latency requirements, then converted
+ * into a regular PropertyList elsewhere:
+ *
+ * @code
+ * StaticPropertyList<64, 4096> md;   // typically a long-lived member
+ * md.clear();
+ * md.set("EXPTIME", 15.0, "exposure time (s)");
+ * md.set("DATE-BEG", DateTime::now());
+ * ...
+ * auto header = md.toPropertyList();
+ * @endcode
+ *
+ * Properties are scalars of the arithmetic types supported by PropertySet,
+ * strings, and DateTime; each keeps its position and its comment when it is
+ * set again.  Names, string values and comments are passed as C strings so
+ * that string literals need not be converted to std::string, which may
+ * allocate.  Lookup is a linear search of the names, which is fastest for
+ * the small number of keys this class is meant for.
+ *
+ * Space in the arena is only reused when a string value or comment is
+ * replaced by one that is no longer; clear() releases all of it.  Operations
+ * that would exceed the capacity throw LengthError and leave the contents
+ * unchanged; only reporting such errors allocates.
+ *
+ * @ingroup daf_base
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class PropertyHandler;
+class PropertyList;
+
+/**
+ * Capacity-independent interface and implementation of StaticPropertyList,
+ * through which lists of any capacity can be passed.
+ */
+class LSST_EXPORT StaticPropertyListBase {
+public:
+    StaticPropertyListBase(StaticPropertyListBase const&) = delete;
+    StaticPropertyListBase& operator=(StaticPropertyListBase const&) = delete;
+
+    /// Return the number of properties.
+    std::size_t size() const noexcept { return _size; }
+
+    /// Return the maximum number of properties.
+    std::size_t getMaxKeys() const noexcept { return _maxKeys; }
+
+    /// Return the number of bytes of the arena in use.
+    std::size_t getBytesUsed() const noexcept { return _used; }
+
+    /// Return the size of the arena holding names, strings and comments.
+    std::size_t getMaxBytes() const noexcept { return _maxBytes; }
+
+    /// Remove all properties and release all space in the arena.
+    void clear() noexcept {
+        _size = 0;
+        _used = 0;
+    }
+
+    /// Return true if a property exists.
+    bool exists(char const* name) const noexcept;
+
+    /**
+     * Return the type of a property's value.
+     *
+     * @throws NotFoundError Property does not exist.
+     */
+    std::type_info const& typeOf(char const* name) const;
+
+    /**
+     * Return the value of a property.
+     *
+     * @tparam T Type of the value, which must match exactly.
+     * @throws NotFoundError Property does not exist.
+     * @throws TypeError Value does not have type T.
+     */
+    template <typename T>
+    T get(char const* name) const {
+        static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "Unsupported value type");
+        T value;
+        _get(name, typeid(T), &value, sizeof(T));
+        return value;
+    }
+
+    /**
+     * Return the comment of a property, empty if none has been set.
+     *
+     * @throws NotFoundError Property does not exist.
+     */
+    char const* getComment(char const* name) const;
+
+    //@{
+    /**
+     * Set the value of a property, adding it at the end if it does not exist.
+     *
+     * @param[in] name Property name.
+     * @param[in] value Scalar value.
+     * @param[in] comment Comment; if omitted, the existing comment is kept.
+     * @throws LengthError The list is full, or the arena cannot hold the name,
+     *                     string or comment.
+     */
+    template <typename T>
+    void set(char const* name, T value) {
+        static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "Unsupported value type");
+        _set(name, typeid(T), &value, sizeof(T), nullptr, nullptr);
+    }
+    template <typename T>
+    void set(char const* name, T value, char const* comment) {
+        static_assert(std::is_arithmetic<T>::value && sizeof(T) <= 8, "Unsupported value type");
+        _set(name, typeid(T), &value, sizeof(T), nullptr, comment);
+    }
+    void set(char const* name, char const* value) {
+        _set(name, typeid(std::string), nullptr, 0, value, nullptr);
+    }
+    void set(char const* name, char const* value, char const* comment) {
+        _set(name, typeid(std::string), nullptr, 0, value, comment);
+    }
+    void set(char const* name, std::string const& value) { set(name, value.c_str()); }
+    void set(char const* name, std::string const& value, char const* comment) {
+        set(name, value.c_str(), comment);
+    }
+    void set(char const* name, DateTime const& value) {
+        long long const nsecs = value.nsecs(DateTime::TAI);
+        _set(name, typeid(DateTime), &nsecs, sizeof(nsecs), nullptr, nullptr);
+    }
+    void set(char const* name, DateTime const& value, char const* comment) {
+        long long const nsecs = value.nsecs(DateTime::TAI);
+        _set(name, typeid(DateTime), &nsecs, sizeof(nsecs), nullptr, comment);
+    }
+    //@}
+
+    /**
+     * Set the comment of an existing property.
+     *
+     * @throws NotFoundError Property does not exist.
+     * @throws LengthError The arena cannot hold the comment.
+     */
+    void setComment(char const* name, char const* comment);
+
+    /**
+     * Describe the contents as a sequence of events sent to a
+     * PropertyHandler, in order and with comments, as PropertyList::walk does.
+     * This creates a std::string for each name.
+     */
+    void walk(PropertyHandler& handler) const;
+
+    /// Return a PropertyList with the same contents.
+    std::shared_ptr<PropertyList> toPropertyList() const;
+
+protected:
+    // One property; strings are offsets into the arena
+    struct Entry {
+        std::type_info const* type;
+        std::uint32_t hash;
+        std::uint32_t name;
+        std::uint32_t nameLength;
+        std::uint32_t string;  // string value, if any
+        std::uint32_t stringLength;
+        std::uint32_t stringCapacity;
+        std::uint32_t comment;
+        std::uint32_t commentLength;
+        std::uint32_t commentCapacity;
+        unsigned char value[8];  // arithmetic value, or TAI nanoseconds of a DateTime
+    };
+
+    StaticPropertyListBase(Entry* entries, std::size_t maxKeys, char* arena, std::size_t maxBytes) noexcept
+            : _entries(entries), _maxKeys(maxKeys), _arena(arena), _maxBytes(maxBytes), _size(0), _used(0) {}
+
+    ~StaticPropertyListBase() = default;
+
+private:
+    Entry const* _find(char const* name) const noexcept;
+    Entry const& _at(char const* name) const;
+    void _get(char const* name, std::type_info const& type, void* value, std::size_t size) const;
+    void _set(char const* name, std::type_info const& type, void const* value, std::size_t size,
+              char const* string, char const* comment);
+    std::uint32_t _store(char const* s, std::size_t length) noexcept;
+
+    Entry* const _entries;
+    std::size_t const _maxKeys;
+    char* const _arena;
+    std::size_t const _maxBytes;
+    std::size_t _size;  // number of entries in use
+    std::size_t _used;  // number of arena bytes in use
+};
+
+template <>
+LSST_EXPORT std::string StaticPropertyListBase::get<std::string>(char const* name) const;
+
+template <>
+LSST_EXPORT DateTime StaticPropertyListBase::get<DateTime>(char const* name) const;
+
+template <std::size_t NKeys, std::size_t NBytes>
+class StaticPropertyList : public StaticPropertyListBase {
+public:
+    static_assert(NKeys > 0 && NBytes > 0 && NBytes < (std::size_t(1) << 32), "Unsupported capacity");
+
+    StaticPropertyList() noexcept : StaticPropertyListBase(_entryStorage, NKeys, _arenaStorage, NBytes) {}
+
+private:
+    Entry _entryStorage[NKeys];
+    char _arenaStorage[NBytes];
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
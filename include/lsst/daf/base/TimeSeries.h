@@ -0,0 +1,182 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_TIMESERIES
+#define LSST_DAF_BASE_TIMESERIES
+
+/** @class lsst::daf::base::TimeSeries
+ * @brief Time-sorted column of floating point samples, such as telemetry.
+ *
+ * Samples are pairs of a time, stored as TAI nanoseconds, and a double
+ * value.  They are kept sorted by time in two contiguous arrays, so that
+ * valueAt and range take O(log n).  Appending in time order takes
+ * amortized constant time; an out-of-order sample is inserted in place.
+ *
+ * A TimeSeries constructed with a nonzero capacity retains only the most
+ * recent `capacity` samples, discarding the oldest as new ones arrive.
+ *
+ * The arrays returned by getTimes and getValues share the storage of the
+ * series and keep it alive.  Storage that is shared, with such an array or
+ * with a copy or range of the series, is never modified: when a change
+ * would overwrite shared samples, the series moves to new storage first.
+ * Copies and ranges are therefore cheap, and the arrays are immutable
+ * snapshots that can be exposed to numpy without copying.
+ *
+ * A TimeSeries is usually stored in a PropertySet as a Persistable::Ptr by
+ * PropertySet::set(name, value, time), and retrieved with
+ * PropertySet::getTimeSeries.  Like PropertySet, it is not thread-safe.
+ *
+ * @ingroup daf_base
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "lsst/base.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/Persistable.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT TimeSeries : public Persistable {
+public:
+    typedef std::shared_ptr<TimeSeries> Ptr;
+    typedef std::shared_ptr<TimeSeries const> ConstPtr;
+
+    /// How downsample combines the samples within an interval.
+    enum Aggregation { FIRST, LAST, MEAN, MIN, MAX };
+
+    /**
+     * Construct an empty series.
+     *
+     * @param[in] capacity Maximum number of samples retained; 0 for no limit.
+     */
+    explicit TimeSeries(std::size_t capacity = 0);
+
+    ~TimeSeries() noexcept override;
+
+    /// Copy a series; the copy shares storage with the original until either is modified.
+    TimeSeries(TimeSeries const&);
+    TimeSeries(TimeSeries&&);
+    TimeSeries& operator=(TimeSeries const&);
+    TimeSeries& operator=(TimeSeries&&);
+
+    /// Return the number of samples.
+    std::size_t size() const noexcept { return _size; }
+
+    /// Return true if there are no samples.
+    bool empty() const noexcept { return _size == 0; }
+
+    /// Return the maximum number of samples retained, or 0 if there is no limit.
+    std::size_t getCapacity() const noexcept { return _capacity; }
+
+    /**
+     * Add a sample.
+     *
+     * Samples with equal times are kept in the order they were added.  If
+     * the series is at capacity the oldest sample is discarded, unless the
+     * new one would be older still, in which case it is ignored.
+     *
+     * @param[in] time Time of the sample.
+     * @param[in] value Value of the sample.
+     * @throws InvalidParameterError time is not valid.
+     */
+    void append(DateTime const& time, double value);
+
+    /**
+     * Return the time of a sample.
+     *
+     * @param[in] index Index of the sample, from 0 for the oldest.
+     * @throws OutOfRangeError index is not less than size().
+     */
+    DateTime getTime(std::size_t index) const;
+
+    /**
+     * Return the value of a sample.
+     *
+     * @param[in] index Index of the sample, from 0 for the oldest.
+     * @throws OutOfRangeError index is not less than size().
+     */
+    double getValue(std::size_t index) const;
+
+    /**
+     * Return the value in effect at a given time: that of the latest
+     * sample at or before it.
+     *
+     * @param[in] time Time of interest.
+     * @throws NotFoundError There is no sample at or before time.
+     */
+    double valueAt(DateTime const& time) const;
+
+    /**
+     * Return the samples with begin <= time < end, sharing storage with
+     * this series.  The result has no capacity limit.
+     */
+    Ptr range(DateTime const& begin, DateTime const& end) const;
+
+    /**
+     * Combine the samples within each of a sequence of equal intervals.
+     *
+     * Intervals are aligned to multiples of `interval` since the DateTime
+     * epoch.  Each interval that contains samples yields one sample, whose
+     * time is the start of the interval.  The result has no capacity limit.
+     *
+     * @param[in] interval Length of the intervals.
+     * @param[in] aggregation How to combine the samples within an interval.
+     * @throws InvalidParameterError interval is not positive.
+     */
+    Ptr downsample(std::chrono::nanoseconds interval, Aggregation aggregation = MEAN) const;
+
+    /**
+     * Return the times of all samples, oldest first, as TAI nanoseconds
+     * since the epoch.  The size() elements remain valid and unchanged for
+     * as long as the pointer is held; the pointer is null if the series is
+     * empty.
+     */
+    std::shared_ptr<long long const> getTimes() const;
+
+    /// Return the values of all samples, in the same way as getTimes.
+    std::shared_ptr<double const> getValues() const;
+
+private:
+    struct Buffer;
+
+    // Ensure that there is room for n more samples at the end of the series, that the existing
+    // samples may be modified if `modify` is true, and that appended samples overwrite nothing shared.
+    void _reserve(std::size_t n, bool modify);
+
+    std::size_t _capacity;
+    std::shared_ptr<Buffer> _buffer;  // storage, possibly shared
+    std::size_t _begin;               // index in _buffer of the oldest sample
+    std::size_t _size;                // number of samples
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
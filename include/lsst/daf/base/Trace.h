@@ -0,0 +1,184 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_TRACE
+#define LSST_DAF_BASE_TRACE
+
+/** @class lsst::daf::base::Trace
+ * @brief Optional recording of timed spans, exported as Chrome trace events.
+ *
+ * Major operations of PropertySet, PropertyList, DateTime and HeaderCache
+ * are enclosed in a TraceSpan.  While tracing is disabled, which is the
+ * default, a span costs one relaxed atomic load; while it is enabled, each
+ * completed span is appended to a lock-free buffer owned by the thread
+ * that ran it.  flush drains all buffers into a JSON file in the trace
+ * event format read by chrome://tracing and Perfetto:
+ *
+ * @code
+ * Trace::enable();
+ * ... // run the code of interest
+ * Trace::flush("trace.json");
+ * @endcode
+ *
+ * To reduce the overhead and the size of the trace, enable can record only
+ * one in every `sampleInterval` outermost spans of each thread (with the
+ * spans nested within them), and discard spans shorter than a minimum
+ * duration.  Spans are dropped, and counted by getDropped, if a thread
+ * records more than BUFFER_SIZE spans between flushes.
+ *
+ * Defining LSST_DAF_BASE_NO_TRACE when compiling removes the spans
+ * entirely.
+ *
+ * @ingroup daf_base
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string>
+
+#include "lsst/base.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+class LSST_EXPORT Trace {
+public:
+    /// Maximum number of spans held for each thread between flushes.
+    static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+    Trace() = delete;
+
+    /**
+     * Start recording spans.
+     *
+     * @param[in] sampleInterval Record one in every sampleInterval outermost spans of each thread.
+     * @param[in] minDuration Discard spans shorter than this.
+     * @throws InvalidParameterError sampleInterval is zero.
+     */
+    static void enable(unsigned sampleInterval = 1,
+                       std::chrono::nanoseconds minDuration = std::chrono::nanoseconds(0));
+
+    /// Stop recording spans; those already recorded are kept until flushed.
+    static void disable() noexcept;
+
+    /// Return true if spans are being recorded.
+    static bool isEnabled() noexcept { return _enabled.load(std::memory_order_relaxed); }
+
+    /**
+     * Write the spans recorded so far as a JSON trace, and discard them.
+     *
+     * @param[in] os Stream to write to.
+     * @return Number of spans written.
+     */
+    static std::size_t flush(std::ostream& os);
+
+    /**
+     * Write the spans recorded so far to a JSON trace file, and discard them.
+     *
+     * @param[in] path File to (over)write.
+     * @return Number of spans written.
+     * @throws IoError The file could not be written.
+     */
+    static std::size_t flush(std::string const& path);
+
+    /// Discard the spans recorded so far, and reset the count of dropped spans.
+    static void clear() noexcept;
+
+    /// Return the number of spans dropped because a buffer was full.
+    static std::uint64_t getDropped() noexcept;
+
+    /**
+     * Return a copy of a string that lives as long as the process, for use
+     * as the name of a span that is not a string literal.  Equal strings
+     * share a copy.
+     */
+    static char const* intern(std::string const& name);
+
+private:
+    friend class TraceSpan;
+
+    static std::atomic<bool> _enabled;
+};
+
+/**
+ * Scoped timer recording a span from its construction to its destruction
+ * while tracing is enabled.
+ *
+ * The name and category are not copied: they must be string literals or
+ * otherwise outlive the next flush (see Trace::intern).
+ */
+class LSST_EXPORT TraceSpan {
+public:
+    explicit TraceSpan(char const* name, char const* category = "daf_base") noexcept
+            : _name(name), _category(category), _start(INACTIVE) {
+        if (Trace::isEnabled()) {
+            _begin();
+        }
+    }
+
+    ~TraceSpan() noexcept {
+        if (_start != INACTIVE) {
+            _end();
+        }
+    }
+
+    TraceSpan(TraceSpan const&) = delete;
+    TraceSpan& operator=(TraceSpan const&) = delete;
+
+private:
+    // Values of _start for a span that is not timed, because tracing was disabled or it was not sampled
+    static constexpr std::int64_t INACTIVE = std::numeric_limits<std::int64_t>::min();
+    static constexpr std::int64_t SKIPPED = INACTIVE + 1;
+
+    void _begin() noexcept;
+    void _end() noexcept;
+
+    char const* _name;
+    char const* _category;
+    std::int64_t _start;  // nanoseconds since the trace epoch
+};
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#define LSST_DAF_BASE_TRACE_CONCAT2(a, b) a##b
+#define LSST_DAF_BASE_TRACE_CONCAT(a, b) LSST_DAF_BASE_TRACE_CONCAT2(a, b)
+
+/**
+ * Record the rest of the enclosing scope as a span with the given name.
+ */
+#ifdef LSST_DAF_BASE_NO_TRACE
+#define LSST_DAF_BASE_TRACE_SPAN(name)
+#else
+#define LSST_DAF_BASE_TRACE_SPAN(name) \
+    ::lsst::daf::base::TraceSpan const LSST_DAF_BASE_TRACE_CONCAT(lsstDafBaseTraceSpan, __LINE__)(name)
+#endif
+
+#endif
@@ -0,0 +1,259 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_DETAIL_SMALLMAP
+#define LSST_DAF_BASE_DETAIL_SMALLMAP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace lsst {
+namespace daf {
+namespace base {
+namespace detail {
+
+/**
+ * Map from strings to values that adapts its representation to its size.
+ *
+ * Entries are kept contiguously in a single vector.  Up to `MaxLinear`
+ * entries are found by linear search, which for a few short keys is faster
+ * than hashing and needs no memory beyond the entries themselves.  Larger
+ * maps add an open-addressed hash index of 32-bit entry positions, which is
+ * dropped again if the map shrinks to half of `MaxLinear`.
+ *
+ * The interface is the subset of std::unordered_map used by PropertySet,
+ * with two differences: insertion invalidates references as well as
+ * iterators, and erasure moves the last entry into the erased position, so
+ * it also changes the order of iteration.  `erase(iterator)` returns an
+ * iterator to the entry that took the place of the erased one, so
+ * `for (i = begin(); i != end();) i = pred(*i) ? erase(i) : i + 1;` visits
+ * every entry once.
+ */
+template <typename T, std::size_t MaxLinear = 8>
+class SmallMap {
+public:
+    typedef std::pair<std::string, T> value_type;
+    typedef value_type* iterator;
+    typedef value_type const* const_iterator;
+
+    SmallMap() = default;
+
+    SmallMap(SmallMap const& other)
+            : _entries(other._entries), _index(other._index ? new Index(*other._index) : nullptr) {}
+
+    SmallMap(SmallMap&&) = default;
+
+    SmallMap& operator=(SmallMap const& other) {
+        if (this != &other) {
+            _entries = other._entries;
+            _index.reset(other._index ? new Index(*other._index) : nullptr);
+        }
+        return *this;
+    }
+
+    SmallMap& operator=(SmallMap&&) = default;
+
+    iterator begin() noexcept { return _entries.data(); }
+    iterator end() noexcept { return _entries.data() + _entries.size(); }
+    const_iterator begin() const noexcept { return _entries.data(); }
+    const_iterator end() const noexcept { return _entries.data() + _entries.size(); }
+
+    std::size_t size() const noexcept { return _entries.size(); }
+    bool empty() const noexcept { return _entries.empty(); }
+
+    /// Whether the hash index is in use.
+    bool isIndexed() const noexcept { return static_cast<bool>(_index); }
+
+    void clear() noexcept {
+        _entries.clear();
+        _index.reset();
+    }
+
+    void reserve(std::size_t n) {
+        _entries.reserve(n);
+        if (n > MaxLinear && (!_index || _index->slots.size() < 2 * n)) {
+            _buildIndex(n);
+        }
+    }
+
+    iterator find(std::string const& key) { return begin() + _position(key); }
+    const_iterator find(std::string const& key) const { return begin() + _position(key); }
+
+    std::size_t count(std::string const& key) const { return _position(key) < size() ? 1 : 0; }
+
+    T& operator[](std::string const& key) {
+        std::size_t const pos = _position(key);
+        if (pos < size()) {
+            return _entries[pos].second;
+        }
+        _entries.emplace_back(key, T());
+        if (_index) {
+            _index->hashes.push_back(std::hash<std::string>()(key));
+            if (2 * size() > _index->slots.size()) {
+                _rehash(2 * _index->slots.size());
+            } else {
+                _place(size() - 1);
+            }
+        } else if (size() > MaxLinear) {
+            _buildIndex(size());
+        }
+        return _entries.back().second;
+    }
+
+    iterator erase(const_iterator i) {
+        std::size_t const pos = i - begin();
+        _erase(pos);
+        return begin() + pos;
+    }
+
+    std::size_t erase(std::string const& key) {
+        std::size_t const pos = _position(key);
+        if (pos >= size()) {
+            return 0;
+        }
+        _erase(pos);
+        return 1;
+    }
+
+private:
+    static std::uint32_t const EMPTY = 0xffffffffU;
+
+    struct Index {
+        std::vector<std::size_t> hashes;   // of the key of each entry
+        std::vector<std::uint32_t> slots;  // entry positions, or EMPTY; size is a power of 2
+    };
+
+    // Position of the entry with a key, or size() if there is none
+    std::size_t _position(std::string const& key) const {
+        if (!_index) {
+            for (std::size_t pos = 0; pos < _entries.size(); ++pos) {
+                if (_entries[pos].first == key) {
+                    return pos;
+                }
+            }
+            return size();
+        }
+        std::size_t const hash = std::hash<std::string>()(key);
+        std::size_t const mask = _index->slots.size() - 1;
+        for (std::size_t s = hash & mask;; s = (s + 1) & mask) {
+            std::uint32_t const pos = _index->slots[s];
+            if (pos == EMPTY) {
+                return size();
+            }
+            if (_index->hashes[pos] == hash && _entries[pos].first == key) {
+                return pos;
+            }
+        }
+    }
+
+    // Slot holding an entry position, which must be in the index
+    std::size_t _slot(std::size_t pos) const {
+        std::size_t const mask = _index->slots.size() - 1;
+        std::size_t s = _index->hashes[pos] & mask;
+        while (_index->slots[s] != pos) {
+            s = (s + 1) & mask;
+        }
+        return s;
+    }
+
+    // Put an entry position in the first free slot of its probe sequence
+    void _place(std::size_t pos) {
+        std::size_t const mask = _index->slots.size() - 1;
+        std::size_t s = _index->hashes[pos] & mask;
+        while (_index->slots[s] != EMPTY) {
+            s = (s + 1) & mask;
+        }
+        _index->slots[s] = static_cast<std::uint32_t>(pos);
+    }
+
+    void _rehash(std::size_t nSlots) {
+        _index->slots.assign(nSlots, EMPTY);
+        for (std::size_t pos = 0; pos < size(); ++pos) {
+            _place(pos);
+        }
+    }
+
+    // Index the entries, with room for n entries before the next rehash
+    void _buildIndex(std::size_t n) {
+        if (!_index) {
+            _index.reset(new Index);
+            _index->hashes.reserve(n);
+            for (auto const& entry : _entries) {
+                _index->hashes.push_back(std::hash<std::string>()(entry.first));
+            }
+        }
+        std::size_t nSlots = 16;
+        while (nSlots < 2 * n) {
+            nSlots *= 2;
+        }
+        _rehash(nSlots);
+    }
+
+    void _erase(std::size_t pos) {
+        std::size_t const last = size() - 1;
+        if (_index) {
+            // Backward-shift deletion keeps every probe sequence unbroken
+            std::size_t const mask = _index->slots.size() - 1;
+            std::size_t hole = _slot(pos);
+            for (std::size_t s = (hole + 1) & mask; _index->slots[s] != EMPTY; s = (s + 1) & mask) {
+                std::size_t const home = _index->hashes[_index->slots[s]] & mask;
+                if (((s - home) & mask) >= ((s - hole) & mask)) {
+                    _index->slots[hole] = _index->slots[s];
+                    hole = s;
+                }
+            }
+            _index->slots[hole] = EMPTY;
+            if (pos != last) {
+                _index->slots[_slot(last)] = static_cast<std::uint32_t>(pos);
+                _index->hashes[pos] = _index->hashes[last];
+            }
+            _index->hashes.pop_back();
+        }
+        if (pos != last) {
+            _entries[pos] = std::move(_entries[last]);
+        }
+        _entries.pop_back();
+        if (_index && size() <= MaxLinear / 2) {
+            _index.reset();
+        }
+    }
+
+    std::vector<value_type> _entries;
+    std::unique_ptr<Index> _index;  // null while the map is small
+};
+
+template <typename T, std::size_t MaxLinear>
+std::uint32_t const SmallMap<T, MaxLinear>::EMPTY;
+
+}  // namespace detail
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -0,0 +1,91 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_DAF_BASE_DETAIL_PARALLELFOR
+#define LSST_DAF_BASE_DETAIL_PARALLELFOR
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace lsst {
+namespace daf {
+namespace base {
+namespace detail {
+
+/**
+ * Call `func(begin, end)` on contiguous ranges that together cover [0, n),
+ * using up to nThreads threads.
+ *
+ * @param[in] n Number of items.
+ * @param[in] nThreads Maximum number of threads; 0 for the number of hardware threads.
+ * @param[in] minPerThread Smallest number of items worth giving a thread of its own.
+ * @param[in] func Function processing a range of items; must be safe to call concurrently.
+ *
+ * The calling thread processes the first range.  If any call throws, the
+ * first exception is rethrown once all threads have finished.
+ */
+template <typename F>
+void parallelFor(std::size_t n, int nThreads, std::size_t minPerThread, F const& func) {
+    if (nThreads <= 0) {
+        nThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    std::size_t const maxThreads = std::max<std::size_t>(1, n / std::max<std::size_t>(1, minPerThread));
+    std::size_t const nChunks = std::min(static_cast<std::size_t>(nThreads), maxThreads);
+    if (nChunks <= 1) {
+        func(std::size_t(0), n);
+        return;
+    }
+    std::vector<std::exception_ptr> errors(nChunks);
+    std::vector<std::thread> threads;
+    threads.reserve(nChunks - 1);
+    auto run = [&](std::size_t chunk) {
+        try {
+            func(chunk * n / nChunks, (chunk + 1) * n / nChunks);
+        } catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    for (std::size_t chunk = 1; chunk < nChunks; ++chunk) {
+        threads.emplace_back(run, chunk);
+    }
+    run(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace detail
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
+
+#endif
@@ -22,6 +22,7 @@
 #
 
 from .version import *
+from .trace import *
 from .dateTime import *
 from .propertyContainer import *
 from . import yaml
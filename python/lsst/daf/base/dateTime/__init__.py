@@ -23,3 +23,4 @@
 
 from .dateTime import *
 from .dateTimeContinued import *
+from .asOfJoin import *
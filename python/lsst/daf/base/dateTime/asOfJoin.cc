@@ -0,0 +1,59 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/chrono.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <vector>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/AsOfJoin.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PYBIND11_MODULE(asOfJoin, mod) {
+    py::module::import("lsst.daf.base.dateTime.dateTime");
+
+    py::class_<AsOfJoin> cls(mod, "AsOfJoin");
+
+    py::enum_<AsOfJoin::Direction>(cls, "Direction")
+            .value("BACKWARD", AsOfJoin::Direction::BACKWARD)
+            .value("FORWARD", AsOfJoin::Direction::FORWARD)
+            .value("NEAREST", AsOfJoin::Direction::NEAREST)
+            .export_values();
+
+    cls.def(py::init<AsOfJoin::Direction, std::chrono::nanoseconds, bool>(),
+            "direction"_a = AsOfJoin::BACKWARD, "tolerance"_a = std::chrono::nanoseconds::max(),
+            "allowExactMatches"_a = true);
+    cls.def_property_readonly_static("NO_MATCH", [](py::object) { return AsOfJoin::NO_MATCH; });
+
+    cls.def("getDirection", &AsOfJoin::getDirection);
+    cls.def("getTolerance", &AsOfJoin::getTolerance);
+    cls.def("getAllowExactMatches", &AsOfJoin::getAllowExactMatches);
+    // Strided inputs, such as a slice or a column, are copied to contiguous arrays for the kernel
+    typedef py::array_t<long long, py::array::c_style | py::array::forcecast> Times;
+    cls.def("__call__", [](AsOfJoin const& self, Times const& left, Times const& right, int nThreads) {
+        if (left.ndim() != 1 || right.ndim() != 1) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError, "left and right must be 1-d arrays");
+        }
+        std::size_t const nLeft = left.shape(0);
+        py::array_t<long long> indices(nLeft);
+        long long* out = indices.mutable_data();
+        {
+            py::gil_scoped_release release;
+            self(left.data(), nLeft, right.data(), right.shape(0), out, nThreads);
+        }
+        return indices;
+    }, "left"_a, "right"_a, "nThreads"_a = 0);
+    cls.def("__call__", py::overload_cast<std::vector<DateTime> const&, std::vector<DateTime> const&, int>(
+                                &AsOfJoin::operator(), py::const_),
+            "left"_a, "right"_a, "nThreads"_a = 0);
+}
+
+}  // base
+}  // daf
+}  // lsst
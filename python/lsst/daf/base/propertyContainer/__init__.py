@@ -21,6 +21,11 @@
 # see <http://www.lsstcorp.org/LegalNotices/>.
 #
 
+from .timeSeries import *
 from .propertySet import *
 from .propertyList import *
+from .propertyTemplate import *
+from .propertyPredicate import *
+from .messagePack import *
+from .minHash import *
 from .propertyContainerContinued import *
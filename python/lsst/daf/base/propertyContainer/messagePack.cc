@@ -0,0 +1,42 @@
+#include "pybind11/pybind11.h"
+
+#include <memory>
+#include <string>
+
+#include "lsst/daf/base/MessagePack.h"
+#include "lsst/daf/base/PropertySet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PYBIND11_MODULE(messagePack, mod) {
+    py::module::import("lsst.daf.base.propertyContainer.propertyList");
+
+    mod.attr("DATETIME_EXT_TYPE") = MessagePackWriter::DATETIME_EXT_TYPE;
+    mod.def("encodeMessagePack", [](PropertySet const& container) {
+        std::string out;
+        {
+            // Other Python threads may be modifying the container, unless it is concurrent
+            std::unique_ptr<py::gil_scoped_release> release(
+                    container.isConcurrent() ? new py::gil_scoped_release : nullptr);
+            MessagePackWriter::encode(container, out);
+        }
+        return py::bytes(out);
+    }, "container"_a);
+    mod.def("decodeMessagePack", [](py::buffer data) {
+        py::buffer_info const info = data.request();
+        if (info.ndim != 1 || info.itemsize != 1) {
+            throw py::type_error("MessagePack data must be a one-dimensional buffer of bytes");
+        }
+        py::gil_scoped_release release;
+        return MessagePackReader::decode(static_cast<char const*>(info.ptr), info.size);
+    }, "data"_a);
+}
+
+}  // base
+}  // daf
+}  // lsst
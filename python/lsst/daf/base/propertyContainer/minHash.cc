@@ -0,0 +1,72 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/MinHash.h"
+#include "lsst/daf/base/MinHashIndex.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PYBIND11_MODULE(minHash, mod) {
+    py::module::import("lsst.daf.base.propertyContainer.propertySet");
+
+    py::class_<MinHash, std::shared_ptr<MinHash>> clsMinHash(mod, "MinHash");
+    clsMinHash.def(py::init<int, std::vector<std::string> const&, int, std::uint64_t>(), "nHashes"_a = 128,
+                   "ignore"_a = std::vector<std::string>(), "precision"_a = 6, "seed"_a = 0);
+    clsMinHash.def("getNumHashes", &MinHash::getNumHashes);
+    clsMinHash.def("getIgnored", &MinHash::getIgnored);
+    clsMinHash.def("getPrecision", &MinHash::getPrecision);
+    clsMinHash.def("getSeed", &MinHash::getSeed);
+    clsMinHash.def("__call__", [](MinHash const& self, PropertySet const& properties) {
+        return self(properties);
+    }, "properties"_a);
+    clsMinHash.def("__call__", [](MinHash const& self,
+                                  std::vector<std::shared_ptr<PropertySet>> const& properties, int nThreads) {
+        std::vector<PropertySet::ConstPtr> const headers(properties.begin(), properties.end());
+        // Other Python threads may be modifying the headers, unless they are concurrent
+        bool const concurrent =
+                std::all_of(headers.begin(), headers.end(),
+                            [](PropertySet::ConstPtr const& p) { return p && p->isConcurrent(); });
+        std::unique_ptr<py::gil_scoped_release> release(concurrent ? new py::gil_scoped_release : nullptr);
+        return self(headers, nThreads);
+    }, "properties"_a, "nThreads"_a = 0);
+    clsMinHash.def_static("similarity", &MinHash::similarity, "a"_a, "b"_a);
+
+    // The GIL stays held: queries may not run while another Python thread modifies the index.  The
+    // worker threads of the batch functions do not need it.
+    py::class_<MinHashIndex, std::shared_ptr<MinHashIndex>> clsIndex(mod, "MinHashIndex");
+    clsIndex.def(py::init<int, int>(), "nBands"_a = 32, "rowsPerBand"_a = 4);
+    clsIndex.def("getNumBands", &MinHashIndex::getNumBands);
+    clsIndex.def("getRowsPerBand", &MinHashIndex::getRowsPerBand);
+    clsIndex.def("getThreshold", &MinHashIndex::getThreshold);
+    clsIndex.def("__len__", &MinHashIndex::size);
+    clsIndex.def("clear", &MinHashIndex::clear);
+    clsIndex.def("insert", py::overload_cast<MinHash::Signature const&>(&MinHashIndex::insert),
+                 "signature"_a);
+    clsIndex.def("insert",
+                 py::overload_cast<std::vector<MinHash::Signature> const&, int>(&MinHashIndex::insert),
+                 "signatures"_a, "nThreads"_a = 0);
+    clsIndex.def("getSignature", &MinHashIndex::getSignature, "id"_a);
+    clsIndex.def("query",
+                 py::overload_cast<MinHash::Signature const&, double>(&MinHashIndex::query, py::const_),
+                 "signature"_a, "threshold"_a = 0.0);
+    clsIndex.def("query",
+                 py::overload_cast<std::vector<MinHash::Signature> const&, double, int>(&MinHashIndex::query,
+                                                                                        py::const_),
+                 "signatures"_a, "threshold"_a = 0.0, "nThreads"_a = 0);
+    clsIndex.def("cluster", &MinHashIndex::cluster, "threshold"_a);
+}
+
+}  // base
+}  // daf
+}  // lsst
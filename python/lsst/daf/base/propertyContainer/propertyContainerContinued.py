@@ -35,6 +35,7 @@ from lsst.utils import continueClass
 from .propertySet import PropertySet
 from .propertyList import PropertyList
 from ..dateTime import DateTime
+from ..trace import TraceSpan
 
 
 def getPropertySetState(container, asLists=False):
@@ -65,11 +66,12 @@ def getPropertySetState(container, asLists=False):
             the data for the item, in a form compatible
             with the set method named by ``elementTypeName``
     """
-    names = container.names(topLevelOnly=True)
-    sequence = list if asLists else tuple
-    return [sequence((name, _propertyContainerElementTypeName(container, name),
-            _propertyContainerGet(container, name, returnStyle=ReturnStyle.AUTO)))
-            for name in names]
+    with TraceSpan("getPropertySetState"):
+        names = container.names(topLevelOnly=True)
+        sequence = list if asLists else tuple
+        return [sequence((name, _propertyContainerElementTypeName(container, name),
+                _propertyContainerGet(container, name, returnStyle=ReturnStyle.AUTO)))
+                for name in names]
 
 
 def getPropertyListState(container, asLists=False):
@@ -102,11 +104,12 @@ def getPropertyListState(container, asLists=False):
         comment (a `str`): the comment. This item is only present
             if ``container`` is a PropertyList.
     """
-    sequence = list if asLists else tuple
-    return [sequence((name, _propertyContainerElementTypeName(container, name),
-            _propertyContainerGet(container, name, returnStyle=ReturnStyle.AUTO),
-            container.getComment(name)))
-            for name in container.getOrderedNames()]
+    with TraceSpan("getPropertyListState"):
+        sequence = list if asLists else tuple
+        return [sequence((name, _propertyContainerElementTypeName(container, name),
+                _propertyContainerGet(container, name, returnStyle=ReturnStyle.AUTO),
+                container.getComment(name)))
+                for name in container.getOrderedNames()]
 
 
 def setPropertySetState(container, state):
@@ -120,11 +123,12 @@ def setPropertySetState(container, state):
     state : `list`
         The state, as returned by `getPropertySetState`
     """
-    for name, elemType, value in state:
-        if elemType is not None:
-            getattr(container, "set" + elemType)(name, value)
-        else:
-            raise ValueError(f"Unrecognized values for state restoration: ({name}, {elemType}, {value})")
+    with TraceSpan("setPropertySetState"):
+        for name, elemType, value in state:
+            if elemType is not None:
+                getattr(container, "set" + elemType)(name, value)
+            else:
+                raise ValueError(f"Unrecognized values for state restoration: ({name}, {elemType}, {value})")
 
 
 def setPropertyListState(container, state):
@@ -138,8 +142,9 @@ def setPropertyListState(container, state):
     state : `list`
         The state, as returned by ``getPropertyListState``
     """
-    for name, elemType, value, comment in state:
-        getattr(container, "set" + elemType)(name, value, comment)
+    with TraceSpan("setPropertyListState"):
+        for name, elemType, value, comment in state:
+            getattr(container, "set" + elemType)(name, value, comment)
 
 
 class ReturnStyle(enum.Enum):
@@ -622,6 +627,30 @@ class PropertySet:
         else:
             raise KeyError(f"{name} not present in dict")
 
+    def removeIf(self, predicate):
+        """Remove every top-level property for which a predicate is true.
+
+        Parameters
+        ----------
+        predicate : callable
+            Called as ``predicate(name, value)`` for each top-level name,
+            with the value as returned by `get`; returns `True` if the
+            property should be removed.
+
+        Returns
+        -------
+        count : `int`
+            Number of properties removed.
+
+        Notes
+        -----
+        The properties are removed with a single call to ``remove`` once
+        every predicate has been evaluated, so a `PropertyList` compacts
+        its card order only once.
+        """
+        names = [name for name in self.names(topLevelOnly=True) if predicate(name, self.get(name))]
+        return self.remove(names)
+
     def __str__(self):
         return self.toString()
 
@@ -0,0 +1,47 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyPredicate.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PYBIND11_MODULE(propertyPredicate, mod) {
+    py::module::import("lsst.daf.base.propertyContainer.propertySet");
+
+    py::class_<PropertyPredicate, std::shared_ptr<PropertyPredicate>> cls(mod, "PropertyPredicate");
+
+    cls.def(py::init<std::string const&>(), "expression"_a);
+
+    cls.def("getExpression", &PropertyPredicate::getExpression);
+    cls.def("getNames", &PropertyPredicate::getNames);
+    cls.def("__call__", [](PropertyPredicate const& self, PropertySet const& properties) {
+        return self(properties);
+    }, "properties"_a);
+    cls.def("__call__", [](PropertyPredicate const& self,
+                           std::vector<std::shared_ptr<PropertySet>> const& properties, int nThreads) {
+        std::vector<PropertySet::ConstPtr> const headers(properties.begin(), properties.end());
+        // Other Python threads may be modifying the headers, unless they are concurrent
+        bool const concurrent =
+                std::all_of(headers.begin(), headers.end(),
+                            [](PropertySet::ConstPtr const& p) { return p && p->isConcurrent(); });
+        std::unique_ptr<py::gil_scoped_release> release(concurrent ? new py::gil_scoped_release : nullptr);
+        return self(headers, nThreads);
+    }, "properties"_a, "nThreads"_a = 0);
+    cls.def("__repr__", [](PropertyPredicate const& self) {
+        return "PropertyPredicate(" + py::repr(py::str(self.getExpression())).cast<std::string>() + ")";
+    });
+}
+
+}  // base
+}  // daf
+}  // lsst
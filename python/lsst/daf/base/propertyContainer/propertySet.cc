@@ -6,6 +6,7 @@
 
 #include "lsst/daf/base/PropertySet.h"
 #include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/TimeSeries.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -48,6 +49,7 @@ void declareAccessors(C& cls, std::string const& name) {
 
 PYBIND11_MODULE(propertySet, mod) {
     py::module::import("lsst.daf.base.persistable");
+    py::module::import("lsst.daf.base.propertyContainer.timeSeries");
 
     py::class_<std::type_info>(mod, "TypeInfo")
             .def("__eq__",
@@ -79,7 +81,14 @@ PYBIND11_MODULE(propertySet, mod) {
     cls.def("toString", &PropertySet::toString, "topLevelOnly"_a = false, "indent"_a = "");
     cls.def("copy", &PropertySet::copy, "dest"_a, "source"_a, "name"_a, "asScalar"_a=false);
     cls.def("combine", &PropertySet::combine);
-    cls.def("remove", &PropertySet::remove);
+    cls.def("remove", py::overload_cast<std::string const&>(&PropertySet::remove), "name"_a);
+    cls.def("remove", py::overload_cast<std::vector<std::string> const&>(&PropertySet::remove), "names"_a);
+    cls.def("makeConcurrent", &PropertySet::makeConcurrent);
+    cls.def("isConcurrent", &PropertySet::isConcurrent);
+    cls.def("savepoint", &PropertySet::savepoint);
+    cls.def("rollback", &PropertySet::rollback);
+    cls.def("release", &PropertySet::release);
+    cls.def("hasSavepoint", &PropertySet::hasSavepoint);
     cls.def("getAsBool", &PropertySet::getAsBool);
     cls.def("getAsInt", &PropertySet::getAsInt);
     cls.def("getAsInt64", &PropertySet::getAsInt64);
@@ -88,6 +97,16 @@ PYBIND11_MODULE(propertySet, mod) {
     cls.def("getAsString", &PropertySet::getAsString);
     cls.def("getAsPropertySetPtr", &PropertySet::getAsPropertySetPtr);
     cls.def("getAsPersistablePtr", &PropertySet::getAsPersistablePtr);
+    cls.def("getAsDateTime", &PropertySet::getAsDateTime, "name"_a, "scale"_a);
+    cls.def("getTimeSeries", &PropertySet::getTimeSeries, "name"_a);
+    cls.def("setTimeSeries",
+            (void (PropertySet::*)(std::string const&, double, DateTime const&)) & PropertySet::set,
+            "name"_a, "value"_a, "time"_a);
+    cls.def("setTimeSeries",
+            [](PropertySet& self, std::string const& name, std::shared_ptr<TimeSeries> const& series) {
+                self.set(name, Persistable::Ptr(series));
+            },
+            "name"_a, "series"_a);
 
     declareAccessors<bool>(cls, "Bool");
     declareAccessors<short>(cls, "Short");
@@ -0,0 +1,47 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyTemplate.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PYBIND11_MODULE(propertyTemplate, mod) {
+    py::module::import("lsst.daf.base.propertyContainer.propertySet");
+
+    py::class_<PropertyTemplate, std::shared_ptr<PropertyTemplate>> cls(mod, "PropertyTemplate");
+
+    cls.def(py::init<std::string const&>(), "format"_a);
+
+    cls.def("getFormat", &PropertyTemplate::getFormat);
+    cls.def("getNames", &PropertyTemplate::getNames);
+    cls.def("render", [](PropertyTemplate const& self, PropertySet const& properties) {
+        return self.render(properties);
+    }, "properties"_a);
+    cls.def("render", [](PropertyTemplate const& self,
+                         std::vector<std::shared_ptr<PropertySet>> const& properties) {
+        std::vector<PropertySet::ConstPtr> const headers(properties.begin(), properties.end());
+        // Other Python threads may be modifying the headers, unless they are concurrent
+        bool const concurrent =
+                std::all_of(headers.begin(), headers.end(),
+                            [](PropertySet::ConstPtr const& p) { return p && p->isConcurrent(); });
+        std::unique_ptr<py::gil_scoped_release> release(concurrent ? new py::gil_scoped_release : nullptr);
+        return self.render(headers);
+    }, "properties"_a);
+    cls.def("__repr__", [](PropertyTemplate const& self) {
+        return "PropertyTemplate(" + py::repr(py::str(self.getFormat())).cast<std::string>() + ")";
+    });
+}
+
+}  // base
+}  // daf
+}  // lsst
@@ -0,0 +1,72 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/chrono.h"
+#include "pybind11/numpy.h"
+
+#include <memory>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/TimeSeries.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+namespace {
+
+// Read-only array viewing storage of a TimeSeries, which stays alive and unchanged while the array exists
+template <typename T>
+py::array_t<T> makeArray(std::shared_ptr<T const> const& data, std::size_t size) {
+    py::capsule owner(new std::shared_ptr<T const>(data),
+                      [](void* p) { delete static_cast<std::shared_ptr<T const>*>(p); });
+    py::array_t<T> array({size}, {sizeof(T)}, data.get(), owner);
+    array.attr("setflags")("write"_a = false);
+    return array;
+}
+
+}  // <anonymous>
+
+PYBIND11_MODULE(timeSeries, mod) {
+    py::module::import("lsst.daf.base.persistable");
+
+    py::class_<TimeSeries, std::shared_ptr<TimeSeries>, Persistable> cls(mod, "TimeSeries");
+
+    py::enum_<TimeSeries::Aggregation>(cls, "Aggregation")
+            .value("FIRST", TimeSeries::Aggregation::FIRST)
+            .value("LAST", TimeSeries::Aggregation::LAST)
+            .value("MEAN", TimeSeries::Aggregation::MEAN)
+            .value("MIN", TimeSeries::Aggregation::MIN)
+            .value("MAX", TimeSeries::Aggregation::MAX)
+            .export_values();
+
+    cls.def(py::init<std::size_t>(), "capacity"_a = 0);
+
+    cls.def("__len__", &TimeSeries::size);
+    cls.def("getCapacity", &TimeSeries::getCapacity);
+    cls.def("append", &TimeSeries::append, "time"_a, "value"_a);
+    cls.def("append", [](TimeSeries& self, py::array_t<long long, py::array::forcecast> const& times,
+                         py::array_t<double, py::array::forcecast> const& values) {
+        if (times.ndim() != 1 || values.ndim() != 1 || times.shape(0) != values.shape(0)) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              "times and values must be 1-d arrays of equal length");
+        }
+        auto const t = times.unchecked<1>();
+        auto const v = values.unchecked<1>();
+        // The GIL stays held: like any Python object, the series may be used by other Python threads
+        for (py::ssize_t i = 0; i < t.shape(0); ++i) {
+            self.append(DateTime(t(i), DateTime::TAI), v(i));
+        }
+    }, "times"_a, "values"_a);
+    cls.def("getTime", &TimeSeries::getTime, "index"_a);
+    cls.def("getValue", &TimeSeries::getValue, "index"_a);
+    cls.def("valueAt", &TimeSeries::valueAt, "time"_a);
+    cls.def("range", &TimeSeries::range, "begin"_a, "end"_a);
+    cls.def("downsample", &TimeSeries::downsample, "interval"_a, "aggregation"_a = TimeSeries::MEAN);
+    cls.def("getTimes", [](TimeSeries const& self) { return makeArray(self.getTimes(), self.size()); });
+    cls.def("getValues", [](TimeSeries const& self) { return makeArray(self.getValues(), self.size()); });
+}
+
+}  // base
+}  // daf
+}  // lsst
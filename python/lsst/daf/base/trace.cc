@@ -0,0 +1,62 @@
+#include "pybind11/pybind11.h"
+#include "pybind11/chrono.h"
+
+#include <memory>
+#include <string>
+
+#include "lsst/daf/base/Trace.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace daf {
+namespace base {
+namespace {
+
+// Context manager recording a TraceSpan; names are only interned if tracing is enabled
+class PythonTraceSpan {
+public:
+    PythonTraceSpan(std::string const& name, std::string const& category)
+            : _name(name), _category(category) {}
+
+    void enter() {
+        if (Trace::isEnabled()) {
+            _span.reset(new TraceSpan(Trace::intern(_name), Trace::intern(_category)));
+        }
+    }
+
+    void exit() { _span.reset(); }
+
+private:
+    std::string _name;
+    std::string _category;
+    std::unique_ptr<TraceSpan> _span;
+};
+
+}  // <anonymous>
+
+PYBIND11_MODULE(trace, mod) {
+    py::class_<Trace> cls(mod, "Trace");
+
+    cls.attr("BUFFER_SIZE") = Trace::BUFFER_SIZE;
+    cls.def_static("enable", &Trace::enable, "sampleInterval"_a = 1,
+                   "minDuration"_a = std::chrono::nanoseconds(0));
+    cls.def_static("disable", &Trace::disable);
+    cls.def_static("isEnabled", &Trace::isEnabled);
+    cls.def_static("flush", [](std::string const& path) { return Trace::flush(path); }, "path"_a);
+    cls.def_static("clear", &Trace::clear);
+    cls.def_static("getDropped", &Trace::getDropped);
+
+    py::class_<PythonTraceSpan> span(mod, "TraceSpan");
+    span.def(py::init<std::string const&, std::string const&>(), "name"_a, "category"_a = "python");
+    span.def("__enter__", [](PythonTraceSpan& self) {
+        self.enter();
+        return &self;
+    }, py::return_value_policy::reference);
+    span.def("__exit__", [](PythonTraceSpan& self, py::object, py::object, py::object) { self.exit(); });
+}
+
+}  // base
+}  // daf
+}  // lsst
@@ -0,0 +1,174 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/AsOfJoin.h"
+
+#include <algorithm>
+#include <mutex>
+#include <string>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/detail/parallelFor.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Fewest left times worth joining, or times worth checking, in a separate thread
+std::size_t const MIN_PER_THREAD = 1 << 16;
+
+// Throw if an array of times is not sorted
+void _checkSorted(long long const* times, std::size_t n, std::string const& which, int nThreads) {
+    std::vector<std::size_t> unsorted;
+    std::mutex mutex;
+    detail::parallelFor(n, nThreads, MIN_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = std::max<std::size_t>(begin, 1); i < end; ++i) {
+            if (times[i] < times[i - 1]) {
+                std::lock_guard<std::mutex> lock(mutex);
+                unsorted.push_back(i);
+                return;
+            }
+        }
+    });
+    if (!unsorted.empty()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          which + " times are not sorted at index " +
+                                  std::to_string(*std::min_element(unsorted.begin(), unsorted.end())));
+    }
+}
+
+/*
+ * Return the first index in [pos, n) whose time does not satisfy `before`,
+ * which must be true for a prefix of the times.  Searches exponentially
+ * from pos, so a short step costs a comparison or two and a long one
+ * O(log step).
+ */
+template <typename Before>
+std::size_t _gallop(long long const* times, std::size_t pos, std::size_t n, Before before) {
+    if (pos >= n || !before(times[pos])) {
+        return pos;
+    }
+    std::size_t lo = pos;  // last index known to satisfy `before`
+    std::size_t step = 1;
+    while (lo + step < n && before(times[lo + step])) {
+        lo += step;
+        step *= 2;
+    }
+    std::size_t const hi = std::min(lo + step, n);
+    return std::partition_point(times + lo + 1, times + hi, before) - times;
+}
+
+}  // namespace
+
+constexpr long long AsOfJoin::NO_MATCH;
+
+AsOfJoin::AsOfJoin(Direction direction, std::chrono::nanoseconds tolerance, bool allowExactMatches)
+        : _direction(direction), _tolerance(tolerance), _allowExactMatches(allowExactMatches) {
+    if (tolerance.count() < 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Tolerance must not be negative, not " + std::to_string(tolerance.count()) + " ns");
+    }
+}
+
+void AsOfJoin::operator()(long long const* left, std::size_t nLeft, long long const* right,
+                          std::size_t nRight, long long* indices, int nThreads) const {
+    _checkSorted(left, nLeft, "Left", nThreads);
+    _checkSorted(right, nRight, "Right", nThreads);
+    detail::parallelFor(nLeft, nThreads, MIN_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        _join(left, begin, end, right, nRight, indices);
+    });
+}
+
+std::vector<long long> AsOfJoin::operator()(std::vector<long long> const& left,
+                                            std::vector<long long> const& right, int nThreads) const {
+    std::vector<long long> indices(left.size());
+    (*this)(left.data(), left.size(), right.data(), right.size(), indices.data(), nThreads);
+    return indices;
+}
+
+std::vector<long long> AsOfJoin::operator()(std::vector<DateTime> const& left,
+                                            std::vector<DateTime> const& right, int nThreads) const {
+    auto nsecs = [](std::vector<DateTime> const& times) {
+        std::vector<long long> result;
+        result.reserve(times.size());
+        for (auto const& time : times) {
+            result.push_back(time.nsecs(DateTime::TAI));
+        }
+        return result;
+    };
+    return (*this)(nsecs(left), nsecs(right), nThreads);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+void AsOfJoin::_join(long long const* left, std::size_t begin, std::size_t end, long long const* right,
+                     std::size_t nRight, long long* indices) const {
+    if (begin >= end) {
+        return;
+    }
+    // Differences are computed as unsigned, which cannot overflow for ordered times
+    typedef unsigned long long Difference;
+    Difference const tolerance = _tolerance.count();
+    long long const invalid = DateTime::invalid_nsecs;
+    std::size_t const first = std::upper_bound(right, right + nRight, invalid) - right;  // first valid
+
+    // For the current left time t, right[lower] is the first time >= t and right[upper] the first > t
+    std::size_t lower = std::lower_bound(right + first, right + nRight, left[begin]) - right;
+    std::size_t upper = lower;
+    for (std::size_t i = begin; i < end; ++i) {
+        long long const t = left[i];
+        if (t == invalid) {
+            indices[i] = NO_MATCH;
+            continue;
+        }
+        lower = _gallop(right, lower, nRight, [t](long long r) { return r < t; });
+        upper = _gallop(right, std::max(upper, lower), nRight, [t](long long r) { return r <= t; });
+
+        std::size_t const previous = _allowExactMatches ? upper : lower;  // one past the backward match
+        std::size_t const next = _allowExactMatches ? lower : upper;      // the forward match
+        long long match = NO_MATCH;
+        Difference distance = 0;
+        if (_direction != FORWARD && previous > first) {
+            distance = static_cast<Difference>(t) - static_cast<Difference>(right[previous - 1]);
+            if (distance <= tolerance) {
+                match = previous - 1;
+            }
+        }
+        if (_direction != BACKWARD && next < nRight) {
+            Difference const d = static_cast<Difference>(right[next]) - static_cast<Difference>(t);
+            if (d <= tolerance && (match == NO_MATCH || d < distance)) {
+                match = next;
+            }
+        }
+        indices[i] = match;
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
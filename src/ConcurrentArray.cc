@@ -0,0 +1,206 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/ConcurrentArray.h"
+
+#include <algorithm>
+#include <new>
+#include <thread>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/Persistable.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Index of the most significant set bit of a nonzero value
+inline unsigned _log2(std::size_t value) {
+#if defined(__GNUC__)
+    return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(value);
+#else
+    unsigned result = 0;
+    while (value >>= 1) {
+        ++result;
+    }
+    return result;
+#endif
+}
+
+}  // namespace
+
+template <typename T>
+ConcurrentArray<T>::ConcurrentArray() noexcept : _size(0) {
+    for (auto& segment : _segments) {
+        segment.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+ConcurrentArray<T>::~ConcurrentArray() noexcept {
+    std::size_t const size = _size.load(std::memory_order_acquire);
+    for (unsigned s = 0; s < MAX_SEGMENTS; ++s) {
+        Slot* segment = _segments[s].load(std::memory_order_relaxed);
+        if (segment == nullptr) {
+            continue;  // allocated segments need not be contiguous, as allocation may fail
+        }
+        std::size_t const begin = _segmentBegin(s);
+        std::size_t const end = std::min(begin + (FIRST_SEGMENT << s), std::max(begin, size));
+        for (std::size_t i = begin; i < end; ++i) {
+            Slot& slot = segment[i - begin];
+            if (slot.state.load(std::memory_order_relaxed) == READY) {
+                slot.value().~T();
+            }
+        }
+        delete[] segment;
+    }
+}
+
+template <typename T>
+std::size_t ConcurrentArray<T>::add(T const& value) {
+    std::size_t const index = _reserve(1);
+    _construct(index, value);
+    return index;
+}
+
+template <typename T>
+std::size_t ConcurrentArray<T>::add(std::vector<T> const& values) {
+    std::size_t const first = _reserve(values.size());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        try {
+            _construct(first + i, values[i]);
+        } catch (...) {
+            // Release the remaining indices so that snapshots do not wait for them
+            for (std::size_t j = i + 1; j < values.size(); ++j) {
+                _slot(first + j).state.store(FAILED, std::memory_order_release);
+            }
+            throw;
+        }
+    }
+    return first;
+}
+
+template <typename T>
+std::vector<T> ConcurrentArray<T>::snapshot() const {
+    std::size_t const size = _size.load(std::memory_order_acquire);
+    std::vector<T> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        Slot const& slot = _slot(i);
+        std::uint8_t state;
+        while ((state = slot.state.load(std::memory_order_acquire)) == EMPTY) {
+            std::this_thread::yield();  // the value is being constructed
+        }
+        if (state == READY) {
+            result.push_back(slot.value());
+        }
+    }
+    return result;
+}
+
+template <typename T>
+void ConcurrentArray<T>::snapshot(PropertySet& target, std::string const& name) const {
+    target.set(name, snapshot());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+unsigned ConcurrentArray<T>::_segmentOf(std::size_t index) noexcept {
+    // Segment s starts at index FIRST_SEGMENT * (2^s - 1)
+    return _log2((index >> FIRST_SEGMENT_BITS) + 1);
+}
+
+template <typename T>
+std::size_t ConcurrentArray<T>::_reserve(std::size_t n) {
+    std::size_t first = _size.load(std::memory_order_relaxed);
+    do {
+        if (n == 0) {
+            break;
+        }
+        // Allocate before reserving, so that a reserved index always has a slot to be marked in
+        unsigned const last = _segmentOf(first + n - 1);
+        if (last >= MAX_SEGMENTS || first + n < first) {
+            throw std::bad_alloc();
+        }
+        for (unsigned s = _segmentOf(first); s <= last; ++s) {
+            Slot* segment = _segments[s].load(std::memory_order_acquire);
+            if (segment == nullptr) {
+                Slot* allocated = new Slot[FIRST_SEGMENT << s];
+                if (!_segments[s].compare_exchange_strong(segment, allocated, std::memory_order_acq_rel,
+                                                          std::memory_order_acquire)) {
+                    delete[] allocated;  // another thread allocated it first
+                }
+            }
+        }
+    } while (!_size.compare_exchange_weak(first, first + n, std::memory_order_acq_rel,
+                                          std::memory_order_relaxed));
+    return first;
+}
+
+template <typename T>
+typename ConcurrentArray<T>::Slot& ConcurrentArray<T>::_slot(std::size_t index) const noexcept {
+    unsigned const s = _segmentOf(index);
+    return _segments[s].load(std::memory_order_acquire)[index - _segmentBegin(s)];
+}
+
+template <typename T>
+void ConcurrentArray<T>::_construct(std::size_t index, T const& value) {
+    Slot& slot = _slot(index);
+    try {
+        new (&slot.storage) T(value);
+    } catch (...) {
+        slot.state.store(FAILED, std::memory_order_release);
+        throw;
+    }
+    slot.state.store(READY, std::memory_order_release);
+}
+
+#define INSTANTIATE(t) template class ConcurrentArray<t>;
+
+INSTANTIATE(bool)
+INSTANTIATE(char)
+INSTANTIATE(signed char)
+INSTANTIATE(unsigned char)
+INSTANTIATE(short)
+INSTANTIATE(unsigned short)
+INSTANTIATE(int)
+INSTANTIATE(unsigned int)
+INSTANTIATE(long)
+INSTANTIATE(unsigned long)
+INSTANTIATE(long long)
+INSTANTIATE(unsigned long long)
+INSTANTIATE(float)
+INSTANTIATE(double)
+INSTANTIATE(std::string)
+INSTANTIATE(Persistable::Ptr)
+INSTANTIATE(DateTime)
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -34,6 +34,7 @@
  * \ingroup daf_base
  */
 
+#include <algorithm>
 #include <limits>
 #include <cmath>
 #include <vector>
@@ -42,6 +43,7 @@
 #include "boost/regex.hpp"
 
 #include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/Trace.h"
 #include "lsst/pex/exceptions.h"
 
 namespace dafBase = lsst::daf::base;
@@ -138,6 +140,7 @@ struct Leap {
     double offset;      ///< TAI - UTC
     double mjdRef;      ///< Intercept for MJD interpolation
     double drift;       ///< Slope of MJD interpolation
+    long long offsetNsecs;  ///< TAI - UTC in nanosecs, if drift is zero
 };
 
 class LeapTable : public std::vector<Leap> {
@@ -149,6 +152,31 @@ LeapTable leapSecTable;
 
 LeapTable::LeapTable(void) { dafBase::DateTime::initializeLeapSeconds(leapString); }
 
+/**
+ * Find the leap second table entry in effect at a given time
+ *
+ * @param[in] nsecs Number of nanoseconds since the epoch
+ * @param[in] when Member of Leap giving the time of each change, in the same time scale as nsecs
+ * @param[in] conversion Description of the conversion, for error messages
+ * @return The last entry whose change is not after nsecs
+ */
+template <typename NsType>
+Leap const& findLeap(NsType nsecs, long long Leap::*when, char const* conversion) {
+    // Most dates are after the most recent change
+    if (!leapSecTable.empty() && nsecs >= leapSecTable.back().*when) {
+        return leapSecTable.back();
+    }
+    auto const i = std::upper_bound(leapSecTable.begin(), leapSecTable.end(), nsecs,
+                                    [when](NsType n, Leap const& l) { return n < l.*when; });
+    if (i == leapSecTable.begin()) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::DomainError,
+                          (boost::format("DateTime value too early for %1% conversion: %2%") % conversion %
+                           nsecs)
+                                  .str());
+    }
+    return *(i - 1);
+}
+
 /**
  * Convert UTC time to TAI time
  *
@@ -157,16 +185,10 @@ LeapTable::LeapTable(void) { dafBase::DateTime::initializeLeapSeconds(leapString
  */
 template <typename NsType>
 NsType utcToTai(NsType nsecs) {
-    size_t i;
-    for (i = 0; i < leapSecTable.size(); ++i) {
-        if (nsecs < leapSecTable[i].whenUtc) break;
+    Leap const& l(findLeap(nsecs, &Leap::whenUtc, "UTC-TAI"));
+    if (l.drift == 0.0) {
+        return nsecs + l.offsetNsecs;
     }
-    if (i == 0) {
-        throw LSST_EXCEPT(
-                lsst::pex::exceptions::DomainError,
-                (boost::format("DateTime value too early for UTC-TAI conversion: %1%") % nsecs).str());
-    }
-    Leap const& l(leapSecTable[i - 1]);
     double mjd = static_cast<double>(nsecs) / NSEC_PER_DAY + EPOCH_IN_MJD;
     double leapSecs = l.offset + (mjd - l.mjdRef) * l.drift;
     NsType leapNSecs = static_cast<NsType>(leapSecs * 1.0e9 + 0.5);
@@ -181,16 +203,10 @@ NsType utcToTai(NsType nsecs) {
  */
 template <typename NsType>
 NsType taiToUtc(NsType nsecs) {
-    size_t i;
-    for (i = 0; i < leapSecTable.size(); ++i) {
-        if (nsecs < leapSecTable[i].whenTai) break;
+    Leap const& l(findLeap(nsecs, &Leap::whenTai, "TAI-UTC"));
+    if (l.drift == 0.0) {
+        return nsecs - l.offsetNsecs;
     }
-    if (i == 0) {
-        throw LSST_EXCEPT(
-                lsst::pex::exceptions::DomainError,
-                (boost::format("DateTime value too early for TAI-UTC conversion: %1%") % nsecs).str());
-    }
-    Leap const& l(leapSecTable[i - 1]);
     double mjd = static_cast<double>(nsecs) / NSEC_PER_DAY + EPOCH_IN_MJD;
     double leapSecs = l.offset + (mjd - l.mjdRef) * l.drift;
     // Correct for TAI MJD vs. UTC MJD.
@@ -383,6 +399,7 @@ DateTime::DateTime(int year, int month, int day, int hr, int min, int sec, Times
 }
 
 DateTime::DateTime(std::string const& iso8601, Timescale scale) {
+    LSST_DAF_BASE_TRACE_SPAN("DateTime::DateTime(iso8601)");
     boost::regex re;
     if (scale == UTC) {
         // time zone "Z" required
@@ -496,7 +513,13 @@ struct timeval DateTime::timeval(Timescale scale) const {
     return tv;
 }
 
+DateTime::SystemTime DateTime::toSystemTime() const {
+    _assertValid();
+    return SystemTime(std::chrono::nanoseconds(taiToUtc(_nsecs)));
+}
+
 std::string DateTime::toString(Timescale scale) const {
+    LSST_DAF_BASE_TRACE_SPAN("DateTime::toString");
     _assertValid();
     struct tm gmt(this->gmtime(scale));
 
@@ -538,6 +561,7 @@ void DateTime::initializeLeapSeconds(std::string const& leapString) {
         l.drift = strtod((*i)[4].first, 0);
         l.whenUtc = static_cast<long long>((mjdUtc - EPOCH_IN_MJD) * NSEC_PER_DAY);
         l.whenTai = l.whenUtc + static_cast<long long>(1.0e9 * (l.offset + (mjdUtc - l.mjdRef) * l.drift));
+        l.offsetNsecs = static_cast<long long>(l.offset * 1.0e9 + 0.5);
         leapSecTable.push_back(l);
     }
 }
@@ -0,0 +1,245 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/HeaderCache.h"
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <utility>
+
+#include <sys/stat.h>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/Trace.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Approximate heap overheads of the structures making up a PropertySet
+std::size_t const ENTRY_BYTES = 128;      // hash node, name, shared_ptr and vector of values
+std::size_t const VALUE_BYTES = 32;       // boost::any and its holder
+std::size_t const COMMENT_BYTES = 96;     // comment map node and order list node
+std::size_t const SET_BYTES = 128;        // nested PropertySet
+
+/**
+ * Handler that adds up the approximate memory used by a container
+ */
+class SizeEstimator : public PropertyHandler {
+public:
+    SizeEstimator() : bytes(0) {}
+
+    void beginSet(std::size_t) override { bytes += SET_BYTES; }
+    void key(std::string const& name) override { bytes += ENTRY_BYTES + _heap(name); }
+    void comment(std::string const& comment) override { bytes += COMMENT_BYTES + _heap(comment); }
+
+    void value(bool) override { bytes += VALUE_BYTES; }
+    void value(char) override { bytes += VALUE_BYTES; }
+    void value(signed char) override { bytes += VALUE_BYTES; }
+    void value(unsigned char) override { bytes += VALUE_BYTES; }
+    void value(short) override { bytes += VALUE_BYTES; }
+    void value(unsigned short) override { bytes += VALUE_BYTES; }
+    void value(int) override { bytes += VALUE_BYTES; }
+    void value(unsigned int) override { bytes += VALUE_BYTES; }
+    void value(long) override { bytes += VALUE_BYTES; }
+    void value(unsigned long) override { bytes += VALUE_BYTES; }
+    void value(long long) override { bytes += VALUE_BYTES; }
+    void value(unsigned long long) override { bytes += VALUE_BYTES; }
+    void value(float) override { bytes += VALUE_BYTES; }
+    void value(double) override { bytes += VALUE_BYTES; }
+    void value(std::nullptr_t) override { bytes += VALUE_BYTES; }
+    void value(std::string const& v) override { bytes += VALUE_BYTES + sizeof(std::string) + _heap(v); }
+    void value(DateTime const&) override { bytes += VALUE_BYTES; }
+    void value(Persistable::Ptr const&) override { bytes += VALUE_BYTES; }
+
+    std::size_t bytes;
+
+private:
+    // Heap memory used by a string beyond the short-string buffer
+    static std::size_t _heap(std::string const& s) { return s.size() < 16 ? 0 : s.capacity() + 1; }
+};
+
+}  // namespace
+
+HeaderCache::HeaderCache(std::size_t maxBytes)
+        : _maxBytes(maxBytes), _bytes(0), _hits(0), _misses(0), _evictions(0) {}
+
+HeaderCache::~HeaderCache() noexcept = default;
+
+HeaderCache& HeaderCache::getInstance() {
+    static HeaderCache instance;
+    return instance;
+}
+
+std::shared_ptr<PropertyList const> HeaderCache::get(std::string const& path, int hdu, Loader const& loader) {
+    FileId const id = _identify(path);
+    Key const key(path, hdu);
+    std::shared_ptr<Entry> entry;    // entry being loaded by another thread
+    std::shared_ptr<Entry> loading;  // entry to be loaded by this thread
+    std::promise<std::shared_ptr<PropertyList const>> promise;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto const i = _entries.find(key);
+        if (i != _entries.end() && i->second->id == id) {
+            ++_hits;
+            entry = i->second;
+            if (entry->ready) {
+                _lru.splice(_lru.begin(), _lru, entry->lruPos);
+                return entry->header.get();
+            }
+        } else {
+            if (i != _entries.end()) {
+                _remove(i);  // the file has changed
+            }
+            ++_misses;
+            loading = std::make_shared<Entry>();
+            loading->id = id;
+            loading->header = promise.get_future().share();
+            loading->ready = false;
+            loading->bytes = 0;
+            _entries.emplace(key, loading);
+        }
+    }
+    if (entry) {
+        // Another thread is loading this header
+        return entry->header.get();
+    }
+
+    std::shared_ptr<PropertyList const> header;
+    try {
+        LSST_DAF_BASE_TRACE_SPAN("HeaderCache::load");
+        header = loader(path, hdu);
+        if (!header) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "No header loaded from " + path);
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto const i = _entries.find(key);
+        if (i != _entries.end() && i->second == loading) {
+            _entries.erase(i);
+        }
+        throw;
+    }
+    std::size_t const bytes = estimateBytes(*header);
+    promise.set_value(header);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto const i = _entries.find(key);
+        // The entry may have been erased or replaced while loading
+        if (i != _entries.end() && i->second == loading) {
+            Entry& loaded = *(i->second);
+            loaded.ready = true;
+            loaded.bytes = bytes;
+            _lru.push_front(key);
+            loaded.lruPos = _lru.begin();
+            _bytes += bytes;
+            _evict();
+        }
+    }
+    return header;
+}
+
+void HeaderCache::erase(std::string const& path, int hdu) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto const i = _entries.find(Key(path, hdu));
+    if (i != _entries.end()) {
+        _remove(i);
+    }
+}
+
+void HeaderCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _entries.clear();
+    _lru.clear();
+    _bytes = 0;
+    _hits = 0;
+    _misses = 0;
+    _evictions = 0;
+}
+
+void HeaderCache::setMaxBytes(std::size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _maxBytes = maxBytes;
+    _evict();
+}
+
+std::size_t HeaderCache::getMaxBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _maxBytes;
+}
+
+HeaderCache::Statistics HeaderCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return Statistics{_hits, _misses, _evictions, _lru.size(), _bytes};
+}
+
+std::size_t HeaderCache::estimateBytes(PropertySet const& header) {
+    SizeEstimator estimator;
+    header.walk(estimator);
+    return estimator.bytes;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+HeaderCache::FileId HeaderCache::_identify(std::string const& path) {
+    struct stat st;
+    if (::stat(path.c_str(), &st) != 0) {
+        throw LSST_EXCEPT(pex::exceptions::IoError, "Cannot examine " + path + ": " + std::strerror(errno));
+    }
+#if defined(__APPLE__)
+    std::int64_t const mtime = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    std::int64_t const mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+    return FileId{static_cast<std::uint64_t>(st.st_dev), static_cast<std::uint64_t>(st.st_ino), mtime,
+                  static_cast<std::int64_t>(st.st_size)};
+}
+
+void HeaderCache::_remove(EntryMap::iterator i) {
+    Entry& entry = *(i->second);
+    if (entry.ready) {
+        _lru.erase(entry.lruPos);
+        _bytes -= entry.bytes;
+    }
+    _entries.erase(i);
+}
+
+void HeaderCache::_evict() {
+    while (_bytes > _maxBytes && !_lru.empty()) {
+        _remove(_entries.find(_lru.back()));
+        ++_evictions;
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
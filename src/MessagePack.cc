@@ -0,0 +1,743 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/MessagePack.h"
+
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyBuilder.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/Trace.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// MessagePack format bytes
+std::uint8_t const NIL = 0xc0;
+std::uint8_t const FALSE = 0xc2;
+std::uint8_t const TRUE = 0xc3;
+std::uint8_t const BIN8 = 0xc4;
+std::uint8_t const BIN16 = 0xc5;
+std::uint8_t const BIN32 = 0xc6;
+std::uint8_t const EXT8 = 0xc7;
+std::uint8_t const EXT16 = 0xc8;
+std::uint8_t const EXT32 = 0xc9;
+std::uint8_t const FLOAT32 = 0xca;
+std::uint8_t const FLOAT64 = 0xcb;
+std::uint8_t const UINT8 = 0xcc;
+std::uint8_t const UINT16 = 0xcd;
+std::uint8_t const UINT32 = 0xce;
+std::uint8_t const UINT64 = 0xcf;
+std::uint8_t const INT8 = 0xd0;
+std::uint8_t const INT16 = 0xd1;
+std::uint8_t const INT32 = 0xd2;
+std::uint8_t const INT64 = 0xd3;
+std::uint8_t const FIXEXT1 = 0xd4;
+std::uint8_t const FIXEXT4 = 0xd6;
+std::uint8_t const FIXEXT8 = 0xd7;
+std::uint8_t const FIXEXT16 = 0xd8;
+std::uint8_t const STR8 = 0xd9;
+std::uint8_t const STR16 = 0xda;
+std::uint8_t const STR32 = 0xdb;
+std::uint8_t const ARRAY16 = 0xdc;
+std::uint8_t const ARRAY32 = 0xdd;
+std::uint8_t const MAP16 = 0xde;
+std::uint8_t const MAP32 = 0xdf;
+std::uint8_t const FIXMAP = 0x80;
+std::uint8_t const FIXARRAY = 0x90;
+std::uint8_t const FIXSTR = 0xa0;
+
+std::int8_t const TIMESTAMP_EXT_TYPE = -1;  // standard extension type of timestamps
+
+// Deepest nesting of maps and arrays accepted by the reader
+int const MAX_DEPTH = 256;
+
+template <typename U>
+void storeBigEndian(char* p, U v) {
+    auto u = static_cast<typename std::make_unsigned<U>::type>(v);
+    for (int i = sizeof(U) - 1; i >= 0; --i) {
+        p[i] = static_cast<char>(u & 0xff);
+        u >>= 8;
+    }
+}
+
+template <typename U>
+U loadBigEndian(char const* p) {
+    typename std::make_unsigned<U>::type u = 0;
+    for (std::size_t i = 0; i < sizeof(U); ++i) {
+        u = (u << 8) | static_cast<std::uint8_t>(p[i]);
+    }
+    return static_cast<U>(u);
+}
+
+// What a value decodes to, as far as can be told from its format byte
+enum Kind {
+    NIL_KIND,
+    BOOL_KIND,
+    INT8_KIND,
+    INT16_KIND,
+    INT32_KIND,
+    INT64_KIND,
+    UINT8_KIND,
+    UINT16_KIND,
+    UINT32_KIND,
+    UINT64_KIND,
+    FLOAT_KIND,
+    DOUBLE_KIND,
+    STRING_KIND,
+    DATETIME_KIND,
+    ARRAY_KIND,
+    MAP_KIND
+};
+
+Kind kindOf(std::uint8_t format) {
+    if (format < FIXMAP || format >= 0xe0) return INT32_KIND;  // positive and negative fixint
+    if (format < FIXARRAY) return MAP_KIND;
+    if (format < FIXSTR) return ARRAY_KIND;
+    if (format < NIL) return STRING_KIND;
+    switch (format) {
+        case NIL:
+            return NIL_KIND;
+        case FALSE:
+        case TRUE:
+            return BOOL_KIND;
+        case BIN8:
+        case BIN16:
+        case BIN32:
+        case STR8:
+        case STR16:
+        case STR32:
+            return STRING_KIND;
+        case FLOAT32:
+            return FLOAT_KIND;
+        case FLOAT64:
+            return DOUBLE_KIND;
+        case UINT8:
+            return UINT8_KIND;
+        case UINT16:
+            return UINT16_KIND;
+        case UINT32:
+            return UINT32_KIND;
+        case UINT64:
+            return UINT64_KIND;
+        case INT8:
+            return INT8_KIND;
+        case INT16:
+            return INT16_KIND;
+        case INT32:
+            return INT32_KIND;
+        case INT64:
+            return INT64_KIND;
+        case ARRAY16:
+        case ARRAY32:
+            return ARRAY_KIND;
+        case MAP16:
+        case MAP32:
+            return MAP_KIND;
+        default:
+            break;
+    }
+    if ((format >= EXT8 && format <= EXT32) || (format >= FIXEXT1 && format <= FIXEXT16)) {
+        return DATETIME_KIND;
+    }
+    throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                      "Invalid MessagePack format byte " + std::to_string(format));
+}
+
+bool isInteger(Kind kind) { return kind >= INT8_KIND && kind <= UINT64_KIND; }
+
+/**
+ * Recursive descent parser of one MessagePack document
+ */
+class Parser {
+public:
+    Parser(char const* begin, char const* end, PropertyHandler& handler)
+            : _pos(begin), _end(end), _handler(handler), _depth(0) {}
+
+    // Parse a document and return the position following it
+    char const* document() {
+        std::uint8_t const format = _peek();
+        Kind const kind = kindOf(format);
+        if (kind == MAP_KIND) {
+            _map();
+        } else if (kind == ARRAY_KIND) {
+            _ordered();
+        } else {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "MessagePack document is neither a map nor an array");
+        }
+        return _pos;
+    }
+
+private:
+    void _need(std::size_t n) const {
+        if (static_cast<std::size_t>(_end - _pos) < n) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Truncated MessagePack data");
+        }
+    }
+
+    std::uint8_t _peek() const {
+        _need(1);
+        return static_cast<std::uint8_t>(*_pos);
+    }
+
+    std::uint8_t _next() {
+        std::uint8_t const format = _peek();
+        ++_pos;
+        return format;
+    }
+
+    template <typename U>
+    U _read() {
+        _need(sizeof(U));
+        U const v = loadBigEndian<U>(_pos);
+        _pos += sizeof(U);
+        return v;
+    }
+
+    // Read the size of a map or array, checking that the data can hold that many elements
+    std::size_t _size(std::uint8_t format, std::size_t perElement) {
+        std::size_t n;
+        if (format == ARRAY16 || format == MAP16) {
+            n = _read<std::uint16_t>();
+        } else if (format == ARRAY32 || format == MAP32) {
+            n = _read<std::uint32_t>();
+        } else {
+            n = format & 0x0f;
+        }
+        _need(n * perElement);
+        return n;
+    }
+
+    // Read the length of a string or binary value
+    std::size_t _length(std::uint8_t format) {
+        switch (format) {
+            case STR8:
+            case BIN8:
+                return _read<std::uint8_t>();
+            case STR16:
+            case BIN16:
+                return _read<std::uint16_t>();
+            case STR32:
+            case BIN32:
+                return _read<std::uint32_t>();
+            default:
+                return format & 0x1f;
+        }
+    }
+
+    // Read the length of an extension payload; the type byte follows
+    std::size_t _extLength(std::uint8_t format) {
+        switch (format) {
+            case EXT8:
+                return _read<std::uint8_t>();
+            case EXT16:
+                return _read<std::uint16_t>();
+            case EXT32:
+                return _read<std::uint32_t>();
+            default:
+                return std::size_t(1) << (format - FIXEXT1);
+        }
+    }
+
+    void _readString(std::string& s) {
+        std::uint8_t const format = _next();
+        if (kindOf(format) != STRING_KIND) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Expected a MessagePack string");
+        }
+        std::size_t const n = _length(format);
+        _need(n);
+        s.assign(_pos, n);
+        _pos += n;
+    }
+
+    void _enter() {
+        if (++_depth > MAX_DEPTH) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "MessagePack data nested too deeply");
+        }
+    }
+
+    // Advance past one value of any kind
+    void _skip() {
+        std::uint8_t const format = _next();
+        std::size_t n = 0;
+        switch (kindOf(format)) {
+            case NIL_KIND:
+            case BOOL_KIND:
+                break;
+            case INT8_KIND:
+            case INT16_KIND:
+            case INT32_KIND:
+            case INT64_KIND:
+            case UINT8_KIND:
+            case UINT16_KIND:
+            case UINT32_KIND:
+            case UINT64_KIND:
+            case FLOAT_KIND:
+            case DOUBLE_KIND:
+                if (format >= FLOAT32 && format <= INT64) {  // fixints have no payload
+                    n = std::size_t(1) << ((format - FLOAT32 + 2) & 3);  // 4, 8, 1, 2, 4, 8, 1, 2, 4, 8
+                }
+                break;
+            case STRING_KIND:
+                n = _length(format);
+                break;
+            case DATETIME_KIND:
+                n = _extLength(format) + 1;
+                break;
+            case ARRAY_KIND:
+                _enter();
+                for (std::size_t i = _size(format, 1); i > 0; --i) _skip();
+                --_depth;
+                break;
+            case MAP_KIND:
+                _enter();
+                for (std::size_t i = _size(format, 2); i > 0; --i) {
+                    _skip();
+                    _skip();
+                }
+                --_depth;
+                break;
+        }
+        _need(n);
+        _pos += n;
+    }
+
+    void _map() {
+        _enter();
+        std::size_t const n = _size(_next(), 2);
+        _handler.beginSet(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            _readString(_key);
+            _handler.key(_key);
+            _element();
+        }
+        _handler.endSet();
+        --_depth;
+    }
+
+    // An array of [name, value, comment] entries; a missing or nil comment is empty
+    void _ordered() {
+        _enter();
+        std::size_t const n = _size(_next(), 1);
+        _handler.beginSet(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint8_t const format = _next();
+            std::size_t const size = kindOf(format) == ARRAY_KIND ? _size(format, 1) : 0;
+            if (size != 2 && size != 3) {
+                throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                                  "Ordered MessagePack entries must be [name, value, comment]");
+            }
+            _readString(_key);
+            _handler.key(_key);
+            _element();
+            if (size == 3 && _peek() != NIL) {
+                _readString(_string);
+            } else {
+                _string.clear();
+                _pos += size - 2;
+            }
+            _handler.comment(_string);
+        }
+        _handler.endSet();
+        --_depth;
+    }
+
+    // The value(s) of a key
+    void _element() {
+        Kind const kind = kindOf(_peek());
+        if (kind == MAP_KIND) {
+            _map();
+        } else if (kind == ARRAY_KIND) {
+            _array();
+        } else {
+            _scalar(kind);
+        }
+    }
+
+    void _array() {
+        _enter();
+        std::size_t const n = _size(_next(), 1);
+        // Find a type that can hold all the elements before sending any of them
+        char const* const start = _pos;
+        Kind common = NIL_KIND;
+        for (std::size_t i = 0; i < n; ++i) {
+            Kind const kind = kindOf(_peek());
+            if (kind == ARRAY_KIND) {
+                throw LSST_EXCEPT(pex::exceptions::TypeError, "Arrays of arrays cannot be stored");
+            }
+            if (i == 0 || kind == common) {
+                common = kind;
+            } else if (isInteger(kind) && isInteger(common)) {
+                common = INT64_KIND;
+            } else if ((kind == FLOAT_KIND || kind == DOUBLE_KIND) &&
+                       (common == FLOAT_KIND || common == DOUBLE_KIND)) {
+                common = DOUBLE_KIND;
+            } else {
+                throw LSST_EXCEPT(pex::exceptions::TypeError, "Array elements of different types");
+            }
+            _skip();
+        }
+        _pos = start;
+        _handler.beginArray(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (common == MAP_KIND) {
+                _map();
+            } else {
+                _scalar(common);
+            }
+        }
+        _handler.endArray();
+        --_depth;
+    }
+
+    // Send a value with the type corresponding to kind, which the format must be convertible to
+    void _scalar(Kind kind) {
+        std::uint8_t const format = _next();
+        Kind const actual = kindOf(format);
+        if (isInteger(actual)) {
+            _integer(format, actual, kind);
+            return;
+        }
+        switch (actual) {
+            case NIL_KIND:
+                _handler.value(nullptr);
+                break;
+            case BOOL_KIND:
+                _handler.value(format == TRUE);
+                break;
+            case FLOAT_KIND: {
+                std::uint32_t const bits = _read<std::uint32_t>();
+                float v;
+                std::memcpy(&v, &bits, sizeof(v));
+                if (kind == DOUBLE_KIND) {
+                    _handler.value(static_cast<double>(v));
+                } else {
+                    _handler.value(v);
+                }
+                break;
+            }
+            case DOUBLE_KIND: {
+                std::uint64_t const bits = _read<std::uint64_t>();
+                double v;
+                std::memcpy(&v, &bits, sizeof(v));
+                _handler.value(v);
+                break;
+            }
+            case STRING_KIND: {
+                std::size_t const n = _length(format);
+                _need(n);
+                _string.assign(_pos, n);
+                _pos += n;
+                _handler.value(_string);
+                break;
+            }
+            case DATETIME_KIND:
+                _handler.value(_dateTime(format));
+                break;
+            default:
+                break;
+        }
+    }
+
+    void _integer(std::uint8_t format, Kind actual, Kind kind) {
+        std::int64_t v = 0;
+        std::uint64_t u = 0;
+        bool isUnsigned = false;
+        switch (actual) {
+            case INT8_KIND:
+                v = _read<std::int8_t>();
+                break;
+            case INT16_KIND:
+                v = _read<std::int16_t>();
+                break;
+            case INT32_KIND:
+                v = format == INT32 ? _read<std::int32_t>() : static_cast<std::int8_t>(format);  // fixint
+                break;
+            case INT64_KIND:
+                v = _read<std::int64_t>();
+                break;
+            case UINT8_KIND:
+                u = _read<std::uint8_t>();
+                isUnsigned = true;
+                break;
+            case UINT16_KIND:
+                u = _read<std::uint16_t>();
+                isUnsigned = true;
+                break;
+            case UINT32_KIND:
+                u = _read<std::uint32_t>();
+                isUnsigned = true;
+                break;
+            default:
+                u = _read<std::uint64_t>();
+                isUnsigned = true;
+                break;
+        }
+        switch (kind) {
+            case INT8_KIND:
+                _handler.value(static_cast<signed char>(v));
+                break;
+            case INT16_KIND:
+                _handler.value(static_cast<short>(v));
+                break;
+            case INT32_KIND:
+                _handler.value(static_cast<int>(v));
+                break;
+            case UINT8_KIND:
+                _handler.value(static_cast<unsigned char>(u));
+                break;
+            case UINT16_KIND:
+                _handler.value(static_cast<unsigned short>(u));
+                break;
+            case UINT32_KIND:
+                _handler.value(static_cast<unsigned int>(u));
+                break;
+            case UINT64_KIND:
+                _handler.value(static_cast<unsigned long long>(u));
+                break;
+            default:  // INT64_KIND, also the common type of mixed integer arrays
+                if (isUnsigned && u > static_cast<std::uint64_t>(std::numeric_limits<long long>::max())) {
+                    throw LSST_EXCEPT(pex::exceptions::TypeError,
+                                      "Array mixes signed integers with " + std::to_string(u));
+                }
+                _handler.value(static_cast<long long>(isUnsigned ? static_cast<std::int64_t>(u) : v));
+                break;
+        }
+    }
+
+    DateTime _dateTime(std::uint8_t format) {
+        std::size_t const n = _extLength(format);
+        std::int8_t const type = _read<std::int8_t>();
+        _need(n);
+        char const* const p = _pos;
+        _pos += n;
+        if (type == MessagePackWriter::DATETIME_EXT_TYPE && n == 8) {
+            return DateTime(loadBigEndian<std::int64_t>(p), DateTime::TAI);
+        }
+        if (type == TIMESTAMP_EXT_TYPE) {
+            long long const nsecPerSec = 1000000000LL;
+            if (n == 4) {
+                return DateTime(loadBigEndian<std::uint32_t>(p) * nsecPerSec, DateTime::UTC);
+            } else if (n == 8) {
+                std::uint64_t const v = loadBigEndian<std::uint64_t>(p);
+                return DateTime(static_cast<long long>(v & 0x3ffffffffULL) * nsecPerSec +
+                                        static_cast<long long>(v >> 34),
+                                DateTime::UTC);
+            } else if (n == 12) {
+                long long const nsec = loadBigEndian<std::uint32_t>(p);
+                return DateTime(loadBigEndian<std::int64_t>(p + 4) * nsecPerSec + nsec, DateTime::UTC);
+            }
+        }
+        throw LSST_EXCEPT(pex::exceptions::TypeError,
+                          "Unsupported MessagePack extension type " + std::to_string(type));
+    }
+
+    char const* _pos;
+    char const* const _end;
+    PropertyHandler& _handler;
+    int _depth;
+    std::string _key;     // reused for every key
+    std::string _string;  // reused for every string value and comment
+};
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// MessagePackWriter
+///////////////////////////////////////////////////////////////////////////////
+
+constexpr std::int8_t MessagePackWriter::DATETIME_EXT_TYPE;
+
+MessagePackWriter::MessagePackWriter(std::string& out, bool ordered)
+        : _out(out), _ordered(ordered), _depth(0) {}
+
+MessagePackWriter::~MessagePackWriter() noexcept = default;
+
+void MessagePackWriter::encode(PropertySet const& container, std::string& out) {
+    LSST_DAF_BASE_TRACE_SPAN("MessagePackWriter::encode");
+    MessagePackWriter writer(out, dynamic_cast<PropertyList const*>(&container) != nullptr);
+    container.walk(writer);
+}
+
+std::string MessagePackWriter::encode(PropertySet const& container) {
+    std::string out;
+    encode(container, out);
+    return out;
+}
+
+void MessagePackWriter::beginSet(std::size_t size) {
+    if (_ordered && _depth == 0) {
+        _header(size, FIXARRAY, 15, ARRAY16);
+    } else {
+        _header(size, FIXMAP, 15, MAP16);
+    }
+    ++_depth;
+}
+
+void MessagePackWriter::endSet() { --_depth; }
+
+void MessagePackWriter::key(std::string const& name) {
+    if (_ordered && _depth == 1) {
+        _out.push_back(static_cast<char>(FIXARRAY | 3));
+    }
+    value(name);
+}
+
+void MessagePackWriter::comment(std::string const& comment) {
+    if (_ordered && _depth == 1) {
+        value(comment);
+    }
+}
+
+void MessagePackWriter::beginArray(std::size_t size) { _header(size, FIXARRAY, 15, ARRAY16); }
+
+void MessagePackWriter::value(bool v) { _out.push_back(static_cast<char>(v ? TRUE : FALSE)); }
+void MessagePackWriter::value(char v) { _put(INT8, static_cast<std::int8_t>(v)); }
+void MessagePackWriter::value(signed char v) { _put(INT8, static_cast<std::int8_t>(v)); }
+void MessagePackWriter::value(unsigned char v) { _put(UINT8, static_cast<std::uint8_t>(v)); }
+void MessagePackWriter::value(short v) { _put(INT16, static_cast<std::int16_t>(v)); }
+void MessagePackWriter::value(unsigned short v) { _put(UINT16, static_cast<std::uint16_t>(v)); }
+void MessagePackWriter::value(int v) { _put(INT32, static_cast<std::int32_t>(v)); }
+void MessagePackWriter::value(unsigned int v) { _put(UINT32, static_cast<std::uint32_t>(v)); }
+void MessagePackWriter::value(long v) { _put(INT64, static_cast<std::int64_t>(v)); }
+void MessagePackWriter::value(unsigned long v) { _put(UINT64, static_cast<std::uint64_t>(v)); }
+void MessagePackWriter::value(long long v) { _put(INT64, static_cast<std::int64_t>(v)); }
+void MessagePackWriter::value(unsigned long long v) { _put(UINT64, static_cast<std::uint64_t>(v)); }
+
+void MessagePackWriter::value(float v) {
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    _put(FLOAT32, bits);
+}
+
+void MessagePackWriter::value(double v) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    _put(FLOAT64, bits);
+}
+
+void MessagePackWriter::value(std::nullptr_t) { _out.push_back(static_cast<char>(NIL)); }
+
+void MessagePackWriter::value(std::string const& v) {
+    std::size_t const n = v.size();
+    if (n <= 31) {
+        _out.push_back(static_cast<char>(FIXSTR | n));
+    } else if (n <= std::numeric_limits<std::uint8_t>::max()) {
+        _put(STR8, static_cast<std::uint8_t>(n));
+    } else if (n <= std::numeric_limits<std::uint16_t>::max()) {
+        _put(STR16, static_cast<std::uint16_t>(n));
+    } else {
+        _put(STR32, static_cast<std::uint32_t>(n));
+    }
+    _out.append(v);
+}
+
+void MessagePackWriter::value(DateTime const& v) {
+    char buf[10];
+    buf[0] = static_cast<char>(FIXEXT8);
+    buf[1] = static_cast<char>(DATETIME_EXT_TYPE);
+    storeBigEndian(buf + 2, static_cast<std::int64_t>(v.nsecs(DateTime::TAI)));
+    _out.append(buf, sizeof(buf));
+}
+
+void MessagePackWriter::value(Persistable::Ptr const&) {
+    throw LSST_EXCEPT(pex::exceptions::TypeError, "Persistable values cannot be encoded as MessagePack");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+template <typename U>
+void MessagePackWriter::_put(std::uint8_t format, U v) {
+    char buf[1 + sizeof(U)];
+    buf[0] = static_cast<char>(format);
+    storeBigEndian(buf + 1, v);
+    _out.append(buf, sizeof(buf));
+}
+
+void MessagePackWriter::_header(std::size_t size, std::uint8_t fix, std::uint8_t fixMax,
+                                std::uint8_t format16) {
+    if (size <= fixMax) {
+        _out.push_back(static_cast<char>(fix | size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+        _put(format16, static_cast<std::uint16_t>(size));
+    } else {
+        _put(static_cast<std::uint8_t>(format16 + 1), static_cast<std::uint32_t>(size));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MessagePackReader
+///////////////////////////////////////////////////////////////////////////////
+
+MessagePackReader::MessagePackReader(char const* data, std::size_t size)
+        : _data(data), _size(size), _pos(0) {}
+
+bool MessagePackReader::isOrdered() const {
+    if (atEnd()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "No more MessagePack documents");
+    }
+    return kindOf(static_cast<std::uint8_t>(_data[_pos])) == ARRAY_KIND;
+}
+
+void MessagePackReader::read(PropertyHandler& handler) {
+    Parser parser(_data + _pos, _data + _size, handler);
+    _pos = parser.document() - _data;
+}
+
+std::shared_ptr<PropertySet> MessagePackReader::decode(char const* data, std::size_t size) {
+    LSST_DAF_BASE_TRACE_SPAN("MessagePackReader::decode");
+    MessagePackReader reader(data, size);
+    std::shared_ptr<PropertySet> result;
+    if (reader.isOrdered()) {
+        result = std::make_shared<PropertyList>();
+    } else {
+        result = std::make_shared<PropertySet>();
+    }
+    PropertyBuilder builder(result);
+    reader.read(builder);
+    if (!reader.atEnd()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Unexpected data after MessagePack document at offset " +
+                                  std::to_string(reader.getPosition()));
+    }
+    return result;
+}
+
+std::shared_ptr<PropertySet> MessagePackReader::decode(std::string const& data) {
+    return decode(data.data(), data.size());
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
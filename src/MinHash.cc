@@ -0,0 +1,265 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/MinHash.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <memory>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/detail/hashing.h"
+#include "lsst/daf/base/detail/parallelFor.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Fewest containers worth hashing in a separate thread
+std::size_t const MIN_PER_THREAD = 64;
+
+// Distinguish values of different kinds that would otherwise hash alike
+std::uint64_t const BOOL_TAG = 0x6a09e667f3bcc908ULL;
+std::uint64_t const FLOAT_TAG = 0xbb67ae8584caa73bULL;
+std::uint64_t const STRING_TAG = 0x3c6ef372fe94f82bULL;
+std::uint64_t const DATETIME_TAG = 0xa54ff53a5f1d36f1ULL;
+std::uint64_t const NULL_TAG = 0x510e527fade682d1ULL;
+std::uint64_t const PERSISTABLE_TAG = 0x9b05688c2b3e6c1fULL;
+
+// Turns the (name, value) pairs reported by PropertySet::walk into set elements
+class ElementHasher : public PropertyHandler {
+public:
+    ElementHasher(std::unordered_set<std::string> const& ignore, int precision,
+                  std::vector<std::uint64_t>& elements)
+            : _ignore(ignore), _precision(precision), _elements(elements), _skip(false), _nameHash(0) {}
+
+    void beginSet(std::size_t) override {
+        if (_frames.empty()) {
+            _frames.push_back(Frame{std::string(), false});
+        } else {
+            _frames.push_back(Frame{_name + ".", _skip});
+        }
+    }
+
+    void endSet() override {
+        _frames.pop_back();
+        if (!_frames.empty()) {
+            _skip = _frames.back().skip;
+        }
+    }
+
+    void key(std::string const& name) override {
+        Frame const& frame = _frames.back();
+        _name.assign(frame.prefix).append(name);
+        _skip = frame.skip || _ignored();
+        _nameHash = detail::hashBytes(_name.data(), _name.size());
+    }
+
+    void value(bool v) override { _add(BOOL_TAG + v); }
+    void value(char v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(signed char v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(unsigned char v) override { _add(v); }
+    void value(short v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(unsigned short v) override { _add(v); }
+    void value(int v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(unsigned int v) override { _add(v); }
+    void value(long v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(unsigned long v) override { _add(v); }
+    void value(long long v) override { _add(static_cast<std::uint64_t>(v)); }
+    void value(unsigned long long v) override { _add(v); }
+    void value(float v) override { value(static_cast<double>(v)); }
+
+    void value(double v) override {
+        if (std::trunc(v) == v && std::fabs(v) < 9.0e18) {
+            _add(static_cast<std::uint64_t>(static_cast<long long>(v)));
+            return;
+        }
+        char buffer[40];
+        int const n = std::snprintf(buffer, sizeof(buffer), "%.*g", _precision, v);
+        _add(detail::hashBytes(buffer, std::min<std::size_t>(n, sizeof(buffer) - 1)) ^ FLOAT_TAG);
+    }
+
+    void value(std::nullptr_t) override { _add(NULL_TAG); }
+
+    void value(std::string const& v) override {
+        std::size_t const begin = v.find_first_not_of(' ');
+        if (begin == std::string::npos) {
+            _add(detail::hashBytes(nullptr, 0) ^ STRING_TAG);
+            return;
+        }
+        std::size_t const end = v.find_last_not_of(' ') + 1;
+        _add(detail::hashBytes(v.data() + begin, end - begin) ^ STRING_TAG);
+    }
+
+    void value(DateTime const& v) override {
+        _add(static_cast<std::uint64_t>(v.nsecs(DateTime::TAI)) ^ DATETIME_TAG);
+    }
+
+    void value(Persistable::Ptr const&) override { _add(PERSISTABLE_TAG); }
+
+private:
+    struct Frame {
+        std::string prefix;  // prepended to the keys of this set
+        bool skip;           // the set itself is ignored
+    };
+
+    // Whether the current name, or a name it is nested in, is ignored
+    bool _ignored() const {
+        if (_ignore.empty()) {
+            return false;
+        }
+        for (std::size_t dot = _name.find('.'); dot != std::string::npos; dot = _name.find('.', dot + 1)) {
+            if (_ignore.count(_name.substr(0, dot)) > 0) {
+                return true;
+            }
+        }
+        return _ignore.count(_name) > 0;
+    }
+
+    void _add(std::uint64_t valueHash) {
+        if (!_skip) {
+            _elements.push_back(detail::mix64(_nameHash ^ detail::mix64(valueHash)));
+        }
+    }
+
+    std::unordered_set<std::string> const& _ignore;
+    int _precision;
+    std::vector<std::uint64_t>& _elements;
+    std::vector<Frame> _frames;
+    std::string _name;  // full name of the current key
+    bool _skip;         // values of the current key are ignored
+    std::uint64_t _nameHash;
+};
+
+}  // namespace
+
+MinHash::MinHash(int nHashes, std::vector<std::string> const& ignore, int precision, std::uint64_t seed)
+        : _ignore(ignore.begin(), ignore.end()), _precision(precision), _seed(seed) {
+    if (nHashes <= 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Number of hashes must be positive, not " + std::to_string(nHashes));
+    }
+    if (precision <= 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Precision must be positive, not " + std::to_string(precision));
+    }
+    // Coefficients of the hash functions come from a splitmix64 sequence
+    std::uint64_t state = seed;
+    auto next = [&state]() {
+        state += 0x9e3779b97f4a7c15ULL;
+        return detail::mix64(state);
+    };
+    _a.resize(nHashes);
+    _b.resize(nHashes);
+    for (int i = 0; i < nHashes; ++i) {
+        _a[i] = next() | 1;
+        _b[i] = next();
+    }
+}
+
+MinHash::~MinHash() noexcept = default;
+MinHash::MinHash(MinHash const&) = default;
+MinHash::MinHash(MinHash&&) = default;
+MinHash& MinHash::operator=(MinHash const&) = default;
+MinHash& MinHash::operator=(MinHash&&) = default;
+
+std::vector<std::string> MinHash::getIgnored() const {
+    std::vector<std::string> names(_ignore.begin(), _ignore.end());
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+MinHash::Signature MinHash::operator()(PropertySet const& properties) const {
+    std::vector<std::uint64_t> elements;
+    Signature signature;
+    _elements(properties, elements);
+    _sign(elements, signature);
+    return signature;
+}
+
+std::vector<MinHash::Signature> MinHash::operator()(std::vector<PropertySet::ConstPtr> const& properties,
+                                                    int nThreads) const {
+    for (auto const& p : properties) {
+        if (!p) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Null PropertySet");
+        }
+    }
+    std::vector<Signature> signatures(properties.size());
+    detail::parallelFor(properties.size(), nThreads, MIN_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        std::vector<std::uint64_t> elements;
+        for (std::size_t i = begin; i < end; ++i) {
+            _elements(*properties[i], elements);
+            _sign(elements, signatures[i]);
+        }
+    });
+    return signatures;
+}
+
+double MinHash::similarity(Signature const& a, Signature const& b) {
+    if (a.size() != b.size() || a.empty()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "Cannot compare signatures of lengths " + std::to_string(a.size()) + " and " +
+                                  std::to_string(b.size()));
+    }
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        equal += (a[i] == b[i]);
+    }
+    return static_cast<double>(equal) / a.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+void MinHash::_elements(PropertySet const& properties, std::vector<std::uint64_t>& elements) const {
+    elements.clear();
+    ElementHasher hasher(_ignore, _precision, elements);
+    properties.walk(hasher);
+}
+
+void MinHash::_sign(std::vector<std::uint64_t> const& elements, Signature& signature) const {
+    std::size_t const n = _a.size();
+    signature.assign(n, std::numeric_limits<std::uint32_t>::max());
+    std::uint32_t* const sig = signature.data();
+    std::uint64_t const* const a = _a.data();
+    std::uint64_t const* const b = _b.data();
+    for (std::uint64_t const x : elements) {
+        // Multiply-add-shift hashing; the elements are already well mixed
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint32_t const h = static_cast<std::uint32_t>((a[i] * x + b[i]) >> 32);
+            sig[i] = std::min(sig[i], h);
+        }
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -0,0 +1,273 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/MinHashIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/detail/hashing.h"
+#include "lsst/daf/base/detail/parallelFor.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Fewest signatures worth hashing or querying in a separate thread
+std::size_t const MIN_PER_THREAD = 1024;
+
+}  // namespace
+
+std::uint32_t const MinHashIndex::NONE = std::numeric_limits<std::uint32_t>::max();
+
+MinHashIndex::MinHashIndex(int nBands, int rowsPerBand)
+        : _nBands(nBands), _rowsPerBand(rowsPerBand), _length(0) {
+    if (nBands <= 0 || rowsPerBand <= 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Numbers of bands and rows must be positive, not " + std::to_string(nBands) +
+                                  " and " + std::to_string(rowsPerBand));
+    }
+    _buckets.resize(nBands);
+}
+
+MinHashIndex::~MinHashIndex() noexcept = default;
+MinHashIndex::MinHashIndex(MinHashIndex const&) = default;
+MinHashIndex::MinHashIndex(MinHashIndex&&) = default;
+MinHashIndex& MinHashIndex::operator=(MinHashIndex const&) = default;
+MinHashIndex& MinHashIndex::operator=(MinHashIndex&&) = default;
+
+double MinHashIndex::getThreshold() const { return std::pow(1.0 / _nBands, 1.0 / _rowsPerBand); }
+
+void MinHashIndex::clear() {
+    _length = 0;
+    _entries.clear();
+    for (auto& buckets : _buckets) {
+        buckets.clear();
+    }
+    _next.clear();
+}
+
+std::size_t MinHashIndex::insert(MinHash::Signature const& signature) {
+    _checkLength(signature);
+    if (size() >= NONE) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError, "MinHashIndex is full");
+    }
+    std::vector<std::uint64_t> hashes(_nBands);
+    for (int band = 0; band < _nBands; ++band) {
+        hashes[band] = _bandHash(signature.data(), band);
+    }
+    _length = signature.size();
+    std::size_t const id = size();
+    _insert(signature.data(), hashes.data());
+    return id;
+}
+
+std::size_t MinHashIndex::insert(std::vector<MinHash::Signature> const& signatures, int nThreads) {
+    for (auto const& signature : signatures) {
+        _checkLength(signature);
+        if (signature.size() != signatures.front().size()) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError, "Signatures differ in length");
+        }
+    }
+    std::size_t const first = size();
+    if (signatures.empty()) {
+        return first;
+    }
+    if (signatures.size() >= NONE - first) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError, "Too many signatures for MinHashIndex");
+    }
+    std::vector<std::uint64_t> hashes(signatures.size() * _nBands);
+    detail::parallelFor(signatures.size(), nThreads, MIN_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            for (int band = 0; band < _nBands; ++band) {
+                hashes[i * _nBands + band] = _bandHash(signatures[i].data(), band);
+            }
+        }
+    });
+    _length = signatures.front().size();
+    _entries.reserve(_entries.size() + signatures.size() * _length);
+    _next.reserve(_next.size() + signatures.size() * _nBands);
+    for (std::size_t i = 0; i < signatures.size(); ++i) {
+        _insert(signatures[i].data(), hashes.data() + i * _nBands);
+    }
+    return first;
+}
+
+MinHash::Signature MinHashIndex::getSignature(std::size_t id) const {
+    if (id >= size()) {
+        throw LSST_EXCEPT(pex::exceptions::OutOfRangeError,
+                          "No signature " + std::to_string(id) + " in index of size " +
+                                  std::to_string(size()));
+    }
+    auto const begin = _entries.begin() + id * _length;
+    return MinHash::Signature(begin, begin + _length);
+}
+
+std::vector<std::size_t> MinHashIndex::query(MinHash::Signature const& signature, double threshold) const {
+    std::vector<std::size_t> result;
+    if (size() == 0) {
+        return result;
+    }
+    if (signature.size() != _length) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "Signature of length " + std::to_string(signature.size()) + " in index of length " +
+                                  std::to_string(_length));
+    }
+    std::vector<std::uint32_t> candidates;
+    for (int band = 0; band < _nBands; ++band) {
+        auto const bucket = _buckets[band].find(_bandHash(signature.data(), band));
+        if (bucket == _buckets[band].end()) {
+            continue;
+        }
+        for (std::uint32_t id = bucket->second; id != NONE; id = _next[std::size_t(id) * _nBands + band]) {
+            candidates.push_back(id);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::vector<std::pair<double, std::size_t>> similar;
+    for (std::uint32_t const id : candidates) {
+        double const s = _similarity(id, signature.data());
+        if (s >= threshold) {
+            similar.emplace_back(-s, id);
+        }
+    }
+    std::sort(similar.begin(), similar.end());
+    result.reserve(similar.size());
+    for (auto const& item : similar) {
+        result.push_back(item.second);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::size_t>> MinHashIndex::query(std::vector<MinHash::Signature> const& signatures,
+                                                          double threshold, int nThreads) const {
+    std::vector<std::vector<std::size_t>> results(signatures.size());
+    detail::parallelFor(signatures.size(), nThreads, 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            results[i] = query(signatures[i], threshold);
+        }
+    });
+    return results;
+}
+
+std::vector<std::size_t> MinHashIndex::cluster(double threshold) const {
+    std::size_t const n = size();
+    std::vector<std::size_t> parent(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        parent[i] = i;
+    }
+    // Union-find in which the root of each group is its smallest member
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    for (int band = 0; band < _nBands; ++band) {
+        for (auto const& bucket : _buckets[band]) {
+            std::uint32_t const latest = bucket.second;
+            std::uint32_t const* const signature = _entries.data() + latest * _length;
+            std::uint32_t id = _next[std::size_t(latest) * _nBands + band];
+            for (; id != NONE; id = _next[std::size_t(id) * _nBands + band]) {
+                if (_similarity(id, signature) < threshold) {
+                    continue;
+                }
+                std::size_t const a = find(latest);
+                std::size_t const b = find(id);
+                if (a < b) {
+                    parent[b] = a;
+                } else if (b < a) {
+                    parent[a] = b;
+                }
+            }
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        parent[i] = find(i);
+    }
+    return parent;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+std::uint64_t MinHashIndex::_bandHash(std::uint32_t const* signature, int band) const {
+    std::uint32_t const* const rows = signature + band * _rowsPerBand;
+    std::uint64_t h = static_cast<std::uint64_t>(band);
+    for (int i = 0; i < _rowsPerBand; ++i) {
+        h = detail::mix64(h ^ rows[i]);
+    }
+    return h;
+}
+
+void MinHashIndex::_checkLength(MinHash::Signature const& signature) const {
+    std::size_t const minLength = static_cast<std::size_t>(_nBands) * _rowsPerBand;
+    if (signature.size() < minLength) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "Signature of length " + std::to_string(signature.size()) + " is shorter than " +
+                                  std::to_string(_nBands) + " bands of " + std::to_string(_rowsPerBand));
+    }
+    if (_length != 0 && signature.size() != _length) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "Signature of length " + std::to_string(signature.size()) + " in index of length " +
+                                  std::to_string(_length));
+    }
+}
+
+double MinHashIndex::_similarity(std::size_t id, std::uint32_t const* signature) const {
+    std::uint32_t const* const entry = _entries.data() + id * _length;
+    std::size_t equal = 0;
+    for (std::size_t i = 0; i < _length; ++i) {
+        equal += (entry[i] == signature[i]);
+    }
+    return static_cast<double>(equal) / _length;
+}
+
+void MinHashIndex::_insert(std::uint32_t const* signature, std::uint64_t const* hashes) {
+    std::uint32_t const id = static_cast<std::uint32_t>(size());
+    _entries.insert(_entries.end(), signature, signature + _length);
+    for (int band = 0; band < _nBands; ++band) {
+        auto const result = _buckets[band].emplace(hashes[band], id);
+        if (result.second) {
+            _next.push_back(NONE);
+        } else {
+            _next.push_back(result.first->second);
+            result.first->second = id;
+        }
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
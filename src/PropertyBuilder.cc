@@ -0,0 +1,190 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/PropertyBuilder.h"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+PropertyBuilder::PropertyBuilder(PropertySet::Ptr target)
+        : _target(std::move(target)), _list(dynamic_cast<PropertyList*>(_target.get())), _depth(0) {
+    if (!_target) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Missing target");
+    }
+}
+
+PropertyBuilder::~PropertyBuilder() noexcept = default;
+
+void PropertyBuilder::beginSet(std::size_t size) {
+    if (_depth == _frames.size()) {
+        _frames.emplace_back();
+    }
+    Frame& frame = _frames[_depth];
+    frame.append = false;
+    frame.array.reset();
+    frame.stored = false;
+    frame.prefix.clear();
+    if (_depth == 0) {
+        frame.set = _target;
+    } else {
+        Frame& parent = _frames[_depth - 1];
+        if (parent.set->_flat) {
+            // Flatten into the parent's container using dotted names
+            frame.set = parent.set;
+            frame.prefix.append(parent.prefix).append(parent.key).append(1, '.');
+            frame.append = parent.append || parent.array;
+        } else {
+            frame.set = std::make_shared<PropertySet>();
+            if (parent.set->isConcurrent()) {
+                // Before it is published, as appending to a stored array does not share it
+                frame.set->makeConcurrent();
+            }
+            if (!parent.array) {
+                // Insert while still empty, which makes the cycle check trivial
+                _put(parent, std::make_shared<std::vector<boost::any>>(1, boost::any(frame.set)));
+            } else {
+                {
+                    auto const lock = _lockArray(parent);
+                    parent.array->push_back(frame.set);
+                }
+                if (!parent.stored) {
+                    _put(parent, parent.array);
+                    parent.stored = true;
+                }
+            }
+        }
+    }
+    if (!frame.set->_flat) {
+        auto const lock = frame.set->_lockUnique();  // the set may already be published
+        frame.set->_map.reserve(size);
+    }
+    ++_depth;
+}
+
+void PropertyBuilder::endSet() {
+    if (_depth == 0) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "endSet without matching beginSet");
+    }
+    _frames[--_depth].set.reset();
+}
+
+void PropertyBuilder::key(std::string const& name) { _top().key = name; }
+
+void PropertyBuilder::comment(std::string const& comment) {
+    Frame& frame = _top();
+    if (_list != nullptr && frame.set.get() == _list) {
+        if (frame.prefix.empty()) {
+            _list->_commentOrderFix(frame.key, comment);
+        } else {
+            _list->_commentOrderFix(frame.prefix + frame.key, comment);
+        }
+    }
+}
+
+void PropertyBuilder::beginArray(std::size_t size) {
+    Frame& frame = _top();
+    frame.array = std::make_shared<std::vector<boost::any>>();
+    frame.array->reserve(size);
+    frame.stored = false;
+}
+
+void PropertyBuilder::endArray() {
+    Frame& frame = _top();
+    if (!frame.array) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "endArray without matching beginArray");
+    }
+    if (!frame.stored && !frame.array->empty()) {
+        _put(frame, frame.array);
+    }
+    frame.array.reset();
+    frame.stored = false;
+}
+
+void PropertyBuilder::value(bool v) { _value(v); }
+void PropertyBuilder::value(char v) { _value(v); }
+void PropertyBuilder::value(signed char v) { _value(v); }
+void PropertyBuilder::value(unsigned char v) { _value(v); }
+void PropertyBuilder::value(short v) { _value(v); }
+void PropertyBuilder::value(unsigned short v) { _value(v); }
+void PropertyBuilder::value(int v) { _value(v); }
+void PropertyBuilder::value(unsigned int v) { _value(v); }
+void PropertyBuilder::value(long v) { _value(v); }
+void PropertyBuilder::value(unsigned long v) { _value(v); }
+void PropertyBuilder::value(long long v) { _value(v); }
+void PropertyBuilder::value(unsigned long long v) { _value(v); }
+void PropertyBuilder::value(float v) { _value(v); }
+void PropertyBuilder::value(double v) { _value(v); }
+void PropertyBuilder::value(std::nullptr_t v) { _value(v); }
+void PropertyBuilder::value(std::string const& v) { _value(v); }
+void PropertyBuilder::value(DateTime const& v) { _value(v); }
+void PropertyBuilder::value(Persistable::Ptr const& v) { _value(v); }
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+PropertyBuilder::Frame& PropertyBuilder::_top() {
+    if (_depth == 0) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "Event outside of beginSet/endSet");
+    }
+    return _frames[_depth - 1];
+}
+
+void PropertyBuilder::_put(Frame& frame, AnyVectorPtr const& vp) {
+    if (!frame.prefix.empty()) {
+        std::string const name = frame.prefix + frame.key;
+        if (frame.append) {
+            frame.set->_add(name, vp);
+        } else {
+            frame.set->_set(name, vp);
+        }
+    } else if (frame.append) {
+        frame.set->_add(frame.key, vp);
+    } else {
+        frame.set->_set(frame.key, vp);
+    }
+}
+
+std::unique_lock<PropertySet::Mutex> PropertyBuilder::_lockArray(Frame const& frame) const {
+    return frame.stored ? frame.set->_lockUnique() : std::unique_lock<PropertySet::Mutex>();
+}
+
+template <typename T>
+void PropertyBuilder::_value(T const& v) {
+    Frame& frame = _top();
+    if (frame.array) {
+        auto const lock = _lockArray(frame);
+        frame.array->push_back(v);
+    } else {
+        _put(frame, std::make_shared<std::vector<boost::any>>(1, boost::any(v)));
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -28,13 +28,44 @@
 #include <iomanip>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
 
 #include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/Trace.h"
 
 namespace lsst {
 namespace daf {
 namespace base {
 
+/*
+ * Changes to the order and comments made since the outermost savepoint, in
+ * the order they were made.  Rollback undoes them in reverse, which restores
+ * each change to the exact list it was made to, so the saved iterators are
+ * still valid.
+ */
+struct PropertyList::OrderLog {
+    enum Kind { PUSH, MOVE, ERASE, COMMENT };
+
+    struct Change {
+        Kind kind;
+        std::list<std::string> node;            // ERASE: the name, spliced out of _order
+        std::list<std::string>::iterator next;  // MOVE, ERASE: the name that followed it
+        std::string name;                       // COMMENT: the name commented
+        bool hadComment;                        // COMMENT: whether it had a comment
+        std::string comment;                    // COMMENT: the previous comment
+    };
+
+    Change& record(Kind kind) {
+        changes.emplace_back();
+        changes.back().kind = kind;
+        return changes.back();
+    }
+
+    std::vector<Change> changes;
+    std::vector<std::size_t> levels;  // size of changes when each savepoint started
+};
+
 /** Constructor.
  */
 PropertyList::PropertyList() : PropertySet(true) {}
@@ -48,6 +79,7 @@ PropertyList::~PropertyList() noexcept = default;
 ///////////////////////////////////////////////////////////////////////////////
 
 PropertySet::Ptr PropertyList::deepCopy() const {
+    LSST_DAF_BASE_TRACE_SPAN("PropertyList::deepCopy");
     Ptr n(new PropertyList);
     n->PropertySet::combine(this->PropertySet::deepCopy());
     n->_order = _order;
@@ -91,6 +123,7 @@ std::list<std::string>::const_iterator PropertyList::begin() const { return _ord
 std::list<std::string>::const_iterator PropertyList::end() const { return _order.end(); }
 
 std::string PropertyList::toString(bool topLevelOnly, std::string const& indent) const {
+    LSST_DAF_BASE_TRACE_SPAN("PropertyList::toString");
     std::ostringstream s;
     for (auto const& name : _order) {
         s << _format(name);
@@ -102,6 +135,17 @@ std::string PropertyList::toString(bool topLevelOnly, std::string const& indent)
     return s.str();
 }
 
+void PropertyList::walk(PropertyHandler& handler) const {
+    LSST_DAF_BASE_TRACE_SPAN("PropertyList::walk");
+    handler.beginSet(_order.size());
+    for (auto const& name : _order) {
+        handler.key(name);
+        PropertySet::walk(name, handler);
+        handler.comment(_comments.find(name)->second);
+    }
+    handler.endSet();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Modifiers
 ///////////////////////////////////////////////////////////////////////////////
@@ -117,8 +161,7 @@ void PropertyList::set(std::string const& name, T const& value) {
 void PropertyList::set(std::string const& name, PropertySet::Ptr const& value) {
     Ptr pl = std::dynamic_pointer_cast<PropertyList, PropertySet>(value);
     PropertySet::set(name, value);
-    _comments.erase(name);
-    _order.remove(name);
+    _eraseName(name);
     std::vector<std::string> paramNames = value->paramNames(false);
     if (pl) {
         for (auto const& paramName : paramNames) {
@@ -129,6 +172,10 @@ void PropertyList::set(std::string const& name, PropertySet::Ptr const& value) {
 
 void PropertyList::set(std::string const& name, char const* value) { set(name, std::string(value)); }
 
+void PropertyList::set(std::string const& name, double value, DateTime const& time) {
+    PropertySet::set(name, value, time);
+}
+
 template <typename T>
 void PropertyList::set(std::string const& name, std::vector<T> const& value) {
     PropertySet::set(name, value);
@@ -188,35 +235,111 @@ void PropertyList::copy(std::string const& dest, PropertySet::ConstPtr source, s
     PropertySet::copy(dest, source, name, asScalar);
     ConstPtr pl = std::dynamic_pointer_cast<PropertyList const, PropertySet const>(source);
     if (pl) {
-        _comments[name] = pl->_comments.find(name)->second;
+        _setComment(name, pl->_comments.find(name)->second);
     }
 }
 
 void PropertyList::combine(PropertySet::ConstPtr source) {
+    LSST_DAF_BASE_TRACE_SPAN("PropertyList::combine");
     ConstPtr pl = std::dynamic_pointer_cast<PropertyList const, PropertySet const>(source);
-    std::list<std::string> newOrder;
+    bool const empty = _order.empty();
+    auto const last = empty ? _order.end() : std::prev(_order.end());
+    PropertySet::combine(source);
     if (pl) {
-        newOrder = _order;
+        // New names were appended in the order they were added; move them into the order of pl
+        std::unordered_map<std::string, std::list<std::string>::iterator> added;
+        for (auto i = empty ? _order.begin() : std::next(last); i != _order.end(); ++i) {
+            added.emplace(*i, i);
+        }
         for (auto const& name : *pl) {
-            bool present = _comments.find(name) != _comments.end();
-            if (!present) {
-                newOrder.push_back(name);
+            auto const j = added.find(name);
+            if (j != added.end()) {
+                _moveName(j->second);
             }
         }
-    }
-    PropertySet::combine(source);
-    if (pl) {
-        _order = newOrder;
         for (auto const& name : *pl) {
-            _comments[name] = pl->_comments.find(name)->second;
+            _setComment(name, pl->_comments.find(name)->second);
         }
     }
 }
 
 void PropertyList::remove(std::string const& name) {
     PropertySet::remove(name);
-    _comments.erase(name);
-    _order.remove(name);
+    _eraseName(name);
+}
+
+std::size_t PropertyList::remove(std::vector<std::string> const& names) {
+    std::size_t const count = PropertySet::remove(names);
+    if (count > 0) {
+        _compactOrder();
+    }
+    return count;
+}
+
+std::size_t PropertyList::removeIf(RemovePredicate const& predicate) {
+    std::size_t count;
+    try {
+        count = PropertySet::removeIf(predicate);
+    } catch (...) {
+        _compactOrder();
+        throw;
+    }
+    if (count > 0) {
+        _compactOrder();
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Savepoints
+///////////////////////////////////////////////////////////////////////////////
+
+void PropertyList::savepoint() {
+    PropertySet::savepoint();
+    if (!_orderLog) {
+        _orderLog.reset(new OrderLog);
+    }
+    _orderLog->levels.push_back(_orderLog->changes.size());
+}
+
+void PropertyList::rollback() {
+    PropertySet::rollback();
+    auto& changes = _orderLog->changes;
+    std::size_t const begin = _orderLog->levels.back();
+    for (std::size_t i = changes.size(); i > begin; --i) {
+        OrderLog::Change& change = changes[i - 1];
+        switch (change.kind) {
+            case OrderLog::PUSH:
+                _order.pop_back();
+                break;
+            case OrderLog::MOVE:
+                _order.splice(change.next, _order, std::prev(_order.end()));
+                break;
+            case OrderLog::ERASE:
+                _order.splice(change.next, change.node);
+                break;
+            case OrderLog::COMMENT:
+                if (change.hadComment) {
+                    _comments[change.name] = std::move(change.comment);
+                } else {
+                    _comments.erase(change.name);
+                }
+                break;
+        }
+    }
+    changes.erase(changes.begin() + begin, changes.end());
+    _orderLog->levels.pop_back();
+    if (_orderLog->levels.empty()) {
+        _orderLog.reset();
+    }
+}
+
+void PropertyList::release() {
+    PropertySet::release();
+    _orderLog->levels.pop_back();
+    if (_orderLog->levels.empty()) {
+        _orderLog.reset();
+    }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -226,18 +349,107 @@ void PropertyList::remove(std::string const& name) {
 void PropertyList::_set(std::string const& name, std::shared_ptr<std::vector<boost::any> > vp) {
     PropertySet::_set(name, vp);
     if (_comments.find(name) == _comments.end()) {
-        _comments.insert(std::make_pair(name, std::string()));
-        _order.push_back(name);
+        _pushName(name);
     }
 }
 
 void PropertyList::_moveToEnd(std::string const& name) {
-    _order.remove(name);
-    _order.push_back(name);
+    auto const i = std::find(_order.begin(), _order.end(), name);
+    if (i == _order.end()) {
+        _order.push_back(name);
+        if (_orderLog) {
+            _orderLog->record(OrderLog::PUSH);
+        }
+    } else {
+        _moveName(i);
+    }
 }
 
 void PropertyList::_commentOrderFix(std::string const& name, std::string const& comment) {
-    _comments[name] = comment;
+    _setComment(name, comment);
+}
+
+void PropertyList::_compactOrder() {
+    for (auto i = _order.begin(); i != _order.end();) {
+        auto const next = std::next(i);
+        if (!PropertySet::exists(*i)) {
+            _eraseName(i);
+        }
+        i = next;
+    }
+}
+
+void PropertyList::_pushName(std::string const& name) {
+    _setComment(name, std::string());
+    _order.push_back(name);
+    if (_orderLog) {
+        _orderLog->record(OrderLog::PUSH);
+    }
+}
+
+void PropertyList::_moveName(std::list<std::string>::iterator i) {
+    auto const next = std::next(i);
+    if (next == _order.end()) {
+        return;
+    }
+    if (_orderLog) {
+        _orderLog->record(OrderLog::MOVE).next = next;
+    }
+    _order.splice(_order.end(), _order, i);
+}
+
+void PropertyList::_eraseName(std::list<std::string>::iterator i) {
+    _eraseComment(*i);
+    if (_orderLog) {
+        OrderLog::Change& change = _orderLog->record(OrderLog::ERASE);
+        change.next = std::next(i);
+        change.node.splice(change.node.end(), _order, i);
+    } else {
+        _order.erase(i);
+    }
+}
+
+void PropertyList::_eraseName(std::string const& name) {
+    auto const i = std::find(_order.begin(), _order.end(), name);
+    if (i == _order.end()) {
+        _eraseComment(name);  // copy may comment a name that is not in the order
+    } else {
+        _eraseName(i);
+    }
+}
+
+void PropertyList::_setComment(std::string const& name, std::string const& comment) {
+    auto const i = _comments.find(name);
+    if (_orderLog) {
+        if (i != _comments.end() && i->second == comment) {
+            return;
+        }
+        OrderLog::Change& change = _orderLog->record(OrderLog::COMMENT);
+        change.name = name;
+        change.hadComment = i != _comments.end();
+        if (change.hadComment) {
+            change.comment = std::move(i->second);
+        }
+    }
+    if (i == _comments.end()) {
+        _comments.emplace(name, comment);
+    } else {
+        i->second = comment;
+    }
+}
+
+void PropertyList::_eraseComment(std::string const& name) {
+    auto const i = _comments.find(name);
+    if (i == _comments.end()) {
+        return;
+    }
+    if (_orderLog) {
+        OrderLog::Change& change = _orderLog->record(OrderLog::COMMENT);
+        change.name = name;
+        change.hadComment = true;
+        change.comment = std::move(i->second);
+    }
+    _comments.erase(i);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,697 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/PropertyPredicate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#include "boost/any.hpp"
+#include "boost/regex.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/detail/parallelFor.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Evaluation uses fixed-size buffers on the stack for expressions within these limits
+std::size_t const SMALL_SLOTS = 16;
+std::size_t const SMALL_STACK = 32;
+
+// Fewest containers worth evaluating in a separate thread
+std::size_t const MIN_PER_THREAD = 256;
+
+template <typename T>
+bool compare(T const& lhs, T const& rhs, int cmp) {
+    switch (cmp) {
+        case 0:  // EQ
+            return lhs == rhs;
+        case 1:  // NE
+            return lhs != rhs;
+        case 2:  // LT
+            return lhs < rhs;
+        case 3:  // LE
+            return lhs <= rhs;
+        case 4:  // GT
+            return lhs > rhs;
+        default:  // GE
+            return lhs >= rhs;
+    }
+}
+
+struct Token {
+    enum Kind {
+        NAME,
+        STRING,
+        NUMBER,
+        LPAREN,
+        RPAREN,
+        COMMA,
+        OPERATOR,
+        AND,
+        OR,
+        NOT,
+        IN,
+        TRUE,
+        FALSE,
+        EXISTS,
+        END
+    };
+
+    Kind kind;
+    std::string text;
+    std::size_t position;
+    int cmp;  // comparison, for OPERATOR
+};
+
+bool isNameStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+bool isNameChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.' || c == '-';
+}
+bool isDigit(char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
+
+}  // namespace
+
+struct PropertyPredicate::Value {
+    enum Kind : std::uint8_t { MISSING, BOOL, INTEGER, NUMBER, STRING, DATE, OTHER };
+
+    Kind kind;
+    long long integer;          // BOOL, INTEGER, and DATE (TAI nanoseconds)
+    double number;              // INTEGER and NUMBER
+    std::string const* string;  // STRING; refers to the value in the container, or to copy
+    std::string copy;           // STRING from a concurrent set, which may change once unlocked
+};
+
+/**
+ * Recursive descent parser generating the code of a PropertyPredicate
+ */
+class PropertyPredicate::Parser {
+public:
+    explicit Parser(PropertyPredicate& predicate)
+            : _predicate(predicate), _expression(predicate._expression), _next(0), _depth(0) {
+        _tokenize();
+    }
+
+    void parse() {
+        _parseOr();
+        _expect(Token::END, "end of expression");
+    }
+
+private:
+    // An operand of a comparison: a slot or a literal
+    struct Operand {
+        bool isName;
+        std::uint32_t index;
+    };
+
+    [[noreturn]] void _fail(std::size_t position, std::string const& message) const {
+        std::ostringstream os;
+        os << "Error at position " << position << " of '" << _expression << "': " << message;
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, os.str());
+    }
+
+    void _tokenize() {
+        std::string const& s = _expression;
+        std::size_t i = 0;
+        while (true) {
+            while (i < s.size() && std::isspace(static_cast<unsigned char>(s[i]))) {
+                ++i;
+            }
+            Token token{Token::END, std::string(), i, 0};
+            if (i == s.size()) {
+                _tokens.push_back(token);
+                return;
+            }
+            char const c = s[i];
+            char const next = i + 1 < s.size() ? s[i + 1] : '\0';
+            if (isNameStart(c)) {
+                std::size_t const start = i;
+                while (i < s.size() && isNameChar(s[i])) {
+                    ++i;
+                }
+                token.text = s.substr(start, i - start);
+                std::string lower(token.text);
+                std::transform(lower.begin(), lower.end(), lower.begin(),
+                               [](char ch) { return std::tolower(static_cast<unsigned char>(ch)); });
+                token.kind = lower == "and"      ? Token::AND
+                             : lower == "or"     ? Token::OR
+                             : lower == "not"    ? Token::NOT
+                             : lower == "in"     ? Token::IN
+                             : lower == "true"   ? Token::TRUE
+                             : lower == "false"  ? Token::FALSE
+                             : lower == "exists" ? Token::EXISTS
+                                                 : Token::NAME;
+            } else if (c == '`') {
+                std::size_t const end = s.find('`', i + 1);
+                if (end == std::string::npos) {
+                    _fail(i, "unterminated quoted name");
+                }
+                token.kind = Token::NAME;
+                token.text = s.substr(i + 1, end - i - 1);
+                i = end + 1;
+            } else if (c == '\'' || c == '"') {
+                token.kind = Token::STRING;
+                for (++i; i < s.size() && s[i] != c; ++i) {
+                    if (s[i] == '\\' && i + 1 < s.size()) {
+                        ++i;
+                    }
+                    token.text += s[i];
+                }
+                if (i == s.size()) {
+                    _fail(token.position, "unterminated string");
+                }
+                ++i;
+            } else if (isDigit(c) || ((c == '-' || c == '+' || c == '.') && (isDigit(next) || next == '.'))) {
+                char* end;
+                std::strtod(s.c_str() + i, &end);
+                std::size_t const length = end - (s.c_str() + i);
+                if (length == 0) {
+                    _fail(i, "invalid number");
+                }
+                token.kind = Token::NUMBER;
+                token.text = s.substr(i, length);
+                i += length;
+            } else if (c == '(' || c == ')' || c == ',') {
+                token.kind = c == '(' ? Token::LPAREN : c == ')' ? Token::RPAREN : Token::COMMA;
+                ++i;
+            } else if (c == '=' || c == '!' || c == '<' || c == '>') {
+                token.kind = Token::OPERATOR;
+                if (next == '=') {
+                    token.cmp = c == '=' ? EQ : c == '!' ? NE : c == '<' ? LE : GE;
+                    i += 2;
+                } else if (c == '<' || c == '>') {
+                    token.cmp = c == '<' ? LT : GT;
+                    ++i;
+                } else if (c == '=') {
+                    token.cmp = EQ;
+                    ++i;
+                } else {
+                    _fail(i, "unexpected '!'");
+                }
+            } else {
+                _fail(i, std::string("unexpected '") + c + "'");
+            }
+            _tokens.push_back(token);
+        }
+    }
+
+    Token const& _peek(std::size_t offset = 0) const {
+        return _tokens[std::min(_next + offset, _tokens.size() - 1)];
+    }
+
+    Token const& _expect(Token::Kind kind, char const* what) {
+        Token const& token = _peek();
+        if (token.kind != kind) {
+            _fail(token.position, std::string("expected ") + what);
+        }
+        ++_next;
+        return token;
+    }
+
+    std::size_t _emit(OpCode op, std::uint32_t a = 0, std::uint32_t b = 0, Comparison cmp = EQ) {
+        switch (op) {
+            case OpCode::NOT:
+                break;
+            case OpCode::AND:
+            case OpCode::OR:
+                --_depth;  // when not jumping
+                break;
+            default:
+                _predicate._maxDepth = std::max(_predicate._maxDepth, ++_depth);
+                break;
+        }
+        _predicate._code.push_back(Instruction{op, cmp, a, b});
+        return _predicate._code.size() - 1;
+    }
+
+    void _parseOr() {
+        _parseAnd();
+        while (_peek().kind == Token::OR) {
+            ++_next;
+            std::size_t const jump = _emit(OpCode::OR);
+            _parseAnd();
+            _predicate._code[jump].a = _predicate._code.size();
+        }
+    }
+
+    void _parseAnd() {
+        _parseNot();
+        while (_peek().kind == Token::AND) {
+            ++_next;
+            std::size_t const jump = _emit(OpCode::AND);
+            _parseNot();
+            _predicate._code[jump].a = _predicate._code.size();
+        }
+    }
+
+    void _parseNot() {
+        if (_peek().kind == Token::NOT) {
+            ++_next;
+            _parseNot();
+            _emit(OpCode::NOT);
+        } else {
+            _parseAtom();
+        }
+    }
+
+    void _parseAtom() {
+        Token const& token = _peek();
+        if (token.kind == Token::LPAREN) {
+            ++_next;
+            _parseOr();
+            _expect(Token::RPAREN, "')'");
+            return;
+        }
+        if (token.kind == Token::EXISTS) {
+            ++_next;
+            _expect(Token::LPAREN, "'('");
+            std::uint32_t const slot = _slot(_expect(Token::NAME, "a name").text);
+            _expect(Token::RPAREN, "')'");
+            _emit(OpCode::EXISTS, slot);
+            return;
+        }
+        Operand const lhs = _parseOperand();
+        Token const& next = _peek();
+        if (next.kind == Token::OPERATOR) {
+            ++_next;
+            Operand const rhs = _parseOperand();
+            _emitComparison(lhs, static_cast<Comparison>(next.cmp), rhs, next.position);
+        } else if (next.kind == Token::IN || (next.kind == Token::NOT && _peek(1).kind == Token::IN)) {
+            bool const negate = next.kind == Token::NOT;
+            if (!lhs.isName) {
+                _fail(token.position, "expected a name before 'in'");
+            }
+            _next += negate ? 2 : 1;
+            _emit(OpCode::IN, lhs.index, _parseSet());
+            if (negate) {
+                _emit(OpCode::NOT);
+            }
+        } else if (lhs.isName) {
+            _emit(OpCode::TRUTH, lhs.index);
+        } else {
+            Literal const& literal = _predicate._literals[lhs.index];
+            if (!literal.isNumber) {
+                _fail(token.position, "expected a comparison");
+            }
+            _emit(OpCode::CONSTANT, literal.number != 0.0);
+        }
+    }
+
+    Operand _parseOperand() {
+        Token const& token = _peek();
+        ++_next;
+        switch (token.kind) {
+            case Token::NAME:
+                return Operand{true, _slot(token.text)};
+            case Token::STRING:
+            case Token::NUMBER:
+            case Token::TRUE:
+            case Token::FALSE:
+                _predicate._literals.push_back(_makeLiteral(token));
+                return Operand{false, static_cast<std::uint32_t>(_predicate._literals.size() - 1)};
+            default:
+                _fail(token.position, "expected a name or a value");
+        }
+    }
+
+    std::uint32_t _parseSet() {
+        _expect(Token::LPAREN, "'('");
+        LiteralSet set;
+        do {
+            Token const& token = _peek();
+            ++_next;
+            if (token.kind != Token::STRING && token.kind != Token::NUMBER && token.kind != Token::TRUE &&
+                token.kind != Token::FALSE) {
+                _fail(token.position, "expected a value");
+            }
+            Literal const literal = _makeLiteral(token);
+            if (literal.isString) {
+                set.strings.insert(literal.string);
+            }
+            if (literal.isDate) {
+                set.dates.push_back(literal.date);
+            }
+            if (literal.isNumber) {
+                set.numbers.push_back(literal.number);
+            }
+            if (literal.isInteger) {
+                set.integers.push_back(literal.integer);
+            }
+        } while (_peek().kind == Token::COMMA && (++_next, true));
+        _expect(Token::RPAREN, "')'");
+        std::sort(set.integers.begin(), set.integers.end());
+        std::sort(set.numbers.begin(), set.numbers.end());
+        std::sort(set.dates.begin(), set.dates.end());
+        _predicate._sets.push_back(std::move(set));
+        return static_cast<std::uint32_t>(_predicate._sets.size() - 1);
+    }
+
+    void _emitComparison(Operand const& lhs, Comparison cmp, Operand const& rhs, std::size_t position) {
+        // Order of the operands is reversed by swapping the direction of the comparison
+        static Comparison const reversed[] = {EQ, NE, GT, GE, LT, LE};
+        if (lhs.isName && rhs.isName) {
+            _emit(OpCode::COMPARE_SLOTS, lhs.index, rhs.index, cmp);
+        } else if (lhs.isName) {
+            _emit(OpCode::COMPARE_LITERAL, lhs.index, rhs.index, cmp);
+        } else if (rhs.isName) {
+            _emit(OpCode::COMPARE_LITERAL, rhs.index, lhs.index, reversed[cmp]);
+        } else {
+            // Two literals: evaluate now
+            Value value;
+            Literal const& literal = _predicate._literals[lhs.index];
+            if (literal.isNumber) {
+                value.kind = literal.isInteger ? Value::INTEGER : Value::NUMBER;
+                value.integer = literal.integer;
+                value.number = literal.number;
+            } else {
+                value.kind = Value::STRING;
+                value.string = &literal.string;
+            }
+            _emit(OpCode::CONSTANT, _predicate._compare(value, cmp, _predicate._literals[rhs.index]));
+        }
+    }
+
+    std::uint32_t _slot(std::string const& name) {
+        auto const i = _slots.find(name);
+        if (i != _slots.end()) {
+            return i->second;
+        }
+        _predicate._names.push_back(name);
+        std::uint32_t const slot = static_cast<std::uint32_t>(_predicate._names.size() - 1);
+        _slots.emplace(name, slot);
+        return slot;
+    }
+
+    // Convert a literal to each of the forms it may be compared in
+    Literal _makeLiteral(Token const& token) const {
+        Literal literal{token.text, false, false, false, false, 0, 0.0, 0};
+        if (token.kind == Token::TRUE || token.kind == Token::FALSE) {
+            literal.isNumber = literal.isInteger = true;
+            literal.integer = token.kind == Token::TRUE;
+            literal.number = literal.integer;
+        } else if (token.kind == Token::NUMBER) {
+            literal.isNumber = true;
+            literal.number = std::strtod(token.text.c_str(), nullptr);
+            if (token.text.find_first_of(".eE") == std::string::npos) {
+                errno = 0;
+                literal.integer = std::strtoll(token.text.c_str(), nullptr, 10);
+                literal.isInteger = errno == 0;
+            } else if (literal.number == static_cast<double>(static_cast<long long>(literal.number))) {
+                literal.integer = static_cast<long long>(literal.number);
+                literal.isInteger = true;
+            }
+        } else {
+            literal.isString = true;
+            static boost::regex const dateOnly("\\d{4}-?\\d{2}-?\\d{2}");
+            static boost::regex const dateTime("\\d{4}-?\\d{2}-?\\d{2}T.*");
+            std::string iso;
+            if (boost::regex_match(token.text, dateOnly)) {
+                iso = token.text + "T00:00:00";
+            } else if (boost::regex_match(token.text, dateTime)) {
+                iso = token.text;
+            }
+            if (!iso.empty()) {
+                try {
+                    bool const utc = iso.back() == 'Z';
+                    literal.date = DateTime(iso, utc ? DateTime::UTC : DateTime::TAI).nsecs();
+                    literal.isDate = true;
+                } catch (pex::exceptions::Exception const&) {
+                    // not a date after all
+                }
+            }
+        }
+        return literal;
+    }
+
+    PropertyPredicate& _predicate;
+    std::string const& _expression;
+    std::vector<Token> _tokens;
+    std::size_t _next;  // index of the next token
+    std::size_t _depth;  // depth of the evaluation stack after the code generated so far
+    std::unordered_map<std::string, std::uint32_t> _slots;
+};
+
+PropertyPredicate::PropertyPredicate(std::string const& expression) : _expression(expression), _maxDepth(0) {
+    Parser(*this).parse();
+}
+
+PropertyPredicate::~PropertyPredicate() noexcept = default;
+PropertyPredicate::PropertyPredicate(PropertyPredicate const&) = default;
+PropertyPredicate::PropertyPredicate(PropertyPredicate&&) = default;
+PropertyPredicate& PropertyPredicate::operator=(PropertyPredicate const&) = default;
+PropertyPredicate& PropertyPredicate::operator=(PropertyPredicate&&) = default;
+
+bool PropertyPredicate::operator()(PropertySet const& properties) const {
+    std::size_t const nSlots = _names.size();
+    if (nSlots <= SMALL_SLOTS && _maxDepth <= SMALL_STACK) {
+        Value slots[SMALL_SLOTS];
+        bool resolved[SMALL_SLOTS];
+        bool stack[SMALL_STACK];
+        std::fill_n(resolved, nSlots, false);
+        return _evaluate(properties, slots, resolved, stack);
+    }
+    std::unique_ptr<Value[]> slots(new Value[nSlots]);
+    std::unique_ptr<bool[]> resolved(new bool[nSlots]());
+    std::unique_ptr<bool[]> stack(new bool[_maxDepth]);
+    return _evaluate(properties, slots.get(), resolved.get(), stack.get());
+}
+
+std::vector<bool> PropertyPredicate::operator()(std::vector<PropertySet::ConstPtr> const& properties,
+                                                int nThreads) const {
+    for (auto const& p : properties) {
+        if (!p) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Null PropertySet");
+        }
+    }
+    std::vector<char> results(properties.size());
+    detail::parallelFor(properties.size(), nThreads, MIN_PER_THREAD, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            results[i] = (*this)(*properties[i]);
+        }
+    });
+    return std::vector<bool>(results.begin(), results.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+void PropertyPredicate::_resolve(PropertySet const& properties, std::string const& name, Value& value) {
+    auto const i = properties._find(name);
+    if (i == nullptr) {
+        value.kind = Value::MISSING;
+        return;
+    }
+    boost::any const& any = i->second->back();
+    auto setInteger = [&value](long long v) {
+        value.kind = Value::INTEGER;
+        value.integer = v;
+        value.number = static_cast<double>(v);
+    };
+    auto setNumber = [&value](double v) {
+        value.kind = Value::NUMBER;
+        value.number = v;
+    };
+    // Most common types first
+    if (auto p = boost::any_cast<int>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<double>(&any)) {
+        setNumber(*p);
+    } else if (auto p = boost::any_cast<std::string>(&any)) {
+        value.kind = Value::STRING;
+        if (i.isLocked()) {
+            value.copy = *p;
+            value.string = &value.copy;
+        } else {
+            value.string = p;
+        }
+    } else if (auto p = boost::any_cast<long long>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<long>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<bool>(&any)) {
+        value.kind = Value::BOOL;
+        value.integer = *p;
+        value.number = *p;
+    } else if (auto p = boost::any_cast<float>(&any)) {
+        setNumber(*p);
+    } else if (auto p = boost::any_cast<DateTime>(&any)) {
+        if (p->isValid()) {
+            value.kind = Value::DATE;
+            value.integer = p->nsecs();
+        } else {
+            value.kind = Value::OTHER;
+        }
+    } else if (auto p = boost::any_cast<short>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<unsigned int>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<unsigned short>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<signed char>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<unsigned char>(&any)) {
+        setInteger(*p);
+    } else if (auto p = boost::any_cast<unsigned long>(&any)) {
+        if (*p <= static_cast<unsigned long>(std::numeric_limits<long long>::max())) {
+            setInteger(static_cast<long long>(*p));
+        } else {
+            setNumber(static_cast<double>(*p));
+        }
+    } else if (auto p = boost::any_cast<unsigned long long>(&any)) {
+        if (*p <= static_cast<unsigned long long>(std::numeric_limits<long long>::max())) {
+            setInteger(static_cast<long long>(*p));
+        } else {
+            setNumber(static_cast<double>(*p));
+        }
+    } else {
+        value.kind = Value::OTHER;
+    }
+}
+
+bool PropertyPredicate::_evaluate(PropertySet const& properties, Value* slots, bool* resolved,
+                                  bool* stack) const {
+    auto slot = [&](std::uint32_t i) -> Value const& {
+        if (!resolved[i]) {
+            _resolve(properties, _names[i], slots[i]);
+            resolved[i] = true;
+        }
+        return slots[i];
+    };
+    std::size_t top = 0;  // number of values on the stack
+    std::size_t const size = _code.size();
+    for (std::size_t pc = 0; pc < size;) {
+        Instruction const& instruction = _code[pc++];
+        switch (instruction.op) {
+            case OpCode::CONSTANT:
+                stack[top++] = instruction.a != 0;
+                break;
+            case OpCode::TRUTH: {
+                Value const& value = slot(instruction.a);
+                stack[top++] = (value.kind == Value::BOOL || value.kind == Value::INTEGER)
+                                       ? value.integer != 0
+                                       : value.kind == Value::NUMBER && value.number != 0.0;
+                break;
+            }
+            case OpCode::EXISTS:
+                stack[top++] = slot(instruction.a).kind != Value::MISSING;
+                break;
+            case OpCode::COMPARE_LITERAL:
+                stack[top++] = _compare(slot(instruction.a), instruction.cmp, _literals[instruction.b]);
+                break;
+            case OpCode::COMPARE_SLOTS:
+                stack[top++] = _compare(slot(instruction.a), instruction.cmp, slot(instruction.b));
+                break;
+            case OpCode::IN:
+                stack[top++] = _contains(_sets[instruction.b], slot(instruction.a));
+                break;
+            case OpCode::NOT:
+                stack[top - 1] = !stack[top - 1];
+                break;
+            case OpCode::AND:
+                if (stack[top - 1]) {
+                    --top;
+                } else {
+                    pc = instruction.a;
+                }
+                break;
+            case OpCode::OR:
+                if (stack[top - 1]) {
+                    pc = instruction.a;
+                } else {
+                    --top;
+                }
+                break;
+        }
+    }
+    return stack[0];
+}
+
+bool PropertyPredicate::_compare(Value const& value, Comparison cmp, Literal const& literal) const {
+    switch (value.kind) {
+        case Value::BOOL:
+        case Value::INTEGER:
+            if (literal.isInteger) {
+                return compare(value.integer, literal.integer, cmp);
+            }
+            return literal.isNumber && compare(value.number, literal.number, cmp);
+        case Value::NUMBER:
+            return literal.isNumber && compare(value.number, literal.number, cmp);
+        case Value::STRING:
+            return literal.isString && compare(value.string->compare(literal.string), 0, cmp);
+        case Value::DATE:
+            return literal.isDate && compare(value.integer, literal.date, cmp);
+        default:
+            return false;
+    }
+}
+
+bool PropertyPredicate::_compare(Value const& lhs, Comparison cmp, Value const& rhs) {
+    bool const lhsIntegral = lhs.kind == Value::BOOL || lhs.kind == Value::INTEGER;
+    bool const rhsIntegral = rhs.kind == Value::BOOL || rhs.kind == Value::INTEGER;
+    if (lhsIntegral && rhsIntegral) {
+        return compare(lhs.integer, rhs.integer, cmp);
+    }
+    if ((lhsIntegral || lhs.kind == Value::NUMBER) && (rhsIntegral || rhs.kind == Value::NUMBER)) {
+        return compare(lhs.number, rhs.number, cmp);
+    }
+    if (lhs.kind == Value::STRING && rhs.kind == Value::STRING) {
+        return compare(lhs.string->compare(*rhs.string), 0, cmp);
+    }
+    if (lhs.kind == Value::DATE && rhs.kind == Value::DATE) {
+        return compare(lhs.integer, rhs.integer, cmp);
+    }
+    return false;
+}
+
+bool PropertyPredicate::_contains(LiteralSet const& set, Value const& value) {
+    switch (value.kind) {
+        case Value::BOOL:
+        case Value::INTEGER:
+            return std::binary_search(set.integers.begin(), set.integers.end(), value.integer);
+        case Value::NUMBER:
+            return std::binary_search(set.numbers.begin(), set.numbers.end(), value.number);
+        case Value::STRING:
+            return set.strings.count(*value.string) > 0;
+        case Value::DATE:
+            return std::binary_search(set.dates.begin(), set.dates.end(), value.integer);
+        default:
+            return false;
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -26,11 +26,19 @@
 
 #include <algorithm>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "lsst/pex/exceptions/Runtime.h"
 #include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/TimeSeries.h"
+#include "lsst/daf/base/Trace.h"
+#include "lsst/daf/base/detail/hashing.h"
 
 namespace lsst {
 namespace daf {
@@ -38,6 +46,12 @@ namespace base {
 
 namespace {
 
+// Lock a concurrent set, or do nothing if mutex is null
+template <typename Lock>
+Lock _lock(std::unique_ptr<std::shared_timed_mutex> const& mutex) {
+    return mutex ? Lock(*mutex) : Lock();
+}
+
 /**
  * Append the contents of a vector<T> to a vector<boost::any>
  *
@@ -52,18 +66,274 @@ void _append(std::vector<boost::any>& dest, std::vector<T> const& src) {
     }
 }
 
+/**
+ * Send the values of a vector<boost::any> of known element type to a handler
+ */
+template <typename T>
+void _emitValues(std::vector<boost::any> const& v, PropertyHandler& handler) {
+    if (v.size() == 1) {
+        handler.value(*boost::any_cast<T>(&v.front()));
+        return;
+    }
+    handler.beginArray(v.size());
+    for (auto const& i : v) {
+        handler.value(*boost::any_cast<T>(&i));
+    }
+    handler.endArray();
+}
+
+void _emitSet(PropertySet::Ptr const& p, PropertyHandler& handler) {
+    if (p.get() == 0) {
+        handler.beginSet(0);
+        handler.endSet();
+    } else {
+        p->walk(handler);
+    }
+}
+
+/**
+ * Send the values of a property to a handler, dispatching on the element type once
+ */
+void _emit(std::vector<boost::any> const& v, PropertyHandler& handler) {
+    std::type_info const& t = v.back().type();
+    if (t == typeid(PropertySet::Ptr)) {
+        if (v.size() == 1) {
+            _emitSet(*boost::any_cast<PropertySet::Ptr>(&v.front()), handler);
+            return;
+        }
+        handler.beginArray(v.size());
+        for (auto const& i : v) {
+            _emitSet(*boost::any_cast<PropertySet::Ptr>(&i), handler);
+        }
+        handler.endArray();
+    } else if (t == typeid(bool)) {
+        _emitValues<bool>(v, handler);
+    } else if (t == typeid(char)) {
+        _emitValues<char>(v, handler);
+    } else if (t == typeid(signed char)) {
+        _emitValues<signed char>(v, handler);
+    } else if (t == typeid(unsigned char)) {
+        _emitValues<unsigned char>(v, handler);
+    } else if (t == typeid(short)) {
+        _emitValues<short>(v, handler);
+    } else if (t == typeid(unsigned short)) {
+        _emitValues<unsigned short>(v, handler);
+    } else if (t == typeid(int)) {
+        _emitValues<int>(v, handler);
+    } else if (t == typeid(unsigned int)) {
+        _emitValues<unsigned int>(v, handler);
+    } else if (t == typeid(long)) {
+        _emitValues<long>(v, handler);
+    } else if (t == typeid(unsigned long)) {
+        _emitValues<unsigned long>(v, handler);
+    } else if (t == typeid(long long)) {
+        _emitValues<long long>(v, handler);
+    } else if (t == typeid(unsigned long long)) {
+        _emitValues<unsigned long long>(v, handler);
+    } else if (t == typeid(float)) {
+        _emitValues<float>(v, handler);
+    } else if (t == typeid(double)) {
+        _emitValues<double>(v, handler);
+    } else if (t == typeid(std::nullptr_t)) {
+        _emitValues<std::nullptr_t>(v, handler);
+    } else if (t == typeid(std::string)) {
+        _emitValues<std::string>(v, handler);
+    } else if (t == typeid(DateTime)) {
+        _emitValues<DateTime>(v, handler);
+    } else if (t == typeid(Persistable::Ptr)) {
+        _emitValues<Persistable::Ptr>(v, handler);
+    } else {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, std::string("Unknown value type ") + t.name());
+    }
+}
+
+/**
+ * Handler that formats values in human-readable form; used by _format
+ */
+class Formatter : public PropertyHandler {
+public:
+    explicit Formatter(std::ostream& os) : _os(os), _first(true), _depth(0) {}
+
+    void beginSet(std::size_t) override {
+        if (_depth++ == 0) {
+            _separate();
+            _os << "{ ... }";
+        }
+    }
+    void endSet() override { --_depth; }
+    void beginArray(std::size_t) override {
+        if (_depth == 0) _os << "[ ";
+    }
+    void endArray() override {
+        if (_depth == 0) _os << " ]";
+    }
+
+    void value(bool v) override { _write(v); }
+    void value(char v) override { _writeChar(v); }
+    void value(signed char v) override { _writeChar(v); }
+    void value(unsigned char v) override { _writeChar(v); }
+    void value(short v) override { _write(v); }
+    void value(unsigned short v) override { _write(v); }
+    void value(int v) override { _write(v); }
+    void value(unsigned int v) override { _write(v); }
+    void value(long v) override { _write(v); }
+    void value(unsigned long v) override { _write(v); }
+    void value(long long v) override { _write(v); }
+    void value(unsigned long long v) override { _write(v); }
+    void value(float v) override {
+        if (_depth == 0) {
+            _separate();
+            _os << std::setprecision(7) << v;
+        }
+    }
+    void value(double v) override {
+        if (_depth == 0) {
+            _separate();
+            _os << std::setprecision(14) << v;
+        }
+    }
+    void value(std::nullptr_t) override { _write("<Unknown>"); }
+    void value(std::string const& v) override {
+        if (_depth == 0) {
+            _separate();
+            _os << '"' << v << '"';
+        }
+    }
+    void value(DateTime const& v) override { _write(v.toString(DateTime::UTC)); }
+    void value(Persistable::Ptr const&) override { _write("<Persistable>"); }
+
+private:
+    void _separate() {
+        if (_first) {
+            _first = false;
+        } else {
+            _os << ", ";
+        }
+    }
+
+    template <typename T>
+    void _write(T const& v) {
+        if (_depth == 0) {
+            _separate();
+            _os << v;
+        }
+    }
+
+    template <typename T>
+    void _writeChar(T v) {
+        if (_depth == 0) {
+            _separate();
+            _os << '\'' << v << '\'';
+        }
+    }
+
+    std::ostream& _os;
+    bool _first;
+    int _depth;
+};
+
+/**
+ * Parse an ISO8601 date for getAsDateTime, accepting the forms found in FITS headers
+ */
+DateTime _parseDate(std::string const& name, std::string const& value, DateTime::Timescale scale) {
+    std::string iso = value;
+    if (iso.size() == 10) {
+        iso += "T00:00:00";  // date alone
+    }
+    if (scale == DateTime::UTC && !iso.empty() && iso.back() != 'Z') {
+        iso += 'Z';
+    }
+    try {
+        return DateTime(iso, scale);
+    } catch (pex::exceptions::DomainError const&) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, name + " value \"" + value + "\" is not a date");
+    }
+}
+
 }  // namespace
 
-PropertySet::PropertySet(bool flat) : _flat(flat) {}
+/**
+ * Conversions made by getAsDateTime, by property name
+ *
+ * An entry is only used while the property still holds the same vector of
+ * values with the same size, which changes whenever it is set, added to or
+ * removed.  The weak_ptr keeps the vector's control block, so a new vector
+ * cannot be mistaken for the one that was converted.  Each entry holds one
+ * conversion per time scale.
+ */
+struct PropertySet::DateTimeCache {
+    struct Entry {
+        bool isFor(std::shared_ptr<std::vector<boost::any>> const& vp) const {
+            return size == vp->size() && !values.owner_before(vp) && !vp.owner_before(values);
+        }
+
+        std::weak_ptr<std::vector<boost::any>> values;
+        std::size_t size = 0;
+        unsigned scales = 0;  // bit mask of the scales converted, by offset from TAI
+        DateTime value[3];    // by offset of the scale from TAI
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+};
+
+/*
+ * Changes made since the outermost savepoint.
+ *
+ * Each level of nesting records a property, or a TimeSeries, at most once,
+ * before its first change: that is the state to restore, whatever happens to
+ * it later.  Rollback restores the records of its level in reverse order;
+ * release hands them to the enclosing level.
+ */
+struct PropertySet::UndoLog {
+    // A property before its first change in a level
+    struct Value {
+        PropertySet* owner;  // set holding the property
+        Ptr hold;            // owner, if it is a subproperty, kept alive until rollback
+        std::string key;
+        std::shared_ptr<std::vector<boost::any>> values;  // null if the property did not exist
+        std::size_t size;  // number of values then; more may have been appended since
+    };
+
+    // A TimeSeries before its first new sample in a level
+    struct Series {
+        std::shared_ptr<TimeSeries> live;
+        TimeSeries saved;
+    };
+
+    typedef std::pair<PropertySet const*, std::string> Key;
+
+    struct KeyHash {
+        std::size_t operator()(Key const& key) const {
+            return detail::mix64(std::hash<std::string>()(key.second) ^
+                                 reinterpret_cast<std::uintptr_t>(key.first));
+        }
+    };
 
-PropertySet::~PropertySet() noexcept = default;
+    struct Level {
+        std::size_t values;  // sizes of the logs when the savepoint started
+        std::size_t series;
+        std::unordered_set<Key, KeyHash> touched;
+        std::unordered_set<TimeSeries const*> touchedSeries;
+    };
+
+    std::vector<Value> values;
+    std::vector<Series> series;
+    std::vector<Level> levels;
+};
+
+PropertySet::PropertySet(bool flat) : _flat(flat), _dateTimeCache(nullptr) {}
+
+PropertySet::~PropertySet() noexcept { delete _dateTimeCache.load(); }
 
 ///////////////////////////////////////////////////////////////////////////////
 // Accessors
 ///////////////////////////////////////////////////////////////////////////////
 
 PropertySet::Ptr PropertySet::deepCopy() const {
-    Ptr n(new PropertySet(_flat));
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::deepCopy");
+    auto n = std::make_shared<PropertySet>(_flat);
+    auto const lock = _lockShared();
     for (auto const& elt : _map) {
         if (elt.second->back().type() == typeid(Ptr)) {
             for (auto const& j : *elt.second) {
@@ -75,7 +345,16 @@ PropertySet::Ptr PropertySet::deepCopy() const {
                 }
             }
         } else {
-            std::shared_ptr<std::vector<boost::any>> vp(new std::vector<boost::any>(*(elt.second)));
+            auto vp = std::make_shared<std::vector<boost::any>>(*(elt.second));
+            if (vp->back().type() == typeid(Persistable::Ptr)) {
+                // Copy time series, which are modified in place; they share storage until then
+                for (auto& j : *vp) {
+                    auto series = std::dynamic_pointer_cast<TimeSeries>(boost::any_cast<Persistable::Ptr>(j));
+                    if (series) {
+                        j = Persistable::Ptr(std::make_shared<TimeSeries>(*series));
+                    }
+                }
+            }
             n->_map[elt.first] = vp;
         }
     }
@@ -84,6 +363,7 @@ PropertySet::Ptr PropertySet::deepCopy() const {
 
 size_t PropertySet::nameCount(bool topLevelOnly) const {
     int n = 0;
+    auto const lock = _lockShared();
     for (auto const& elt : _map) {
         ++n;
         if (!topLevelOnly && elt.second->back().type() == typeid(Ptr)) {
@@ -98,6 +378,7 @@ size_t PropertySet::nameCount(bool topLevelOnly) const {
 
 std::vector<std::string> PropertySet::names(bool topLevelOnly) const {
     std::vector<std::string> v;
+    auto const lock = _lockShared();
     for (auto const& elt : _map) {
         v.push_back(elt.first);
         if (!topLevelOnly && elt.second->back().type() == typeid(Ptr)) {
@@ -115,6 +396,7 @@ std::vector<std::string> PropertySet::names(bool topLevelOnly) const {
 
 std::vector<std::string> PropertySet::paramNames(bool topLevelOnly) const {
     std::vector<std::string> v;
+    auto const lock = _lockShared();
     for (auto const& elt : _map) {
         if (elt.second->back().type() == typeid(Ptr)) {
             Ptr p = boost::any_cast<Ptr>(elt.second->back());
@@ -133,6 +415,7 @@ std::vector<std::string> PropertySet::paramNames(bool topLevelOnly) const {
 
 std::vector<std::string> PropertySet::propertySetNames(bool topLevelOnly) const {
     std::vector<std::string> v;
+    auto const lock = _lockShared();
     for (auto const& elt : _map) {
         if (elt.second->back().type() == typeid(Ptr)) {
             v.push_back(elt.first);
@@ -148,21 +431,21 @@ std::vector<std::string> PropertySet::propertySetNames(bool topLevelOnly) const
     return v;
 }
 
-bool PropertySet::exists(std::string const& name) const { return _find(name) != _map.end(); }
+bool PropertySet::exists(std::string const& name) const { return _find(name) != nullptr; }
 
 bool PropertySet::isArray(std::string const& name) const {
     auto const i = _find(name);
-    return i != _map.end() && i->second->size() > 1U;
+    return i != nullptr && i->second->size() > 1U;
 }
 
 bool PropertySet::isPropertySetPtr(std::string const& name) const {
     auto const i = _find(name);
-    return i != _map.end() && i->second->back().type() == typeid(Ptr);
+    return i != nullptr && i->second->back().type() == typeid(Ptr);
 }
 
 bool PropertySet::isUndefined(std::string const& name) const {
     auto const i = _find(name);
-    return i != _map.end() && i->second->back().type() == typeid(nullptr);
+    return i != nullptr && i->second->back().type() == typeid(nullptr);
 }
 
 size_t PropertySet::valueCount() const {
@@ -175,13 +458,13 @@ size_t PropertySet::valueCount() const {
 
 size_t PropertySet::valueCount(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) return 0;
+    if (i == nullptr) return 0;
     return i->second->size();
 }
 
 std::type_info const& PropertySet::typeOf(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     return i->second->back().type();
@@ -198,7 +481,7 @@ template <typename T>
 T PropertySet::get(std::string const& name)
         const { /* parasoft-suppress LsstDm-3-4a LsstDm-4-6 "allow template over bool" */
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     try {
@@ -214,7 +497,7 @@ template <typename T>
 T PropertySet::get(std::string const& name, T const& defaultValue)
         const { /* parasoft-suppress LsstDm-3-4a LsstDm-4-6 "allow template over bool" */
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         return defaultValue;
     }
     try {
@@ -229,7 +512,7 @@ T PropertySet::get(std::string const& name, T const& defaultValue)
 template <typename T>
 std::vector<T> PropertySet::getArray(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     std::vector<T> v;
@@ -252,7 +535,7 @@ bool PropertySet::getAsBool(std::string const& name)
 
 int PropertySet::getAsInt(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     boost::any v = i->second->back();
@@ -281,7 +564,7 @@ int PropertySet::getAsInt(std::string const& name) const {
 
 int64_t PropertySet::getAsInt64(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     boost::any v = i->second->back();
@@ -307,7 +590,7 @@ int64_t PropertySet::getAsInt64(std::string const& name) const {
 
 uint64_t PropertySet::getAsUInt64(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     boost::any v = i->second->back();
@@ -334,7 +617,7 @@ uint64_t PropertySet::getAsUInt64(std::string const& name) const {
 
 double PropertySet::getAsDouble(std::string const& name) const {
     auto const i = _find(name);
-    if (i == _map.end()) {
+    if (i == nullptr) {
         throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
     }
     boost::any v = i->second->back();
@@ -369,9 +652,71 @@ Persistable::Ptr PropertySet::getAsPersistablePtr(std::string const& name) const
     return get<Persistable::Ptr>(name);
 }
 
+DateTime PropertySet::getAsDateTime(std::string const& name, DateTime::Timescale scale) const {
+    int const k = scale - DateTime::TAI;
+    DateTimeCache& cache = _getDateTimeCache();
+    std::shared_ptr<std::vector<boost::any>> vp;
+    std::size_t size;
+    DateTime value;
+    bool isNumber = false;
+    {
+        auto const i = _find(name);
+        if (i == nullptr) {
+            throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
+        }
+        vp = i->second;
+        size = vp->size();
+        boost::any const& v = vp->back();
+        if (v.type() == typeid(DateTime)) {
+            return *boost::any_cast<DateTime>(&v);
+        }
+        {
+            std::lock_guard<std::mutex> lock(cache.mutex);
+            auto const j = cache.entries.find(name);
+            if (j != cache.entries.end() && (j->second.scales & (1U << k)) && j->second.isFor(vp)) {
+                return j->second.value[k];
+            }
+        }
+        if (v.type() == typeid(std::string)) {
+            value = _parseDate(name, *boost::any_cast<std::string>(&v), scale);
+        } else if (v.type() == typeid(bool)) {
+            throw LSST_EXCEPT(pex::exceptions::TypeError, name);
+        } else {
+            isNumber = true;
+        }
+    }
+    if (isNumber) {
+        // After releasing the entry, which getAsDouble finds again
+        value = DateTime(getAsDouble(name), DateTime::MJD, scale);
+    }
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    DateTimeCache::Entry& entry = cache.entries[name];
+    if (!entry.isFor(vp)) {
+        entry.values = vp;
+        entry.size = size;
+        entry.scales = 0;
+    }
+    entry.scales |= 1U << k;
+    entry.value[k] = value;
+    return value;
+}
+
+std::shared_ptr<TimeSeries> PropertySet::getTimeSeries(std::string const& name) const {
+    auto series = std::dynamic_pointer_cast<TimeSeries>(get<Persistable::Ptr>(name));
+    if (!series) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, name + " is not a TimeSeries");
+    }
+    return series;
+}
+
 std::string PropertySet::toString(bool topLevelOnly, std::string const& indent) const {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::toString");
     std::ostringstream s;
-    std::vector<std::string> nv = names();
+    auto const lock = _lockShared();
+    std::vector<std::string> nv;
+    for (auto const& elt : _map) {
+        nv.push_back(elt.first);
+    }
     sort(nv.begin(), nv.end());
     for (auto const& i : nv) {
         std::shared_ptr<std::vector<boost::any>> vp = _map.find(i)->second;
@@ -398,67 +743,32 @@ std::string PropertySet::toString(bool topLevelOnly, std::string const& indent)
     return s.str();
 }
 
+void PropertySet::walk(PropertyHandler& handler) const {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::walk");
+    auto const lock = _lockShared();
+    handler.beginSet(_map.size());
+    for (auto const& elt : _map) {
+        handler.key(elt.first);
+        _emit(*elt.second, handler);
+    }
+    handler.endSet();
+}
+
+void PropertySet::walk(std::string const& name, PropertyHandler& handler) const {
+    auto const i = _find(name);
+    if (i == nullptr) {
+        throw LSST_EXCEPT(pex::exceptions::NotFoundError, name + " not found");
+    }
+    _emit(*(i->second), handler);
+}
+
 std::string PropertySet::_format(std::string const& name) const {
     std::ostringstream s;
     s << std::showpoint;  // Always show a decimal point for floats
     auto const j = _map.find(name);
     s << j->first << " = ";
-    std::shared_ptr<std::vector<boost::any>> vp = j->second;
-    if (vp->size() > 1) {
-        s << "[ ";
-    }
-    std::type_info const& t = vp->back().type();
-    bool isFirst = true;
-    for (auto const& k : *vp) {
-        if (isFirst) {
-            isFirst = false;
-        } else {
-            s << ", ";
-        }
-        boost::any const& v(k);
-        if (t == typeid(bool)) {
-            s << boost::any_cast<bool>(v);
-        } else if (t == typeid(char)) {
-            s << '\'' << boost::any_cast<char>(v) << '\'';
-        } else if (t == typeid(signed char)) {
-            s << '\'' << boost::any_cast<signed char>(v) << '\'';
-        } else if (t == typeid(unsigned char)) {
-            s << '\'' << boost::any_cast<unsigned char>(v) << '\'';
-        } else if (t == typeid(short)) {
-            s << boost::any_cast<short>(v);
-        } else if (t == typeid(unsigned short)) {
-            s << boost::any_cast<unsigned short>(v);
-        } else if (t == typeid(int)) {
-            s << boost::any_cast<int>(v);
-        } else if (t == typeid(unsigned int)) {
-            s << boost::any_cast<unsigned int>(v);
-        } else if (t == typeid(long)) {
-            s << boost::any_cast<long>(v);
-        } else if (t == typeid(unsigned long)) {
-            s << boost::any_cast<unsigned long>(v);
-        } else if (t == typeid(long long)) {
-            s << boost::any_cast<long long>(v);
-        } else if (t == typeid(unsigned long long)) {
-            s << boost::any_cast<unsigned long long>(v);
-        } else if (t == typeid(float)) {
-            s << std::setprecision(7) << boost::any_cast<float>(v);
-        } else if (t == typeid(double)) {
-            s << std::setprecision(14) << boost::any_cast<double>(v);
-        } else if (t == typeid(std::string)) {
-            s << '"' << boost::any_cast<std::string>(v) << '"';
-        } else if (t == typeid(DateTime)) {
-            s << boost::any_cast<DateTime>(v).toString(DateTime::UTC);
-        } else if (t == typeid(Ptr)) {
-            s << "{ ... }";
-        } else if (t == typeid(Persistable::Ptr)) {
-            s << "<Persistable>";
-        } else {
-            s << "<Unknown>";
-        }
-    }
-    if (j->second->size() > 1) {
-        s << " ]";
-    }
+    Formatter formatter(s);
+    _emit(*(j->second), formatter);
     s << std::endl;
     return s.str();
 }
@@ -469,7 +779,7 @@ std::string PropertySet::_format(std::string const& name) const {
 
 template <typename T>
 void PropertySet::set(std::string const& name, T const& value) {
-    std::shared_ptr<std::vector<boost::any>> vp(new std::vector<boost::any>);
+    auto vp = std::make_shared<std::vector<boost::any>>();
     vp->push_back(value);
     _set(name, vp);
 }
@@ -477,17 +787,41 @@ void PropertySet::set(std::string const& name, T const& value) {
 template <typename T>
 void PropertySet::set(std::string const& name, std::vector<T> const& value) {
     if (value.empty()) return;
-    std::shared_ptr<std::vector<boost::any>> vp(new std::vector<boost::any>);
+    auto vp = std::make_shared<std::vector<boost::any>>();
     _append(*vp, value);
     _set(name, vp);
 }
 
 void PropertySet::set(std::string const& name, char const* value) { set(name, std::string(value)); }
 
+void PropertySet::set(std::string const& name, double value, DateTime const& time) {
+    {
+        auto const i = _find(name);
+        if (i != nullptr && i->second->back().type() == typeid(Persistable::Ptr)) {
+            auto series = std::dynamic_pointer_cast<TimeSeries>(
+                    boost::any_cast<Persistable::Ptr>(i->second->back()));
+            if (series) {
+                _recordSeries(series);
+                series->append(time, value);
+                return;
+            }
+        }
+    }
+    auto series = std::make_shared<TimeSeries>();
+    series->append(time, value);
+    set(name, Persistable::Ptr(series));
+}
+
 template <typename T>
 void PropertySet::add(std::string const& name, T const& value) {
-    AnyMap::iterator i = _find(name);
-    if (i == _map.end()) {
+    if (_mutex) {
+        // Find and append, or insert, under a single lock
+        _add(name, std::make_shared<std::vector<boost::any>>(1, boost::any(value)));
+        return;
+    }
+    _touch(name);
+    auto const i = _find(name);
+    if (i == nullptr) {
         set(name, value);
     } else {
         if (i->second->back().type() != typeid(T)) {
@@ -500,8 +834,13 @@ void PropertySet::add(std::string const& name, T const& value) {
 // Specialize for Ptrs to check for cycles.
 template <>
 void PropertySet::add<PropertySet::Ptr>(std::string const& name, Ptr const& value) {
-    AnyMap::iterator i = _find(name);
-    if (i == _map.end()) {
+    if (_mutex) {
+        _add(name, std::make_shared<std::vector<boost::any>>(1, boost::any(value)));
+        return;
+    }
+    _touch(name);
+    auto const i = _find(name);
+    if (i == nullptr) {
         set(name, value);
     } else {
         if (i->second->back().type() != typeid(Ptr)) {
@@ -514,8 +853,15 @@ void PropertySet::add<PropertySet::Ptr>(std::string const& name, Ptr const& valu
 
 template <typename T>
 void PropertySet::add(std::string const& name, std::vector<T> const& value) {
-    AnyMap::iterator i = _find(name);
-    if (i == _map.end()) {
+    if (_mutex && !value.empty()) {
+        auto vp = std::make_shared<std::vector<boost::any>>();
+        _append(*vp, value);
+        _add(name, vp);
+        return;
+    }
+    _touch(name);
+    auto const i = _find(name);
+    if (i == nullptr) {
         set(name, value);
     } else {
         if (i->second->back().type() != typeid(T)) {
@@ -528,8 +874,15 @@ void PropertySet::add(std::string const& name, std::vector<T> const& value) {
 // Specialize for Ptrs to check for cycles.
 template <>
 void PropertySet::add<PropertySet::Ptr>(std::string const& name, std::vector<Ptr> const& value) {
-    AnyMap::iterator i = _find(name);
-    if (i == _map.end()) {
+    if (_mutex && !value.empty()) {
+        auto vp = std::make_shared<std::vector<boost::any>>();
+        _append(*vp, value);
+        _add(name, vp);
+        return;
+    }
+    _touch(name);
+    auto const i = _find(name);
+    if (i == nullptr) {
         set(name, value);
     } else {
         if (i->second->back().type() != typeid(Ptr)) {
@@ -546,105 +899,266 @@ void PropertySet::copy(std::string const& dest, ConstPtr source, std::string con
     if (source.get() == 0) {
         throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Missing source");
     }
-    auto const sj = source->_find(name);
-    if (sj == source->_map.end()) {
-        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, name + " not in source");
+    std::shared_ptr<std::vector<boost::any>> vp;
+    {
+        auto const sj = source->_find(name);
+        if (sj == nullptr) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, name + " not in source");
+        }
+        if (asScalar) {
+            vp = std::make_shared<std::vector<boost::any>>();
+            vp->push_back(sj->second->back());
+        } else {
+            vp = std::make_shared<std::vector<boost::any>>(*(sj->second));
+        }
     }
     remove(dest);
-    if (asScalar) {
-        auto vp = std::make_shared<std::vector<boost::any>>();
-        vp->push_back(sj->second->back());
-        _set(dest, vp);
-    } else {
-        auto vp = std::make_shared<std::vector<boost::any>>(*(sj->second));
-        _set(dest, vp);
-    }
+    _set(dest, vp);
 }
 
 void PropertySet::combine(ConstPtr source) {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::combine");
     if (source.get() == 0) {
         return;
     }
     std::vector<std::string> names = source->paramNames(false);
+    bool const concurrent = _mutex || source->_mutex;
     for (auto const& name : names) {
-        auto const sp = source->_find(name);
-        _add(name, sp->second);
+        std::shared_ptr<std::vector<boost::any>> vp;
+        {
+            auto const sp = source->_find(name);
+            if (sp == nullptr) {  // removed by another thread
+                continue;
+            }
+            // Values of a concurrent set are guarded by its locks, so they cannot be shared
+            vp = concurrent ? std::make_shared<std::vector<boost::any>>(*(sp->second)) : sp->second;
+        }
+        _add(name, vp);
     }
 }
 
-void PropertySet::remove(std::string const& name) {
-    std::string::size_type i = name.find('.');
-    if (_flat || i == name.npos) {
-        _map.erase(name);
-        return;
+void PropertySet::remove(std::string const& name) { _remove(name); }
+
+std::size_t PropertySet::remove(std::vector<std::string> const& names) {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::remove");
+    std::size_t count = 0;
+    for (auto const& name : names) {
+        if (_remove(name)) {
+            ++count;
+        }
     }
-    std::string prefix(name, 0, i);
-    AnyMap::iterator j = _map.find(prefix);
-    if (j == _map.end() || j->second->back().type() != typeid(Ptr)) {
+    return count;
+}
+
+std::size_t PropertySet::removeIf(RemovePredicate const& predicate) {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::removeIf");
+    std::size_t count = 0;
+    auto const lock = _lockUnique();
+    for (auto i = _map.begin(); i != _map.end();) {
+        boost::any const& value = i->second->back();
+        if (predicate(i->first, value.type(), value)) {
+            if (_undo) {
+                _record(this, Ptr(), i->first);
+            }
+            i = _map.erase(i);
+            ++count;
+        } else {
+            ++i;
+        }
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Concurrency
+///////////////////////////////////////////////////////////////////////////////
+
+void PropertySet::makeConcurrent() {
+    if (_flat) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "A flat PropertySet cannot be made concurrent");
+    }
+    if (_mutex) {
         return;
     }
-    Ptr p = boost::any_cast<Ptr>(j->second->back());
-    if (p.get() != 0) {
-        std::string suffix(name, i + 1);
-        p->remove(suffix);
+    if (_undo) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "A PropertySet with a savepoint cannot be made concurrent");
+    }
+    for (auto const& elt : _map) {
+        if (elt.second->back().type() == typeid(Ptr)) {
+            for (auto const& i : *elt.second) {
+                Ptr const& p = *boost::any_cast<Ptr>(&i);
+                if (p.get() != 0) {
+                    p->makeConcurrent();
+                }
+            }
+        }
+    }
+    _mutex.reset(new Mutex);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Savepoints
+///////////////////////////////////////////////////////////////////////////////
+
+void PropertySet::savepoint() {
+    if (_mutex) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "A concurrent PropertySet cannot have savepoints");
+    }
+    if (!_undo) {
+        _undo.reset(new UndoLog);
     }
+    _undo->levels.push_back(UndoLog::Level{_undo->values.size(), _undo->series.size(), {}, {}});
+}
+
+void PropertySet::rollback() {
+    LSST_DAF_BASE_TRACE_SPAN("PropertySet::rollback");
+    if (!_undo) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "No savepoint to roll back to");
+    }
+    UndoLog::Level const& level = _undo->levels.back();
+    auto& values = _undo->values;
+    for (std::size_t i = values.size(); i > level.values; --i) {
+        UndoLog::Value const& v = values[i - 1];
+        if (!v.values) {
+            v.owner->_map.erase(v.key);
+        } else if (v.values->size() == v.size) {
+            v.owner->_map[v.key] = v.values;
+        } else {
+            // Copy rather than truncate: the vector may be shared, or cached by getAsDateTime with its size
+            v.owner->_map[v.key] =
+                    std::make_shared<std::vector<boost::any>>(v.values->begin(), v.values->begin() + v.size);
+        }
+    }
+    values.erase(values.begin() + level.values, values.end());
+    auto& series = _undo->series;
+    for (std::size_t i = series.size(); i > level.series; --i) {
+        *series[i - 1].live = std::move(series[i - 1].saved);
+    }
+    series.erase(series.begin() + level.series, series.end());
+    _undo->levels.pop_back();
+    if (_undo->levels.empty()) {
+        _undo.reset();
+    }
+}
+
+void PropertySet::release() {
+    if (!_undo) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "No savepoint to release");
+    }
+    if (_undo->levels.size() == 1) {
+        _undo.reset();
+        return;
+    }
+    // The records of the inner level are the state at its start, which is also
+    // the state at the start of the outer level for anything it had not touched
+    UndoLog::Level inner = std::move(_undo->levels.back());
+    _undo->levels.pop_back();
+    UndoLog::Level& outer = _undo->levels.back();
+    outer.touched.insert(inner.touched.begin(), inner.touched.end());
+    outer.touchedSeries.insert(inner.touchedSeries.begin(), inner.touchedSeries.end());
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 // Private member functions
 ///////////////////////////////////////////////////////////////////////////////
 
-PropertySet::AnyMap::iterator PropertySet::_find(std::string const& name) {
+bool PropertySet::_remove(std::string const& name) {
+    _touch(name);
     std::string::size_type i = name.find('.');
     if (_flat || i == name.npos) {
-        return _map.find(name);
+        auto const lock = _lockUnique();
+        return _map.erase(name) > 0;
     }
     std::string prefix(name, 0, i);
-    AnyMap::iterator j = _map.find(prefix);
-    if (j == _map.end() || j->second->back().type() != typeid(Ptr)) {
-        return _map.end();
+    Ptr p;
+    {
+        auto const lock = _lockShared();
+        AnyMap::iterator j = _map.find(prefix);
+        if (j == _map.end() || j->second->back().type() != typeid(Ptr)) {
+            return false;
+        }
+        p = boost::any_cast<Ptr>(j->second->back());
     }
-    Ptr p = boost::any_cast<Ptr>(j->second->back());
     if (p.get() == 0) {
-        return _map.end();
+        return false;
     }
-    std::string suffix(name, i + 1);
-    AnyMap::iterator x = p->_find(suffix);
-    if (x == p->_map.end()) {
-        return _map.end();
+    // One virtual call, so that checking and removing happen under the same lock of a concurrent
+    // subproperty, and a subclass such as PropertyList still updates its own bookkeeping
+    std::vector<std::string> const suffix{std::string(name, i + 1)};
+    return p->remove(suffix) > 0;
+}
+
+PropertySet::DateTimeCache& PropertySet::_getDateTimeCache() const {
+    DateTimeCache* cache = _dateTimeCache.load(std::memory_order_acquire);
+    if (cache == nullptr) {
+        std::unique_ptr<DateTimeCache> created(new DateTimeCache);
+        if (_dateTimeCache.compare_exchange_strong(cache, created.get(), std::memory_order_acq_rel)) {
+            cache = created.release();
+        }  // otherwise cache is now the one created by another thread
     }
-    return x;
+    return *cache;
+}
+
+PropertySet::Entry PropertySet::_find(std::string const& name) { return _findIn<Entry>(*this, name); }
+
+PropertySet::ConstEntry PropertySet::_find(std::string const& name) const {
+    return _findIn<ConstEntry>(*this, name);
 }
 
-PropertySet::AnyMap::const_iterator PropertySet::_find(std::string const& name) const {
+template <typename Result, typename Self>
+Result PropertySet::_findIn(Self& self, std::string const& name) {
     std::string::size_type i = name.find('.');
-    if (_flat || i == name.npos) {
-        return _map.find(name);
+    if (self._flat || i == name.npos) {
+        Result result;
+        result._lock = _lock<typename Result::Lock>(self._mutex);
+        auto const j = self._map.find(name);
+        if (j == self._map.end()) {
+            return Result();
+        }
+        result._entry = j;
+        return result;
     }
     std::string prefix(name, 0, i);
-    auto const j = _map.find(prefix);
-    if (j == _map.end() || j->second->back().type() != typeid(Ptr)) {
-        return _map.end();
+    Self* child;
+    Ptr hold;  // keeps a concurrent child alive once self is unlocked
+    {
+        auto const lock = self._lockShared();
+        auto const j = self._map.find(prefix);
+        if (j == self._map.end() || j->second->back().type() != typeid(Ptr)) {
+            return Result();
+        }
+        Ptr const& p = boost::any_cast<Ptr const&>(j->second->back());
+        if (self._mutex) {
+            hold = p;
+        }
+        child = p.get();
     }
-    Ptr p = boost::any_cast<Ptr>(j->second->back());
-    if (p.get() == 0) {
-        return _map.end();
+    if (child == nullptr) {
+        return Result();
     }
     std::string suffix(name, i + 1);
-    auto const x = p->_find(suffix);
-    if (x == p->_map.end()) {
-        return _map.end();
+    Result result = _findIn<Result>(*child, suffix);
+    if (result._lock.owns_lock() && !result._owner) {
+        result._owner = hold;
     }
-    return x;
+    return result;
 }
 
 void PropertySet::_set(std::string const& name, std::shared_ptr<std::vector<boost::any>> vp) {
+    _touch(name);
     _findOrInsert(name, vp);
 }
 
 void PropertySet::_add(std::string const& name, std::shared_ptr<std::vector<boost::any>> vp) {
+    if (_mutex) {
+        // Find and append, or insert, under a single lock
+        _findOrInsert(name, vp, true);
+        return;
+    }
+    _touch(name);
     auto const dp = _find(name);
-    if (dp == _map.end()) {
+    if (dp == nullptr) {
         _set(name, vp);
     } else {
         if (vp->back().type() != dp->second->back().type()) {
@@ -658,47 +1172,80 @@ void PropertySet::_add(std::string const& name, std::shared_ptr<std::vector<boos
     }
 }
 
-void PropertySet::_findOrInsert(std::string const& name, std::shared_ptr<std::vector<boost::any>> vp) {
+void PropertySet::_findOrInsert(std::string const& name, std::shared_ptr<std::vector<boost::any>> vp,
+                                bool append) {
     if (vp->back().type() == typeid(Ptr)) {
         if (_flat) {
             Ptr source = boost::any_cast<Ptr>(vp->back());
             std::vector<std::string> names = source->paramNames(false);
             for (auto const& i : names) {
                 auto const sp = source->_find(i);
-                _add(name + "." + i, sp->second);
+                _add(name + "." + i, source->_mutex ? std::make_shared<std::vector<boost::any>>(*(sp->second))
+                                                    : sp->second);
             }
             return;
         }
 
-        // Check for cycles
+        // Check for cycles, before locking sets that vp might contain
         _cycleCheckAnyVec(*vp, name);
+        _shareAnyVec(*vp);
     }
 
     std::string::size_type i = name.find('.');
     if (_flat || i == name.npos) {
+        auto const lock = _lockUnique();
+        if (append) {
+            AnyMap::iterator j = _map.find(name);
+            if (j != _map.end()) {
+                if (vp->back().type() != j->second->back().type()) {
+                    throw LSST_EXCEPT(pex::exceptions::TypeError, name + " has mismatched type");
+                }
+                _append(*(j->second), *vp);
+                return;
+            }
+        }
         _map[name] = vp;
         return;
     }
     std::string prefix(name, 0, i);
     std::string suffix(name, i + 1);
-    AnyMap::iterator j = _map.find(prefix);
-    if (j == _map.end()) {
-        PropertySet::Ptr pp(new PropertySet);
-        pp->_findOrInsert(suffix, vp);
-        std::shared_ptr<std::vector<boost::any>> temp(new std::vector<boost::any>);
-        temp->push_back(pp);
-        _map[prefix] = temp;
-        return;
-    } else if (j->second->back().type() != typeid(Ptr)) {
-        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
-                          prefix + " exists but does not contain PropertySet::Ptrs");
+    Ptr p;
+    bool exists;
+    {
+        auto const lock = _lockShared();
+        exists = _findSubset(prefix, p);
+    }
+    if (!exists) {
+        // Insert the subproperty unless another thread has done so since the lookup
+        auto const lock = _lockUnique();
+        if (!_findSubset(prefix, p)) {
+            auto pp = std::make_shared<PropertySet>();
+            if (_mutex) {
+                pp->_mutex.reset(new Mutex);
+            }
+            pp->_findOrInsert(suffix, vp);
+            auto temp = std::make_shared<std::vector<boost::any>>(1, boost::any(Ptr(pp)));
+            _map[prefix] = temp;
+            return;
+        }
     }
-    Ptr p = boost::any_cast<Ptr>(j->second->back());
     if (p.get() == 0) {
         throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
                           prefix + " exists but contains null PropertySet::Ptr");
     }
-    p->_findOrInsert(suffix, vp);
+    p->_findOrInsert(suffix, vp, append);
+}
+
+bool PropertySet::_findSubset(std::string const& prefix, Ptr& p) const {
+    auto const j = _map.find(prefix);
+    if (j == _map.end()) {
+        return false;
+    } else if (j->second->back().type() != typeid(Ptr)) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          prefix + " exists but does not contain PropertySet::Ptrs");
+    }
+    p = boost::any_cast<Ptr>(j->second->back());
+    return true;
 }
 
 void PropertySet::_cycleCheckPtrVec(std::vector<Ptr> const& v, std::string const& name) {
@@ -725,6 +1272,73 @@ void PropertySet::_cycleCheckPtr(Ptr const& v, std::string const& name) {
     }
 }
 
+void PropertySet::_shareAnyVec(std::vector<boost::any> const& v) {
+    if (!_mutex) {
+        return;
+    }
+    for (auto const& i : v) {
+        Ptr const& p = *boost::any_cast<Ptr>(&i);
+        if (p.get() != 0) {
+            p->makeConcurrent();
+        }
+    }
+}
+
+void PropertySet::_record(std::string const& name) {
+    PropertySet* owner = this;
+    Ptr hold;
+    std::string::size_type begin = 0;
+    std::string::size_type end = name.find('.');
+    while (!owner->_flat && end != name.npos) {
+        std::string prefix(name, begin, end - begin);
+        auto const j = owner->_map.find(prefix);
+        if (j == owner->_map.end()) {
+            // The change creates the subproperty
+            _record(owner, hold, prefix);
+            return;
+        }
+        if (j->second->back().type() != typeid(Ptr)) {
+            return;  // the change fails
+        }
+        Ptr const& p = *boost::any_cast<Ptr>(&j->second->back());
+        if (p.get() == 0) {
+            return;
+        }
+        hold = p;
+        owner = p.get();
+        begin = end + 1;
+        end = name.find('.', begin);
+    }
+    _record(owner, hold, begin == 0 ? name : std::string(name, begin));
+}
+
+void PropertySet::_record(PropertySet* owner, Ptr const& hold, std::string const& key) {
+    if (!_undo->levels.back().touched.emplace(owner, key).second) {
+        return;
+    }
+    UndoLog::Value value{owner, hold, key, nullptr, 0};
+    auto const i = owner->_map.find(key);
+    if (i != owner->_map.end()) {
+        value.values = i->second;
+        value.size = i->second->size();
+    }
+    _undo->values.push_back(std::move(value));
+}
+
+void PropertySet::_recordSeries(std::shared_ptr<TimeSeries> const& series) {
+    if (_undo && _undo->levels.back().touchedSeries.insert(series.get()).second) {
+        _undo->series.push_back(UndoLog::Series{series, *series});
+    }
+}
+
+std::shared_lock<PropertySet::Mutex> PropertySet::_lockShared() const {
+    return _lock<std::shared_lock<Mutex>>(_mutex);
+}
+
+std::unique_lock<PropertySet::Mutex> PropertySet::_lockUnique() const {
+    return _lock<std::unique_lock<Mutex>>(_mutex);
+}
+
     ///////////////////////////////////////////////////////////////////////////////
     // Explicit template instantiations
     ///////////////////////////////////////////////////////////////////////////////
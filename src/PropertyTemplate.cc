@@ -0,0 +1,729 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/PropertyTemplate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+#include <unordered_set>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyHandler.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+long long const NSEC_PER_SEC = 1000000000LL;
+long long const NSEC_PER_DAY = 86400LL * NSEC_PER_SEC;
+
+// Date directives supported in date format specifications
+char const DATE_DIRECTIVES[] = "YymdjHMSf%";
+
+// Presentation types supported in other format specifications
+char const TYPES[] = "sdxXoeEfFgG%";
+
+// Calendar fields of a UTC date
+struct DateFields {
+    long long year;
+    int month;
+    int day;
+    int hour;
+    int minute;
+    int second;
+    long long nsec;
+};
+
+/**
+ * Days since 1970-01-01 of a date in the proleptic Gregorian calendar
+ *
+ * Uses the algorithm described in http://howardhinnant.github.io/date_algorithms.html
+ */
+long long daysFromCivil(long long year, int month, int day) {
+    year -= month <= 2;
+    long long const era = (year >= 0 ? year : year - 399) / 400;
+    long long const yoe = year - era * 400;
+    long long const doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long long const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+/// Inverse of daysFromCivil
+void civilFromDays(long long days, DateFields& fields) {
+    days += 719468;
+    long long const era = (days >= 0 ? days : days - 146096) / 146097;
+    long long const doe = days - era * 146097;
+    long long const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long const mp = (5 * doy + 2) / 153;
+    fields.day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    fields.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    fields.year = yoe + era * 400 + (fields.month <= 2);
+}
+
+/// Calendar fields of a DateTime in UTC
+DateFields dateFields(DateTime const& date) {
+    long long const nsecs = date.nsecs(DateTime::UTC);
+    long long days = nsecs / NSEC_PER_DAY;
+    long long rem = nsecs % NSEC_PER_DAY;
+    if (rem < 0) {
+        --days;
+        rem += NSEC_PER_DAY;
+    }
+    DateFields fields;
+    civilFromDays(days, fields);
+    long long const secs = rem / NSEC_PER_SEC;
+    fields.hour = static_cast<int>(secs / 3600);
+    fields.minute = static_cast<int>(secs / 60 % 60);
+    fields.second = static_cast<int>(secs % 60);
+    fields.nsec = rem % NSEC_PER_SEC;
+    return fields;
+}
+
+// Read exactly n digits
+bool readDigits(char const*& p, char const* end, int n, int& value) {
+    value = 0;
+    for (int i = 0; i < n; ++i, ++p) {
+        if (p == end || !std::isdigit(static_cast<unsigned char>(*p))) {
+            return false;
+        }
+        value = 10 * value + (*p - '0');
+    }
+    return true;
+}
+
+// Skip an optional separator
+void skip(char const*& p, char const* end, char separator) {
+    if (p != end && *p == separator) {
+        ++p;
+    }
+}
+
+/**
+ * Calendar fields of an ISO8601 date string such as yyyy-mm-ddThh:mm:ss.sss
+ *
+ * The time, the separators, the fractional seconds and a final Z are
+ * optional, as in DateTime's ISO8601 constructor.  The fields are used as
+ * they are, whatever the time scale.
+ *
+ * @return false if the string is not a date
+ */
+bool parseDate(std::string const& str, DateFields& fields) {
+    char const* p = str.data();
+    char const* const end = p + str.size();
+    int year;
+    if (!readDigits(p, end, 4, year)) return false;
+    fields.year = year;
+    skip(p, end, '-');
+    if (!readDigits(p, end, 2, fields.month)) return false;
+    skip(p, end, '-');
+    if (!readDigits(p, end, 2, fields.day)) return false;
+    fields.hour = fields.minute = fields.second = 0;
+    fields.nsec = 0;
+    if (p != end && (*p == 'T' || *p == ' ')) {
+        ++p;
+        if (!readDigits(p, end, 2, fields.hour)) return false;
+        skip(p, end, ':');
+        if (!readDigits(p, end, 2, fields.minute)) return false;
+        skip(p, end, ':');
+        if (!readDigits(p, end, 2, fields.second)) return false;
+        if (p != end && (*p == '.' || *p == ',')) {
+            ++p;
+            long long scale = NSEC_PER_SEC;
+            for (; p != end && std::isdigit(static_cast<unsigned char>(*p)); ++p) {
+                scale /= 10;
+                fields.nsec += scale * (*p - '0');
+            }
+        }
+        skip(p, end, 'Z');
+    }
+    return p == end && fields.month >= 1 && fields.month <= 12 && fields.day >= 1 && fields.day <= 31;
+}
+
+// Append the result of snprintf
+template <typename... Args>
+void appendf(std::string& out, char const* format, Args... args) {
+    char buffer[64];
+    int const n = std::snprintf(buffer, sizeof(buffer), format, args...);
+    if (n < static_cast<int>(sizeof(buffer))) {
+        out.append(buffer, n);
+    } else {
+        std::size_t const start = out.size();
+        out.resize(start + n + 1);
+        std::snprintf(&out[start], n + 1, format, args...);
+        out.resize(start + n);
+    }
+}
+
+/**
+ * Append the shortest string that reads back as v, following Python's repr
+ *
+ * Values with a decimal exponent in [-4, 16) are written in fixed notation,
+ * with a trailing ".0" if they are integral, and others in scientific
+ * notation with at least two exponent digits.
+ *
+ * @param[in] single  true if v is a float, which needs fewer digits
+ */
+void appendRepr(std::string& out, double v, bool single) {
+    if (!std::isfinite(v)) {
+        out += std::isnan(v) ? "nan" : v < 0 ? "-inf" : "inf";
+        return;
+    }
+    // Mantissa digits from the fewest significant digits that read back exactly
+    std::string scientific;
+    int const maxDigits = single ? 9 : 17;
+    for (int digits = single ? 6 : 15;; ++digits) {
+        scientific.clear();
+        appendf(scientific, "%.*e", digits - 1, v);
+        if (digits == maxDigits) break;
+        double const readBack = std::strtod(scientific.c_str(), nullptr);
+        if (single ? static_cast<float>(readBack) == static_cast<float>(v) : readBack == v) break;
+    }
+    std::size_t const e = scientific.find('e');
+    int const exponent = std::atoi(scientific.c_str() + e + 1);
+    std::string mantissa;
+    for (std::size_t i = 0; i < e; ++i) {
+        if (std::isdigit(static_cast<unsigned char>(scientific[i]))) {
+            mantissa += scientific[i];
+        }
+    }
+    mantissa.erase(std::max<std::size_t>(mantissa.find_last_not_of('0') + 1, 1));
+
+    if (std::signbit(v)) {
+        out += '-';
+    }
+    int const n = static_cast<int>(mantissa.size());
+    if (exponent >= 16 || exponent < -4) {
+        out += mantissa[0];
+        if (n > 1) {
+            out += '.';
+            out.append(mantissa, 1, std::string::npos);
+        }
+        appendf(out, "e%+03d", exponent);
+    } else if (exponent < 0) {
+        out += "0.";
+        out.append(-exponent - 1, '0');
+        out += mantissa;
+    } else if (n > exponent + 1) {
+        out.append(mantissa, 0, exponent + 1);
+        out += '.';
+        out.append(mantissa, exponent + 1, std::string::npos);
+    } else {
+        out += mantissa;
+        out.append(exponent + 1 - n, '0');
+        out += ".0";
+    }
+}
+
+// Append an unsigned integer in base 8, 10 or 16, with at least minDigits digits
+void appendUnsigned(std::string& out, unsigned long long value, unsigned base = 10, bool upper = false,
+                    int minDigits = 1) {
+    char const* const digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char buffer[32];
+    char* const end = buffer + sizeof(buffer);
+    char* p = end;
+    do {
+        *--p = digits[value % base];
+        value /= base;
+    } while (value != 0);
+    while (end - p < minDigits) {
+        *--p = '0';
+    }
+    out.append(p, end);
+}
+
+// Append a non-negative integer with at least the given number of digits
+void appendDigits(std::string& out, long long value, int digits) {
+    appendUnsigned(out, static_cast<unsigned long long>(value), 10, false, digits);
+}
+
+}  // namespace
+
+class PropertyTemplate::Renderer : public PropertyHandler {
+public:
+    explicit Renderer(std::string& out) : _out(out), _spec(nullptr), _name(nullptr), _skip(0) {}
+
+    /// Append the formatted value of a field to the output
+    void render(PropertySet const& properties, Step const& step) {
+        _spec = &step.spec;
+        _name = &step.text;
+        _skip = 0;
+        properties.walk(step.text, *this);
+    }
+
+    void beginSet(std::size_t) override {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, *_name + " is a PropertySet and cannot be formatted");
+    }
+
+    // Only the last value of an array is formatted
+    void beginArray(std::size_t size) override { _skip = size - 1; }
+
+    void value(bool v) override {
+        if (_skipValue()) return;
+        if (_spec->type == 0 || _spec->type == 's') {
+            _string(v ? "True" : "False");
+        } else {
+            _integer(static_cast<long long>(v));
+        }
+    }
+    void value(char v) override {
+        if (_skipValue()) return;
+        _string(std::string(1, v));
+    }
+    void value(signed char v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(unsigned char v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(short v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(unsigned short v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(int v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(unsigned int v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(long v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<long long>(v));
+    }
+    void value(unsigned long v) override {
+        if (_skipValue()) return;
+        _integer(static_cast<unsigned long long>(v));
+    }
+    void value(long long v) override {
+        if (_skipValue()) return;
+        _integer(v);
+    }
+    void value(unsigned long long v) override {
+        if (_skipValue()) return;
+        _integer(v);
+    }
+    void value(float v) override {
+        if (_skipValue()) return;
+        _floating(v, true);
+    }
+    void value(double v) override {
+        if (_skipValue()) return;
+        _floating(v, false);
+    }
+    void value(std::nullptr_t) override {
+        if (_skipValue()) return;
+        _string("None");
+    }
+    void value(std::string const& v) override {
+        if (_skipValue()) return;
+        if (_spec->dateFormat.empty()) {
+            _string(v);
+        } else {
+            DateFields fields;
+            if (!parseDate(v, fields)) {
+                throw LSST_EXCEPT(pex::exceptions::TypeError,
+                                  *_name + " value '" + v + "' cannot be formatted as a date");
+            }
+            _date(fields);
+        }
+    }
+    void value(DateTime const& v) override {
+        if (_skipValue()) return;
+        if (_spec->dateFormat.empty()) {
+            _string(v.toString(DateTime::UTC));
+        } else {
+            _date(dateFields(v));
+        }
+    }
+    void value(Persistable::Ptr const&) override {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, *_name + " is a Persistable and cannot be formatted");
+    }
+
+private:
+    bool _skipValue() {
+        if (_skip > 0) {
+            --_skip;
+            return true;
+        }
+        return false;
+    }
+
+    void _typeError(char const* what) const {
+        std::string const spec = _spec->dateFormat.empty() ? std::string(1, _spec->type) : _spec->dateFormat;
+        throw LSST_EXCEPT(pex::exceptions::TypeError,
+                          *_name + " is " + what + " and cannot be formatted with '" + spec + "'");
+    }
+
+    // Format a value of type long long or unsigned long long
+    template <typename T>
+    void _integer(T v) {
+        if (!_spec->dateFormat.empty()) {
+            _typeError("an integer");
+        }
+        switch (_spec->type) {
+            case 0:
+            case 'd':
+            case 'x':
+            case 'X':
+            case 'o': {
+                std::size_t const start = _out.size();
+                bool const negative = std::is_signed<T>::value && v < T(0);
+                unsigned long long const magnitude = negative ? 0ULL - static_cast<unsigned long long>(v)
+                                                              : static_cast<unsigned long long>(v);
+                if (negative) {
+                    _out += '-';
+                } else if (_spec->sign != 0) {
+                    _out += _spec->sign;
+                }
+                std::size_t const signLength = _out.size() - start;
+                bool const hex = _spec->type == 'x' || _spec->type == 'X';
+                unsigned const base = hex ? 16 : _spec->type == 'o' ? 8 : 10;
+                appendUnsigned(_out, magnitude, base, _spec->type == 'X');
+                _pad(start, signLength, '>');
+                break;
+            }
+            case 's':
+                _typeError("an integer");
+                break;
+            default:
+                _floating(static_cast<double>(v), false);
+                break;
+        }
+    }
+
+    // Format a floating-point value; single is true for a float
+    void _floating(double v, bool single) {
+        if (!_spec->dateFormat.empty() ||
+            (_spec->type != 0 && std::strchr("sdxXo", _spec->type) != nullptr)) {
+            _typeError("a floating-point number");
+        }
+        std::size_t const start = _out.size();
+        if (_spec->type == 0 && _spec->precision < 0) {
+            // Shortest representation that reads back exactly, as Python's repr
+            if (_spec->sign != 0 && !std::signbit(v)) {
+                _out += _spec->sign;
+            }
+            appendRepr(_out, v, single);
+        } else {
+            char type = _spec->type == 0 ? 'g' : _spec->type;
+            double value = v;
+            if (type == '%') {
+                type = 'f';
+                value *= 100.0;
+            }
+            char format[8] = "%";
+            if (_spec->sign != 0) {
+                format[1] = _spec->sign;
+            }
+            std::strcat(format, ".*");
+            std::size_t const length = std::strlen(format);
+            format[length] = type;
+            format[length + 1] = '\0';
+            appendf(_out, format, _spec->precision < 0 ? 6 : _spec->precision, value);
+            if (_spec->type == '%') {
+                _out += '%';
+            }
+        }
+        std::size_t const signLength =
+                (_out.size() > start && std::strchr("+- ", _out[start]) != nullptr) ? 1 : 0;
+        _pad(start, signLength, '>');
+    }
+
+    void _string(std::string const& v) {
+        if (!_spec->dateFormat.empty() || (_spec->type != 0 && _spec->type != 's')) {
+            _typeError("a string");
+        }
+        std::size_t const start = _out.size();
+        if (_spec->precision >= 0 && static_cast<std::size_t>(_spec->precision) < v.size()) {
+            _out.append(v, 0, _spec->precision);
+        } else {
+            _out += v;
+        }
+        _pad(start, 0, '<');
+    }
+
+    void _date(DateFields const& fields) {
+        std::string const& format = _spec->dateFormat;
+        for (std::size_t i = 0; i < format.size(); ++i) {
+            if (format[i] != '%') {
+                _out += format[i];
+                continue;
+            }
+            switch (format[++i]) {
+                case 'Y':
+                    appendDigits(_out, fields.year, 4);
+                    break;
+                case 'y':
+                    appendDigits(_out, fields.year % 100, 2);
+                    break;
+                case 'm':
+                    appendDigits(_out, fields.month, 2);
+                    break;
+                case 'd':
+                    appendDigits(_out, fields.day, 2);
+                    break;
+                case 'j':
+                    appendDigits(_out,
+                                 daysFromCivil(fields.year, fields.month, fields.day) -
+                                         daysFromCivil(fields.year, 1, 1) + 1,
+                                 3);
+                    break;
+                case 'H':
+                    appendDigits(_out, fields.hour, 2);
+                    break;
+                case 'M':
+                    appendDigits(_out, fields.minute, 2);
+                    break;
+                case 'S':
+                    appendDigits(_out, fields.second, 2);
+                    break;
+                case 'f':
+                    appendDigits(_out, fields.nsec / 1000, 6);
+                    break;
+                default:
+                    _out += '%';
+                    break;
+            }
+        }
+    }
+
+    // Pad the text appended since start to the width of the specification
+    void _pad(std::size_t start, std::size_t signLength, char defaultAlign) {
+        std::size_t const length = _out.size() - start;
+        std::size_t const width = static_cast<std::size_t>(_spec->width);
+        if (length >= width) {
+            return;
+        }
+        std::size_t const n = width - length;
+        char const fill = _spec->fill;
+        switch (_spec->align != 0 ? _spec->align : defaultAlign) {
+            case '<':
+                _out.append(n, fill);
+                break;
+            case '^':
+                _out.insert(start, n / 2, fill);
+                _out.append(n - n / 2, fill);
+                break;
+            case '=':
+                _out.insert(start + signLength, n, fill);
+                break;
+            default:
+                _out.insert(start, n, fill);
+                break;
+        }
+    }
+
+    std::string& _out;
+    Spec const* _spec;
+    std::string const* _name;
+    std::size_t _skip;  // number of values of an array still to skip
+};
+
+PropertyTemplate::PropertyTemplate(std::string const& format) : _format(format) {
+    std::string literal;
+    auto flush = [this, &literal]() {
+        if (!literal.empty()) {
+            _steps.push_back(Step{false, literal, Spec()});
+            literal.clear();
+        }
+    };
+    for (std::size_t i = 0; i < format.size(); ++i) {
+        char const c = format[i];
+        if (c == '{' && i + 1 < format.size() && format[i + 1] == '{') {
+            literal += '{';
+            ++i;
+        } else if (c == '}' && i + 1 < format.size() && format[i + 1] == '}') {
+            literal += '}';
+            ++i;
+        } else if (c == '{') {
+            std::size_t const end = format.find('}', i + 1);
+            if (end == std::string::npos) {
+                throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                                  "Unterminated field in template '" + format + "'");
+            }
+            std::string const field = format.substr(i + 1, end - i - 1);
+            std::size_t const colon = field.find(':');
+            std::string const name = field.substr(0, colon);
+            if (name.empty() || name.find('{') != std::string::npos) {
+                throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                                  "Invalid field '{" + field + "}' in template '" + format + "'");
+            }
+            flush();
+            std::string const spec = colon == std::string::npos ? std::string() : field.substr(colon + 1);
+            _steps.push_back(Step{true, name, _parseSpec(spec)});
+            i = end;
+        } else if (c == '}') {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "Single '}' in template '" + format + "'");
+        } else {
+            literal += c;
+        }
+    }
+    flush();
+}
+
+PropertyTemplate::~PropertyTemplate() noexcept = default;
+PropertyTemplate::PropertyTemplate(PropertyTemplate const&) = default;
+PropertyTemplate::PropertyTemplate(PropertyTemplate&&) = default;
+PropertyTemplate& PropertyTemplate::operator=(PropertyTemplate const&) = default;
+PropertyTemplate& PropertyTemplate::operator=(PropertyTemplate&&) = default;
+
+std::vector<std::string> PropertyTemplate::getNames() const {
+    std::vector<std::string> names;
+    std::unordered_set<std::string> seen;
+    for (auto const& step : _steps) {
+        if (step.isField && seen.insert(step.text).second) {
+            names.push_back(step.text);
+        }
+    }
+    return names;
+}
+
+std::string PropertyTemplate::render(PropertySet const& properties) const {
+    std::string out;
+    render(properties, out);
+    return out;
+}
+
+void PropertyTemplate::render(PropertySet const& properties, std::string& out) const {
+    Renderer renderer(out);
+    for (auto const& step : _steps) {
+        if (step.isField) {
+            renderer.render(properties, step);
+        } else {
+            out += step.text;
+        }
+    }
+}
+
+std::vector<std::string> PropertyTemplate::render(
+        std::vector<PropertySet::ConstPtr> const& properties) const {
+    std::vector<std::string> results;
+    results.reserve(properties.size());
+    std::string buffer;
+    for (auto const& p : properties) {
+        if (!p) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Null PropertySet");
+        }
+        buffer.clear();
+        render(*p, buffer);
+        results.push_back(buffer);
+    }
+    return results;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+PropertyTemplate::Spec PropertyTemplate::_parseSpec(std::string const& spec) {
+    Spec result{' ', 0, 0, 0, -1, 0, std::string()};
+    auto invalid = [&spec]() {
+        return LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                           "Invalid format specification '" + spec + "'");
+    };
+    // A lone '%' is the percent type; a date format starts with a directive
+    if (spec.size() > 1 && spec[0] == '%' && std::strchr(DATE_DIRECTIVES, spec[1]) != nullptr) {
+        for (std::size_t i = 0; i < spec.size(); ++i) {
+            if (spec[i] == '%') {
+                if (++i == spec.size() || spec[i] == '\0' ||
+                    std::strchr(DATE_DIRECTIVES, spec[i]) == nullptr) {
+                    throw invalid();
+                }
+            }
+        }
+        result.dateFormat = spec;
+        return result;
+    }
+    auto isAlign = [](char c) { return c == '<' || c == '>' || c == '^' || c == '='; };
+    auto isDigit = [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; };
+    std::size_t i = 0;
+    std::size_t const n = spec.size();
+    if (n >= 2 && isAlign(spec[1])) {
+        result.fill = spec[0];
+        result.align = spec[1];
+        i = 2;
+    } else if (n >= 1 && isAlign(spec[0])) {
+        result.align = spec[0];
+        i = 1;
+    }
+    if (i < n && (spec[i] == '+' || spec[i] == '-' || spec[i] == ' ')) {
+        result.sign = spec[i] == '-' ? 0 : spec[i];
+        ++i;
+    }
+    if (i < n && spec[i] == '0') {
+        if (result.align == 0) {
+            result.fill = '0';
+            result.align = '=';
+        }
+        ++i;
+    }
+    for (; i < n && isDigit(spec[i]); ++i) {
+        result.width = 10 * result.width + (spec[i] - '0');
+        if (result.width > 1000000) {
+            throw invalid();
+        }
+    }
+    if (i < n && spec[i] == '.') {
+        if (++i == n || !isDigit(spec[i])) {
+            throw invalid();
+        }
+        result.precision = 0;
+        for (; i < n && isDigit(spec[i]); ++i) {
+            result.precision = 10 * result.precision + (spec[i] - '0');
+            if (result.precision > 1000) {
+                throw invalid();
+            }
+        }
+    }
+    if (i < n && spec[i] != '\0' && std::strchr(TYPES, spec[i]) != nullptr) {
+        result.type = spec[i];
+        ++i;
+    }
+    if (i != n) {
+        throw invalid();
+    }
+    return result;
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -0,0 +1,255 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/StaticPropertyList.h"
+
+#include <cstring>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/daf/base/PropertyBuilder.h"
+#include "lsst/daf/base/PropertyList.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// FNV-1a hash of a name, compared before the names themselves
+std::uint32_t hashName(char const* name, std::size_t length) {
+    std::uint32_t hash = 2166136261U;
+    for (std::size_t i = 0; i < length; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 16777619U;
+    }
+    return hash;
+}
+
+template <typename T>
+T loadValue(unsigned char const* value) {
+    T v;
+    std::memcpy(&v, value, sizeof(v));
+    return v;
+}
+
+template <typename T>
+void emitValue(unsigned char const* value, PropertyHandler& handler) {
+    handler.value(loadValue<T>(value));
+}
+
+}  // namespace
+
+bool StaticPropertyListBase::exists(char const* name) const noexcept { return _find(name) != nullptr; }
+
+std::type_info const& StaticPropertyListBase::typeOf(char const* name) const { return *_at(name).type; }
+
+template <>
+std::string StaticPropertyListBase::get<std::string>(char const* name) const {
+    Entry const& entry = _at(name);
+    if (*entry.type != typeid(std::string)) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, std::string(name));
+    }
+    return std::string(_arena + entry.string, entry.stringLength);
+}
+
+template <>
+DateTime StaticPropertyListBase::get<DateTime>(char const* name) const {
+    long long nsecs;
+    _get(name, typeid(DateTime), &nsecs, sizeof(nsecs));
+    return DateTime(nsecs, DateTime::TAI);
+}
+
+char const* StaticPropertyListBase::getComment(char const* name) const {
+    Entry const& entry = _at(name);
+    return entry.commentLength == 0 ? "" : _arena + entry.comment;
+}
+
+void StaticPropertyListBase::setComment(char const* name, char const* comment) {
+    Entry const& entry = _at(name);
+    _set(name, *entry.type, entry.value, sizeof(entry.value), nullptr, comment);
+}
+
+void StaticPropertyListBase::walk(PropertyHandler& handler) const {
+    handler.beginSet(_size);
+    std::string name;
+    std::string comment;
+    for (std::size_t i = 0; i < _size; ++i) {
+        Entry const& entry = _entries[i];
+        std::type_info const& t = *entry.type;
+        name.assign(_arena + entry.name, entry.nameLength);
+        handler.key(name);
+        if (t == typeid(std::string)) {
+            handler.value(std::string(_arena + entry.string, entry.stringLength));
+        } else if (t == typeid(DateTime)) {
+            handler.value(DateTime(loadValue<long long>(entry.value), DateTime::TAI));
+        } else if (t == typeid(bool)) {
+            emitValue<bool>(entry.value, handler);
+        } else if (t == typeid(char)) {
+            emitValue<char>(entry.value, handler);
+        } else if (t == typeid(signed char)) {
+            emitValue<signed char>(entry.value, handler);
+        } else if (t == typeid(unsigned char)) {
+            emitValue<unsigned char>(entry.value, handler);
+        } else if (t == typeid(short)) {
+            emitValue<short>(entry.value, handler);
+        } else if (t == typeid(unsigned short)) {
+            emitValue<unsigned short>(entry.value, handler);
+        } else if (t == typeid(int)) {
+            emitValue<int>(entry.value, handler);
+        } else if (t == typeid(unsigned int)) {
+            emitValue<unsigned int>(entry.value, handler);
+        } else if (t == typeid(long)) {
+            emitValue<long>(entry.value, handler);
+        } else if (t == typeid(unsigned long)) {
+            emitValue<unsigned long>(entry.value, handler);
+        } else if (t == typeid(long long)) {
+            emitValue<long long>(entry.value, handler);
+        } else if (t == typeid(unsigned long long)) {
+            emitValue<unsigned long long>(entry.value, handler);
+        } else if (t == typeid(float)) {
+            emitValue<float>(entry.value, handler);
+        } else if (t == typeid(double)) {
+            emitValue<double>(entry.value, handler);
+        } else {
+            throw LSST_EXCEPT(pex::exceptions::TypeError, std::string("Unknown value type ") + t.name());
+        }
+        comment.assign(_arena + entry.comment, entry.commentLength);
+        handler.comment(comment);
+    }
+    handler.endSet();
+}
+
+std::shared_ptr<PropertyList> StaticPropertyListBase::toPropertyList() const {
+    auto result = std::make_shared<PropertyList>();
+    PropertyBuilder builder(result);
+    walk(builder);
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+StaticPropertyListBase::Entry const* StaticPropertyListBase::_find(char const* name) const noexcept {
+    std::size_t const length = std::strlen(name);
+    std::uint32_t const hash = hashName(name, length);
+    for (std::size_t i = 0; i < _size; ++i) {
+        Entry const& entry = _entries[i];
+        if (entry.hash == hash && entry.nameLength == length &&
+            std::memcmp(_arena + entry.name, name, length) == 0) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+StaticPropertyListBase::Entry const& StaticPropertyListBase::_at(char const* name) const {
+    Entry const* entry = _find(name);
+    if (entry == nullptr) {
+        throw LSST_EXCEPT(pex::exceptions::NotFoundError, std::string(name) + " not found");
+    }
+    return *entry;
+}
+
+void StaticPropertyListBase::_get(char const* name, std::type_info const& type, void* value,
+                                  std::size_t size) const {
+    Entry const& entry = _at(name);
+    if (*entry.type != type) {
+        throw LSST_EXCEPT(pex::exceptions::TypeError, std::string(name));
+    }
+    std::memcpy(value, entry.value, size);
+}
+
+void StaticPropertyListBase::_set(char const* name, std::type_info const& type, void const* value,
+                                  std::size_t size, char const* string, char const* comment) {
+    std::size_t const nameLength = std::strlen(name);
+    std::size_t const stringLength = string != nullptr ? std::strlen(string) : 0;
+    std::size_t const commentLength = comment != nullptr ? std::strlen(comment) : 0;
+    Entry* entry = const_cast<Entry*>(_find(name));
+
+    // Check all the space needed before changing anything
+    std::size_t needed = 0;
+    if (entry == nullptr) {
+        if (_size == _maxKeys) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              "No room for " + std::string(name) + ": all " + std::to_string(_maxKeys) +
+                                      " keys are in use");
+        }
+        needed += nameLength + 1;
+    }
+    bool const newString = stringLength > (entry != nullptr ? entry->stringCapacity : 0);
+    bool const newComment = commentLength > (entry != nullptr ? entry->commentCapacity : 0);
+    if (newString) needed += stringLength + 1;
+    if (newComment) needed += commentLength + 1;
+    if (needed > _maxBytes - _used) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "No room for " + std::string(name) + ": " + std::to_string(needed) +
+                                  " bytes needed, " + std::to_string(_maxBytes - _used) + " available");
+    }
+
+    if (entry == nullptr) {
+        entry = &_entries[_size++];
+        entry->hash = hashName(name, nameLength);
+        entry->name = _store(name, nameLength);
+        entry->nameLength = nameLength;
+        entry->string = entry->stringLength = entry->stringCapacity = 0;
+        entry->comment = entry->commentLength = entry->commentCapacity = 0;
+    }
+    entry->type = &type;
+    if (value != entry->value) {
+        std::memset(entry->value, 0, sizeof(entry->value));
+        if (value != nullptr) {  // null for strings
+            std::memcpy(entry->value, value, size);
+        }
+    }
+    if (string != nullptr) {
+        if (newString) {
+            entry->string = _store(string, stringLength);
+            entry->stringCapacity = stringLength;
+        } else if (entry->stringCapacity > 0) {
+            std::memcpy(_arena + entry->string, string, stringLength + 1);
+        }
+        entry->stringLength = stringLength;
+    }
+    if (comment != nullptr) {
+        if (newComment) {
+            entry->comment = _store(comment, commentLength);
+            entry->commentCapacity = commentLength;
+        } else if (entry->commentCapacity > 0) {
+            std::memcpy(_arena + entry->comment, comment, commentLength + 1);
+        }
+        entry->commentLength = commentLength;
+    }
+}
+
+std::uint32_t StaticPropertyListBase::_store(char const* s, std::size_t length) noexcept {
+    std::uint32_t const offset = _used;
+    std::memcpy(_arena + offset, s, length);
+    _arena[offset + length] = '\0';
+    _used += length + 1;
+    return offset;
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -0,0 +1,261 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/TimeSeries.h"
+
+#include <algorithm>
+
+#include "lsst/pex/exceptions.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+// Smallest storage allocated for a series without a capacity limit
+std::size_t const MIN_BUFFER_SIZE = 16;
+
+}  // namespace
+
+struct TimeSeries::Buffer {
+    explicit Buffer(std::size_t size_)
+            : times(new long long[size_]), values(new double[size_]), size(size_), used(0) {}
+
+    std::unique_ptr<long long[]> times;
+    std::unique_ptr<double[]> values;
+    std::size_t size;  // number of samples allocated
+    std::size_t used;  // index past the last sample written by any series sharing this buffer
+};
+
+TimeSeries::TimeSeries(std::size_t capacity) : _capacity(capacity), _buffer(), _begin(0), _size(0) {}
+
+TimeSeries::~TimeSeries() noexcept = default;
+
+TimeSeries::TimeSeries(TimeSeries const&) = default;
+
+TimeSeries::TimeSeries(TimeSeries&& other)
+        : Persistable(other),
+          _capacity(other._capacity),
+          _buffer(std::move(other._buffer)),
+          _begin(other._begin),
+          _size(other._size) {
+    other._begin = other._size = 0;
+}
+
+TimeSeries& TimeSeries::operator=(TimeSeries const&) = default;
+
+TimeSeries& TimeSeries::operator=(TimeSeries&& other) {
+    if (this != &other) {
+        _capacity = other._capacity;
+        _buffer = std::move(other._buffer);
+        _begin = other._begin;
+        _size = other._size;
+        other._begin = other._size = 0;
+    }
+    return *this;
+}
+
+void TimeSeries::append(DateTime const& time, double value) {
+    if (!time.isValid()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Cannot append a sample with an invalid time");
+    }
+    long long const nsecs = time.nsecs();
+    bool const full = _capacity > 0 && _size == _capacity;
+    if (_size == 0 || nsecs >= _buffer->times[_begin + _size - 1]) {
+        if (full) {
+            ++_begin;
+            --_size;
+        }
+        _reserve(1, false);
+    } else {
+        // Out of order: make room at the right place
+        long long const* first = _buffer->times.get() + _begin;
+        std::size_t position = std::upper_bound(first, first + _size, nsecs) - first;
+        if (full) {
+            if (position == 0) {
+                return;
+            }
+            ++_begin;
+            --_size;
+            --position;
+        }
+        _reserve(1, true);
+        long long* times = _buffer->times.get() + _begin;
+        double* values = _buffer->values.get() + _begin;
+        std::copy_backward(times + position, times + _size, times + _size + 1);
+        std::copy_backward(values + position, values + _size, values + _size + 1);
+        times[position] = nsecs;
+        values[position] = value;
+        ++_size;
+        _buffer->used = _begin + _size;
+        return;
+    }
+    std::size_t const end = _begin + _size;
+    _buffer->times[end] = nsecs;
+    _buffer->values[end] = value;
+    ++_size;
+    _buffer->used = end + 1;
+}
+
+DateTime TimeSeries::getTime(std::size_t index) const {
+    if (index >= _size) {
+        throw LSST_EXCEPT(pex::exceptions::OutOfRangeError, "Sample index out of range");
+    }
+    return DateTime(_buffer->times[_begin + index], DateTime::TAI);
+}
+
+double TimeSeries::getValue(std::size_t index) const {
+    if (index >= _size) {
+        throw LSST_EXCEPT(pex::exceptions::OutOfRangeError, "Sample index out of range");
+    }
+    return _buffer->values[_begin + index];
+}
+
+double TimeSeries::valueAt(DateTime const& time) const {
+    if (_size > 0) {
+        long long const* first = _buffer->times.get() + _begin;
+        std::size_t const n = std::upper_bound(first, first + _size, time.nsecs()) - first;
+        if (n > 0) {
+            return _buffer->values[_begin + n - 1];
+        }
+    }
+    throw LSST_EXCEPT(pex::exceptions::NotFoundError, "No sample at or before the requested time");
+}
+
+TimeSeries::Ptr TimeSeries::range(DateTime const& begin, DateTime const& end) const {
+    auto result = std::make_shared<TimeSeries>(*this);
+    result->_capacity = 0;
+    if (_size > 0) {
+        long long const* first = _buffer->times.get() + _begin;
+        std::size_t const lo = std::lower_bound(first, first + _size, begin.nsecs()) - first;
+        std::size_t const hi = std::lower_bound(first, first + _size, end.nsecs()) - first;
+        result->_begin += lo;
+        result->_size = std::max(lo, hi) - lo;
+    }
+    return result;
+}
+
+TimeSeries::Ptr TimeSeries::downsample(std::chrono::nanoseconds interval, Aggregation aggregation) const {
+    long long const width = interval.count();
+    if (width <= 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Downsampling interval must be positive");
+    }
+    auto result = std::make_shared<TimeSeries>();
+    std::size_t i = 0;
+    while (i < _size) {
+        long long const* times = _buffer->times.get() + _begin;
+        double const* values = _buffer->values.get() + _begin;
+        // Start of the interval containing sample i, rounding towards minus infinity
+        long long start = times[i] / width;
+        if (times[i] % width < 0) {
+            --start;
+        }
+        start *= width;
+        double aggregate = values[i];
+        double sum = 0.0;
+        std::size_t const first = i;
+        // Unsigned differences cannot overflow
+        auto const inInterval = [start, width](long long t) {
+            return static_cast<unsigned long long>(t) - static_cast<unsigned long long>(start) <
+                   static_cast<unsigned long long>(width);
+        };
+        for (; i < _size && inInterval(times[i]); ++i) {
+            switch (aggregation) {
+                case LAST:
+                    aggregate = values[i];
+                    break;
+                case MEAN:
+                    sum += values[i];
+                    break;
+                case MIN:
+                    aggregate = std::min(aggregate, values[i]);
+                    break;
+                case MAX:
+                    aggregate = std::max(aggregate, values[i]);
+                    break;
+                default:
+                    break;
+            }
+        }
+        if (aggregation == MEAN) {
+            aggregate = sum / (i - first);
+        }
+        result->append(DateTime(start, DateTime::TAI), aggregate);
+    }
+    return result;
+}
+
+std::shared_ptr<long long const> TimeSeries::getTimes() const {
+    if (_size == 0) {
+        return std::shared_ptr<long long const>();
+    }
+    return std::shared_ptr<long long const>(_buffer, _buffer->times.get() + _begin);
+}
+
+std::shared_ptr<double const> TimeSeries::getValues() const {
+    if (_size == 0) {
+        return std::shared_ptr<double const>();
+    }
+    return std::shared_ptr<double const>(_buffer, _buffer->values.get() + _begin);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+void TimeSeries::_reserve(std::size_t n, bool modify) {
+    std::size_t const end = _begin + _size;
+    if (_buffer) {
+        bool const unique = _buffer.use_count() == 1;
+        if (end + n <= _buffer->size && (unique || (!modify && end >= _buffer->used))) {
+            return;
+        }
+        if (unique && _size + n <= _buffer->size / 2) {
+            // Enough room once the discarded samples are reclaimed
+            std::copy(_buffer->times.get() + _begin, _buffer->times.get() + end, _buffer->times.get());
+            std::copy(_buffer->values.get() + _begin, _buffer->values.get() + end, _buffer->values.get());
+            _begin = 0;
+            _buffer->used = _size;
+            return;
+        }
+    }
+    // Move to new storage: twice the capacity for a ring, or room to grow geometrically
+    std::size_t const required = _size + n;
+    std::size_t const size =
+            _capacity > 0 ? std::max(2 * _capacity, required) : std::max(2 * required, MIN_BUFFER_SIZE);
+    auto buffer = std::make_shared<Buffer>(size);
+    if (_size > 0) {
+        std::copy(_buffer->times.get() + _begin, _buffer->times.get() + end, buffer->times.get());
+        std::copy(_buffer->values.get() + _begin, _buffer->values.get() + end, buffer->values.get());
+    }
+    buffer->used = _size;
+    _buffer = std::move(buffer);
+    _begin = 0;
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
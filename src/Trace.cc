@@ -0,0 +1,284 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lsst/daf/base/Trace.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include <unistd.h>
+
+#include "lsst/pex/exceptions.h"
+
+namespace lsst {
+namespace daf {
+namespace base {
+
+namespace {
+
+struct Event {
+    char const* name;
+    char const* category;
+    std::int64_t start;     // nanoseconds since the trace epoch
+    std::int64_t duration;  // nanoseconds
+};
+
+// Single-producer, single-consumer queue of the spans completed by one thread
+class Buffer {
+public:
+    explicit Buffer(std::uint64_t id_)
+            : id(id_), finished(false), dropped(0), _events(Trace::BUFFER_SIZE), _head(0), _tail(0) {}
+
+    // Called only by the owning thread
+    void push(Event const& event) noexcept {
+        std::size_t const head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) == _events.size()) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _events[head % _events.size()] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    // Called by one thread at a time, holding the registry mutex
+    template <typename F>
+    void drain(F func) {
+        std::size_t tail = _tail.load(std::memory_order_relaxed);
+        std::size_t const head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            func(_events[tail % _events.size()]);
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    std::uint64_t const id;              // reported as the thread id
+    std::atomic<bool> finished;          // owning thread has exited
+    std::atomic<std::uint64_t> dropped;  // spans dropped because the buffer was full
+
+private:
+    std::vector<Event> _events;
+    std::atomic<std::size_t> _head;  // number of spans pushed
+    std::atomic<std::size_t> _tail;  // number of spans drained
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<Buffer>> buffers;
+    std::uint64_t nextId = 1;
+    std::uint64_t retiredDropped = 0;  // spans dropped by buffers of exited threads
+    std::unordered_set<std::string> names;
+};
+
+Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+std::atomic<unsigned> sampleInterval(1);
+std::atomic<std::int64_t> minDuration(0);
+std::chrono::steady_clock::time_point const epoch = std::chrono::steady_clock::now();
+
+std::int64_t now() noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch)
+            .count();
+}
+
+struct ThreadState {
+    std::shared_ptr<Buffer> buffer;  // created when the thread first records a span
+    unsigned depth = 0;              // number of active spans
+    bool sampled = false;            // whether the active outermost span is recorded
+    std::uint64_t count = 0;         // number of outermost spans started
+
+    ~ThreadState() {
+        if (buffer) {
+            buffer->finished.store(true, std::memory_order_release);
+        }
+    }
+
+    Buffer& getBuffer() {
+        if (!buffer) {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            buffer = std::make_shared<Buffer>(registry.nextId++);
+            registry.buffers.push_back(buffer);
+        }
+        return *buffer;
+    }
+};
+
+thread_local ThreadState threadState;
+
+void appendJsonString(std::string& out, char const* s) {
+    out += '"';
+    for (; *s; ++s) {
+        unsigned char const c = *s;
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+            out += escape;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+// Discard the buffers of exited threads, once drained
+void retireFinished(Registry& registry) {
+    auto& buffers = registry.buffers;
+    auto const finished = [&registry](std::shared_ptr<Buffer> const& b) {
+        if (b->finished.load(std::memory_order_acquire)) {
+            registry.retiredDropped += b->dropped.load(std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    };
+    auto const end = std::remove_if(buffers.begin(), buffers.end(), finished);
+    buffers.erase(end, buffers.end());
+}
+
+}  // namespace
+
+std::atomic<bool> Trace::_enabled(false);
+
+void Trace::enable(unsigned interval, std::chrono::nanoseconds duration) {
+    if (interval == 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Trace sample interval must be positive");
+    }
+    sampleInterval.store(interval, std::memory_order_relaxed);
+    minDuration.store(duration.count(), std::memory_order_relaxed);
+    _enabled.store(true, std::memory_order_relaxed);
+}
+
+void Trace::disable() noexcept { _enabled.store(false, std::memory_order_relaxed); }
+
+std::size_t Trace::flush(std::ostream& os) {
+    Registry& registry = getRegistry();
+    std::string out = "{\"traceEvents\":[";
+    std::size_t n = 0;
+    long const pid = ::getpid();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (auto const& buffer : registry.buffers) {
+            buffer->drain([&](Event const& event) {
+                out += n++ == 0 ? "\n" : ",\n";
+                out += "{\"name\":";
+                appendJsonString(out, event.name);
+                out += ",\"cat\":";
+                appendJsonString(out, event.category);
+                char fields[128];
+                std::snprintf(fields, sizeof(fields),
+                              ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%ld,\"tid\":%llu}",
+                              event.start * 1.0e-3, event.duration * 1.0e-3, pid,
+                              static_cast<unsigned long long>(buffer->id));
+                out += fields;
+            });
+        }
+        retireFinished(registry);
+    }
+    out += "\n],\"displayTimeUnit\":\"ns\"}\n";
+    os << out;
+    return n;
+}
+
+std::size_t Trace::flush(std::string const& path) {
+    std::ofstream os(path);
+    if (!os) {
+        throw LSST_EXCEPT(pex::exceptions::IoError, "Cannot open trace file " + path);
+    }
+    std::size_t const n = flush(os);
+    os.close();
+    if (!os) {
+        throw LSST_EXCEPT(pex::exceptions::IoError, "Cannot write trace file " + path);
+    }
+    return n;
+}
+
+void Trace::clear() noexcept {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto const& buffer : registry.buffers) {
+        buffer->drain([](Event const&) {});
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+    retireFinished(registry);
+    registry.retiredDropped = 0;
+}
+
+std::uint64_t Trace::getDropped() noexcept {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::uint64_t dropped = registry.retiredDropped;
+    for (auto const& buffer : registry.buffers) {
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+char const* Trace::intern(std::string const& name) {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.names.insert(name).first->c_str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Private member functions
+///////////////////////////////////////////////////////////////////////////////
+
+void TraceSpan::_begin() noexcept {
+    ThreadState& state = threadState;
+    if (state.depth++ == 0) {
+        state.sampled = state.count++ % sampleInterval.load(std::memory_order_relaxed) == 0;
+    }
+    _start = state.sampled ? now() : SKIPPED;
+}
+
+void TraceSpan::_end() noexcept {
+    ThreadState& state = threadState;
+    --state.depth;
+    if (_start == SKIPPED) {
+        return;
+    }
+    std::int64_t const duration = now() - _start;
+    if (duration < minDuration.load(std::memory_order_relaxed)) {
+        return;
+    }
+    try {
+        state.getBuffer().push(Event{_name, _category, _start, duration});
+    } catch (...) {
+        // Tracing must not disturb the code being traced; the span is lost
+    }
+}
+
+}  // namespace base
+}  // namespace daf
+}  // namespace lsst
@@ -0,0 +1,172 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "lsst/daf/base/AsOfJoin.h"
+#include "lsst/daf/base/DateTime.h"
+
+#define BOOST_TEST_MODULE AsOfJoin
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+long long const NO = dafBase::AsOfJoin::NO_MATCH;
+
+// Straightforward join of one left time, for comparison
+long long joinOne(long long t, std::vector<long long> const& right, dafBase::AsOfJoin const& join) {
+    long long const tolerance = join.getTolerance().count();
+    bool const exact = join.getAllowExactMatches();
+    long long previous = NO;
+    long long next = NO;
+    for (std::size_t j = 0; j < right.size(); ++j) {
+        if (right[j] < t || (exact && right[j] == t)) {
+            previous = j;
+        }
+        if (next == NO && (right[j] > t || (exact && right[j] == t))) {
+            next = j;
+        }
+    }
+    if (previous != NO && t - right[previous] > tolerance) previous = NO;
+    if (next != NO && right[next] - t > tolerance) next = NO;
+    switch (join.getDirection()) {
+        case dafBase::AsOfJoin::BACKWARD:
+            return previous;
+        case dafBase::AsOfJoin::FORWARD:
+            return next;
+        default:
+            if (previous == NO) return next;
+            if (next == NO) return previous;
+            return right[next] - t < t - right[previous] ? next : previous;
+    }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(AsOfJoinSuite)
+
+BOOST_AUTO_TEST_CASE(directions) {
+    std::vector<long long> const right = {10, 20, 20, 30};
+    std::vector<long long> const left = {5, 10, 15, 20, 26, 30, 35};
+
+    dafBase::AsOfJoin const backward;
+    std::vector<long long> expected = {NO, 0, 0, 2, 2, 3, 3};
+    BOOST_CHECK(backward(left, right) == expected);
+
+    dafBase::AsOfJoin const forward(dafBase::AsOfJoin::FORWARD);
+    expected = {0, 0, 1, 1, 3, 3, NO};
+    BOOST_CHECK(forward(left, right) == expected);
+
+    dafBase::AsOfJoin const nearest(dafBase::AsOfJoin::NEAREST);
+    expected = {0, 0, 0, 2, 3, 3, 3};
+    BOOST_CHECK(nearest(left, right) == expected);
+
+    // Strict inequalities
+    auto const any = std::chrono::nanoseconds::max();
+    dafBase::AsOfJoin const strictBackward(dafBase::AsOfJoin::BACKWARD, any, false);
+    expected = {NO, NO, 0, 0, 2, 2, 3};
+    BOOST_CHECK(strictBackward(left, right) == expected);
+    dafBase::AsOfJoin const strictForward(dafBase::AsOfJoin::FORWARD, any, false);
+    expected = {0, 1, 1, 3, 3, NO, NO};
+    BOOST_CHECK(strictForward(left, right) == expected);
+
+    // Tolerance
+    dafBase::AsOfJoin const close(dafBase::AsOfJoin::NEAREST, std::chrono::nanoseconds(4));
+    expected = {NO, 0, NO, 2, 3, 3, NO};
+    BOOST_CHECK(close(left, right) == expected);
+
+    BOOST_CHECK(backward(std::vector<long long>(), right).empty());
+    expected = {NO, NO, NO, NO, NO, NO, NO};
+    BOOST_CHECK(nearest(left, std::vector<long long>()) == expected);
+}
+
+BOOST_AUTO_TEST_CASE(dateTimes) {
+    dafBase::DateTime const t0("2026-01-15T00:00:00Z", dafBase::DateTime::UTC);
+    std::vector<dafBase::DateTime> right;
+    for (int i = 0; i < 10; ++i) {
+        right.push_back(t0 + std::chrono::seconds(10 * i));
+    }
+    std::vector<dafBase::DateTime> left = {dafBase::DateTime(), t0 + std::chrono::seconds(25),
+                                           t0 + std::chrono::hours(1)};
+    dafBase::AsOfJoin const join(dafBase::AsOfJoin::BACKWARD, std::chrono::minutes(1));
+    std::vector<long long> const expected = {NO, 2, NO};
+    BOOST_CHECK(join(left, right) == expected);
+
+    // Invalid right times are never matched
+    right.insert(right.begin(), dafBase::DateTime());
+    left = {t0 - std::chrono::seconds(1), t0, t0 + std::chrono::seconds(10)};
+    dafBase::AsOfJoin const nearest(dafBase::AsOfJoin::NEAREST);
+    BOOST_CHECK(nearest(left, right) == std::vector<long long>({1, 1, 2}));
+    BOOST_CHECK(join(left, right) == std::vector<long long>({NO, 1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(randomized) {
+    // Many duplicates and gaps, joined in several chunks
+    std::mt19937 rng(1);
+    std::vector<long long> left(200000);
+    std::vector<long long> right(3000);
+    for (auto& t : left) t = rng() % 100000;
+    for (auto& t : right) t = rng() % 100000;
+    std::sort(left.begin(), left.end());
+    std::sort(right.begin(), right.end());
+    std::vector<dafBase::AsOfJoin::Direction> const directions = {
+            dafBase::AsOfJoin::BACKWARD, dafBase::AsOfJoin::FORWARD, dafBase::AsOfJoin::NEAREST};
+    for (auto direction : directions) {
+        for (bool exact : {true, false}) {
+            for (long long tolerance : {0LL, 7LL, 1000000LL}) {
+                dafBase::AsOfJoin const join(direction, std::chrono::nanoseconds(tolerance), exact);
+                std::vector<long long> const indices = join(left, right, 4);
+                int mismatches = 0;
+                for (std::size_t i = 0; i < left.size(); i += 97) {
+                    mismatches += indices[i] != joinOne(left[i], right, join);
+                }
+                BOOST_CHECK_EQUAL(mismatches, 0);
+                BOOST_CHECK(join(left, right, 1) == indices);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+    std::vector<long long> const sorted = {1, 2, 3};
+    std::vector<long long> const unsorted = {1, 3, 2};
+    dafBase::AsOfJoin const join;
+    BOOST_CHECK_THROW(join(unsorted, sorted), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(join(sorted, unsorted), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::AsOfJoin(dafBase::AsOfJoin::NEAREST, std::chrono::nanoseconds(-1)),
+                      pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
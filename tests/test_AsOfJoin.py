@@ -0,0 +1,88 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+
+"""Test AsOfJoin"""
+
+import unittest
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+NO = dafBase.AsOfJoin.NO_MATCH
+
+
+class AsOfJoinTestCase(unittest.TestCase):
+
+    def testDirections(self):
+        right = np.array([10, 20, 20, 30], dtype=np.int64)
+        left = np.array([5, 10, 15, 20, 26, 30, 35], dtype=np.int64)
+        join = dafBase.AsOfJoin()
+        self.assertEqual(join.getDirection(), dafBase.AsOfJoin.BACKWARD)
+        indices = join(left, right)
+        self.assertEqual(indices.dtype, np.int64)
+        np.testing.assert_array_equal(indices, [NO, 0, 0, 2, 2, 3, 3])
+        np.testing.assert_array_equal(dafBase.AsOfJoin(dafBase.AsOfJoin.FORWARD)(left, right),
+                                      [0, 0, 1, 1, 3, 3, NO])
+        np.testing.assert_array_equal(dafBase.AsOfJoin(dafBase.AsOfJoin.NEAREST)(left, right),
+                                      [0, 0, 0, 2, 3, 3, 3])
+        strict = dafBase.AsOfJoin(dafBase.AsOfJoin.BACKWARD, allowExactMatches=False)
+        np.testing.assert_array_equal(strict(left, right), [NO, NO, 0, 0, 2, 2, 3])
+        close = dafBase.AsOfJoin(dafBase.AsOfJoin.NEAREST, tolerance=np.timedelta64(4, "ns"))
+        np.testing.assert_array_equal(close(left, right), [NO, 0, NO, 2, 3, 3, NO])
+
+    def testStrided(self):
+        right = np.array([[10, 0], [20, 1], [20, 2], [30, 3]], dtype=np.int64)[:, 0]
+        left = np.array([5, -1, 10, -1, 15, -1, 20, -1, 26, -1, 30, -1, 35, -1], dtype=np.int64)[::2]
+        self.assertFalse(left.flags.c_contiguous)
+        self.assertFalse(right.flags.c_contiguous)
+        join = dafBase.AsOfJoin()
+        np.testing.assert_array_equal(join(left, right), [NO, 0, 0, 2, 2, 3, 3])
+
+    def testDateTimes(self):
+        t0 = 1700000000*10**9
+        right = [dafBase.DateTime(t0 + i*10**10, dafBase.DateTime.TAI) for i in range(10)]
+        # Invalid times sort first and never match
+        left = [dafBase.DateTime(), dafBase.DateTime(t0 + 25*10**9, dafBase.DateTime.TAI)]
+        self.assertEqual(dafBase.AsOfJoin()(left, right), [NO, 2])
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            dafBase.AsOfJoin()(left[::-1], right)
+
+    def testUnsorted(self):
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            dafBase.AsOfJoin()(np.array([3, 2, 1]), np.array([1, 2, 3]))
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -0,0 +1,130 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/daf/base/ConcurrentArray.h"
+#include "lsst/daf/base/PropertyList.h"
+
+#define BOOST_TEST_MODULE ConcurrentArray
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+namespace dafBase = lsst::daf::base;
+
+BOOST_AUTO_TEST_SUITE(ConcurrentArraySuite)
+
+BOOST_AUTO_TEST_CASE(sequential) {
+    dafBase::ConcurrentArray<int> array;
+    BOOST_CHECK_EQUAL(array.size(), 0u);
+    BOOST_CHECK(array.snapshot().empty());
+
+    // Enough values to span several segments
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_CHECK_EQUAL(array.add(i), static_cast<std::size_t>(i));
+    }
+    BOOST_CHECK_EQUAL(array.add(std::vector<int>{1000, 1001, 1002}), 1000u);
+    BOOST_CHECK_EQUAL(array.size(), 1003u);
+
+    std::vector<int> const values = array.snapshot();
+    BOOST_REQUIRE_EQUAL(values.size(), 1003u);
+    for (int i = 0; i < 1003; ++i) {
+        BOOST_CHECK_EQUAL(values[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(strings) {
+    dafBase::ConcurrentArray<std::string> history;
+    history.add("first card");
+    history.add(std::string(100, 'x'));
+
+    dafBase::PropertyList header;
+    header.set("HISTORY", std::string("existing"));
+    history.snapshot(header, "HISTORY");
+    std::vector<std::string> const cards = header.getArray<std::string>("HISTORY");
+    BOOST_REQUIRE_EQUAL(cards.size(), 2u);
+    BOOST_CHECK_EQUAL(cards[0], "first card");
+    BOOST_CHECK_EQUAL(cards[1], std::string(100, 'x'));
+}
+
+BOOST_AUTO_TEST_CASE(concurrent) {
+    int const nThreads = 8;
+    int const nPerThread = 20000;
+    dafBase::ConcurrentArray<long> array;
+    std::atomic<bool> done(false);
+
+    // Snapshots taken while writing must be prefixes of one another
+    // (Boost.Test assertions are not thread-safe, so only record the outcome)
+    int nSnapshots = 0;
+    bool prefixes = true;
+    std::thread reader([&]() {
+        std::vector<long> previous;
+        do {
+            std::vector<long> const current = array.snapshot();
+            prefixes = prefixes && current.size() >= previous.size() &&
+                       std::equal(previous.begin(), previous.end(), current.begin());
+            ++nSnapshots;
+            previous = current;
+        } while (!done);
+    });
+    std::vector<std::thread> writers;
+    for (int t = 0; t < nThreads; ++t) {
+        writers.emplace_back([&array, t]() {
+            for (int i = 0; i < nPerThread; ++i) {
+                array.add(static_cast<long>(t) * nPerThread + i);
+            }
+        });
+    }
+    for (auto& w : writers) {
+        w.join();
+    }
+    done = true;
+    reader.join();
+    BOOST_CHECK_GT(nSnapshots, 0);
+    BOOST_CHECK(prefixes);
+
+    // Every value is present once, and each thread's values are in order
+    std::vector<long> const values = array.snapshot();
+    BOOST_REQUIRE_EQUAL(values.size(), static_cast<std::size_t>(nThreads * nPerThread));
+    std::vector<long> last(nThreads, -1);
+    for (long v : values) {
+        int const t = v / nPerThread;
+        BOOST_CHECK_GT(v, last[t]);
+        last[t] = v;
+    }
+    std::vector<long> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) {
+        BOOST_REQUIRE_EQUAL(sorted[i], static_cast<long>(i));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,244 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "lsst/daf/base/HeaderCache.h"
+
+#define BOOST_TEST_MODULE HeaderCache
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Temporary file containing "NAME=VALUE" lines, removed on destruction
+class TempFile {
+public:
+    TempFile() {
+        char name[] = "/tmp/test_HeaderCache_XXXXXX";
+        int const fd = mkstemp(name);
+        BOOST_REQUIRE(fd >= 0);
+        close(fd);
+        path = name;
+    }
+    ~TempFile() { std::remove(path.c_str()); }
+
+    void write(std::string const& contents) {
+        std::ofstream os(path, std::ios::trunc);
+        os << contents;
+    }
+
+    std::string path;
+};
+
+// Loader that parses "NAME=VALUE" lines, records HDU 'hdu' as a card, and counts its calls
+struct CountingLoader {
+    std::shared_ptr<dafBase::PropertyList> operator()(std::string const& path, int hdu) {
+        ++calls;
+        if (delay.count() > 0) {
+            std::this_thread::sleep_for(delay);
+        }
+        auto header = std::make_shared<dafBase::PropertyList>();
+        std::ifstream is(path);
+        std::string line;
+        while (std::getline(is, line)) {
+            auto const eq = line.find('=');
+            header->set(line.substr(0, eq), line.substr(eq + 1), "from " + path);
+        }
+        header->set("HDU", hdu);
+        return header;
+    }
+
+    std::atomic<int> calls{0};
+    std::chrono::milliseconds delay{0};
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(HeaderCacheSuite)
+
+BOOST_AUTO_TEST_CASE(hitsAndMisses) {
+    TempFile file;
+    file.write("A=1\nB=2\n");
+    CountingLoader loader;
+    auto load = [&loader](std::string const& path, int hdu) { return loader(path, hdu); };
+    dafBase::HeaderCache cache;
+
+    auto const h1 = cache.get(file.path, 0, load);
+    auto const h2 = cache.get(file.path, 0, load);
+    BOOST_CHECK_EQUAL(loader.calls, 1);
+    BOOST_CHECK(h1 == h2);
+    BOOST_CHECK_EQUAL(h1->get<std::string>("A"), "1");
+    BOOST_CHECK_EQUAL(h1->get<int>("HDU"), 0);
+
+    // Each HDU is cached separately
+    auto const h3 = cache.get(file.path, 1, load);
+    BOOST_CHECK_EQUAL(loader.calls, 2);
+    BOOST_CHECK_EQUAL(h3->get<int>("HDU"), 1);
+
+    auto stats = cache.getStatistics();
+    BOOST_CHECK_EQUAL(stats.hits, 1u);
+    BOOST_CHECK_EQUAL(stats.misses, 2u);
+    BOOST_CHECK_EQUAL(stats.evictions, 0u);
+    BOOST_CHECK_EQUAL(stats.entries, 2u);
+    BOOST_CHECK_EQUAL(stats.bytes, dafBase::HeaderCache::estimateBytes(*h1) +
+                                           dafBase::HeaderCache::estimateBytes(*h3));
+
+    cache.erase(file.path, 0);
+    cache.get(file.path, 0, load);
+    BOOST_CHECK_EQUAL(loader.calls, 3);
+
+    cache.clear();
+    stats = cache.getStatistics();
+    BOOST_CHECK_EQUAL(stats.hits, 0u);
+    BOOST_CHECK_EQUAL(stats.misses, 0u);
+    BOOST_CHECK_EQUAL(stats.entries, 0u);
+    BOOST_CHECK_EQUAL(stats.bytes, 0u);
+}
+
+BOOST_AUTO_TEST_CASE(fileChanged) {
+    TempFile file;
+    file.write("A=1\n");
+    CountingLoader loader;
+    auto load = [&loader](std::string const& path, int hdu) { return loader(path, hdu); };
+    dafBase::HeaderCache cache;
+
+    auto const h1 = cache.get(file.path, 0, load);
+    file.write("A=22\n");
+    auto const h2 = cache.get(file.path, 0, load);
+    BOOST_CHECK_EQUAL(loader.calls, 2);
+    BOOST_CHECK_EQUAL(h1->get<std::string>("A"), "1");
+    BOOST_CHECK_EQUAL(h2->get<std::string>("A"), "22");
+    BOOST_CHECK_EQUAL(cache.getStatistics().entries, 1u);
+    BOOST_CHECK_EQUAL(cache.getStatistics().bytes, dafBase::HeaderCache::estimateBytes(*h2));
+}
+
+BOOST_AUTO_TEST_CASE(eviction) {
+    std::vector<std::unique_ptr<TempFile>> files;
+    for (int i = 0; i < 4; ++i) {
+        files.emplace_back(new TempFile);
+        files.back()->write("A=" + std::to_string(i) + "\n");
+    }
+    CountingLoader loader;
+    auto load = [&loader](std::string const& path, int hdu) { return loader(path, hdu); };
+    dafBase::HeaderCache cache;
+
+    std::size_t const bytes = dafBase::HeaderCache::estimateBytes(*cache.get(files[0]->path, 0, load));
+    cache.setMaxBytes(2 * bytes);
+    BOOST_CHECK_EQUAL(cache.getMaxBytes(), 2 * bytes);
+    cache.get(files[1]->path, 0, load);
+    cache.get(files[0]->path, 0, load);  // files[1] is now least recently used
+    cache.get(files[2]->path, 0, load);
+    auto stats = cache.getStatistics();
+    BOOST_CHECK_EQUAL(stats.entries, 2u);
+    BOOST_CHECK_EQUAL(stats.evictions, 1u);
+    BOOST_CHECK(stats.bytes <= 2 * bytes);
+
+    int const calls = loader.calls;
+    cache.get(files[0]->path, 0, load);
+    BOOST_CHECK_EQUAL(loader.calls, calls);
+    cache.get(files[1]->path, 0, load);
+    BOOST_CHECK_EQUAL(loader.calls, calls + 1);
+
+    // Evicted headers remain valid for those holding them
+    auto const held = cache.get(files[3]->path, 0, load);
+    cache.setMaxBytes(0);
+    stats = cache.getStatistics();
+    BOOST_CHECK_EQUAL(stats.entries, 0u);
+    BOOST_CHECK_EQUAL(stats.bytes, 0u);
+    BOOST_CHECK_EQUAL(held->get<std::string>("A"), "3");
+}
+
+BOOST_AUTO_TEST_CASE(singleFlight) {
+    TempFile file;
+    file.write("A=1\n");
+    CountingLoader loader;
+    loader.delay = std::chrono::milliseconds(100);
+    auto load = [&loader](std::string const& path, int hdu) { return loader(path, hdu); };
+    dafBase::HeaderCache cache;
+
+    int const nThreads = 8;
+    std::vector<std::shared_ptr<dafBase::PropertyList const>> results(nThreads);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < nThreads; ++i) {
+        threads.emplace_back([&, i]() { results[i] = cache.get(file.path, 0, load); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(loader.calls, 1);
+    for (auto const& r : results) {
+        BOOST_CHECK(r == results[0]);
+    }
+    auto const stats = cache.getStatistics();
+    BOOST_CHECK_EQUAL(stats.misses, 1u);
+    BOOST_CHECK_EQUAL(stats.hits, static_cast<std::uint64_t>(nThreads - 1));
+}
+
+BOOST_AUTO_TEST_CASE(loaderFailure) {
+    TempFile file;
+    file.write("A=1\n");
+    dafBase::HeaderCache cache;
+    int calls = 0;
+    auto fail = [&calls](std::string const&, int) -> std::shared_ptr<dafBase::PropertyList> {
+        ++calls;
+        throw LSST_EXCEPT(pexExcept::RuntimeError, "cannot read");
+    };
+    auto null = [](std::string const&, int) { return std::shared_ptr<dafBase::PropertyList>(); };
+
+    BOOST_CHECK_THROW(cache.get(file.path, 0, fail), pexExcept::RuntimeError);
+    BOOST_CHECK_THROW(cache.get(file.path, 0, fail), pexExcept::RuntimeError);
+    BOOST_CHECK_EQUAL(calls, 2);
+    BOOST_CHECK_THROW(cache.get(file.path, 0, null), pexExcept::InvalidParameterError);
+    BOOST_CHECK_EQUAL(cache.getStatistics().entries, 0u);
+
+    CountingLoader loader;
+    auto load = [&loader](std::string const& path, int hdu) { return loader(path, hdu); };
+    BOOST_CHECK_THROW(cache.get(file.path + ".missing", 0, load), pexExcept::IoError);
+    BOOST_CHECK_EQUAL(loader.calls, 0);
+    BOOST_CHECK_EQUAL(cache.get(file.path, 0, load)->get<std::string>("A"), "1");
+}
+
+BOOST_AUTO_TEST_CASE(instance) {
+    BOOST_CHECK(&dafBase::HeaderCache::getInstance() == &dafBase::HeaderCache::getInstance());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/MessagePack.h"
+#include "lsst/daf/base/PropertyBuilder.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/TimeSeries.h"
+
+#define BOOST_TEST_MODULE MessagePack
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+std::string bytes(std::vector<int> const& v) { return std::string(v.begin(), v.end()); }
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(MessagePackSuite)
+
+BOOST_AUTO_TEST_CASE(roundTripPropertySet) {
+    dafBase::PropertySet ps;
+    ps.set("bool", true);
+    ps.set<signed char>("sc", -5);
+    ps.set<unsigned char>("uc", 200);
+    ps.set<short>("short", -300);
+    ps.set<unsigned short>("ushort", 60000);
+    ps.set("int", 42);
+    ps.set("uint", 4000000000U);
+    ps.set("longlong", -(1LL << 40));
+    ps.set("ull", std::vector<unsigned long long>{1ULL, 18000000000000000000ULL});
+    ps.set("float", 2.5f);
+    ps.set("double", std::vector<double>{1.5, -0.25});
+    ps.set("str", std::string(300, 'x'));
+    ps.set("undef", nullptr);
+    ps.set("dt", dafBase::DateTime(1234567890123456789LL, dafBase::DateTime::TAI));
+    ps.set("a.b.c", 7);
+    dafBase::PropertySet::Ptr x(new dafBase::PropertySet);
+    x->set("e", 1.0);
+    ps.add("sets", x);
+    ps.add("sets", x->deepCopy());
+
+    std::string const encoded = dafBase::MessagePackWriter::encode(ps);
+    auto copy = dafBase::MessagePackReader::decode(encoded);
+
+    BOOST_CHECK(!std::dynamic_pointer_cast<dafBase::PropertyList>(copy));
+    BOOST_CHECK_EQUAL(copy->toString(), ps.toString());
+    for (auto const& name : ps.paramNames(false)) {
+        BOOST_CHECK_MESSAGE(copy->typeOf(name) == ps.typeOf(name), name);
+    }
+    BOOST_CHECK_EQUAL(copy->get<dafBase::DateTime>("dt").nsecs(), 1234567890123456789LL);
+    BOOST_CHECK_EQUAL(copy->getArray<unsigned long long>("ull")[1], 18000000000000000000ULL);
+    BOOST_CHECK_EQUAL(copy->getArray<dafBase::PropertySet::Ptr>("sets").size(), 2U);
+    BOOST_CHECK_EQUAL(copy->get<int>("a.b.c"), 7);
+}
+
+BOOST_AUTO_TEST_CASE(roundTripPropertyList) {
+    dafBase::PropertyList pl;
+    pl.set("ZED", 1.5, "last letter");
+    pl.set("ALPHA", std::string("x"));
+    pl.set<long>("LONG", 5L, "stored as int64");
+    pl.add<short>("BETA", 3);
+    pl.add<short>("BETA", 4, "two values");
+    pl.set("HIER.KEY", true, "dotted");
+
+    std::string const encoded = dafBase::MessagePackWriter::encode(pl);
+    dafBase::MessagePackReader reader(encoded.data(), encoded.size());
+    BOOST_CHECK(reader.isOrdered());
+    auto copy = std::dynamic_pointer_cast<dafBase::PropertyList>(dafBase::MessagePackReader::decode(encoded));
+    BOOST_REQUIRE(copy);
+
+    BOOST_CHECK(copy->getOrderedNames() == pl.getOrderedNames());
+    for (auto const& name : pl.getOrderedNames()) {
+        BOOST_CHECK_EQUAL(copy->getComment(name), pl.getComment(name));
+    }
+    BOOST_CHECK(copy->getArray<short>("BETA") == (std::vector<short>{3, 4}));
+    BOOST_CHECK(copy->typeOf("LONG") == typeid(long long));
+    BOOST_CHECK_EQUAL(copy->get<bool>("HIER.KEY"), true);
+}
+
+BOOST_AUTO_TEST_CASE(encoding) {
+    dafBase::PropertySet ps;
+    ps.set("t", dafBase::DateTime(0x0102030405060708LL, dafBase::DateTime::TAI));
+    BOOST_CHECK_EQUAL(dafBase::MessagePackWriter::encode(ps),
+                      bytes({0x81, 0xa1, 't', 0xd7, 0x01, 1, 2, 3, 4, 5, 6, 7, 8}));
+
+    dafBase::PropertyList pl;
+    pl.set("A", 1, "c");
+    pl.set<short>("B", 2);
+    BOOST_CHECK_EQUAL(dafBase::MessagePackWriter::encode(pl),
+                      bytes({0x92, 0x93, 0xa1, 'A', 0xd2, 0, 0, 0, 1, 0xa1, 'c',
+                             0x93, 0xa1, 'B', 0xd1, 0, 2, 0xa0}));
+}
+
+BOOST_AUTO_TEST_CASE(foreignEncoding) {
+    // {"a": 5, "b": [1, 200, -100], "c": [1.5f, 2.5], "d": bin "xy", "e": timestamp 32, "f": {}}
+    std::string const data = bytes({0x86, 0xa1, 'a', 0x05,
+                                    0xa1, 'b', 0x93, 0x01, 0xcc, 200, 0xd0, 0x9c,
+                                    0xa1, 'c', 0x92, 0xca, 0x3f, 0xc0, 0, 0,
+                                    0xcb, 0x40, 0x04, 0, 0, 0, 0, 0, 0,
+                                    0xa1, 'd', 0xc4, 2, 'x', 'y',
+                                    0xa1, 'e', 0xd6, 0xff, 0x5a, 0x4a, 0xf6, 0xa0,
+                                    0xa1, 'f', 0x80});
+    auto ps = dafBase::MessagePackReader::decode(data);
+    BOOST_CHECK(ps->typeOf("a") == typeid(int));
+    BOOST_CHECK(ps->getArray<long long>("b") == (std::vector<long long>{1, 200, -100}));
+    BOOST_CHECK(ps->getArray<double>("c") == (std::vector<double>{1.5, 2.5}));
+    BOOST_CHECK_EQUAL(ps->get<std::string>("d"), "xy");
+    BOOST_CHECK_EQUAL(ps->get<dafBase::DateTime>("e").toString(dafBase::DateTime::UTC),
+                      "2018-01-02T03:04:00.000000000Z");
+    BOOST_CHECK(ps->isPropertySetPtr("f"));
+
+    // Arrays with negative fixints, as encoded by Python's msgpack.packb({"a": [-1, 5]})
+    ps = dafBase::MessagePackReader::decode(bytes({0x81, 0xa1, 'a', 0x92, 0xff, 0x05}));
+    BOOST_CHECK(ps->getArray<int>("a") == (std::vector<int>{-1, 5}));
+    // [-32, 7, -5 as int8, 1000 as uint16, -1]
+    ps = dafBase::MessagePackReader::decode(
+            bytes({0x81, 0xa1, 'a', 0x95, 0xe0, 0x07, 0xd0, 0xfb, 0xcd, 0x03, 0xe8, 0xff}));
+    BOOST_CHECK(ps->getArray<long long>("a") == (std::vector<long long>{-32, 7, -5, 1000, -1}));
+
+    // Ordered entries may omit the comment or leave it nil
+    auto pl = std::dynamic_pointer_cast<dafBase::PropertyList>(dafBase::MessagePackReader::decode(
+            bytes({0x92, 0x92, 0xa1, 'A', 0x01, 0x93, 0xa1, 'B', 0x02, 0xc0})));
+    BOOST_REQUIRE(pl);
+    BOOST_CHECK_EQUAL(pl->get<int>("B"), 2);
+    BOOST_CHECK_EQUAL(pl->getComment("B"), "");
+}
+
+BOOST_AUTO_TEST_CASE(stream) {
+    dafBase::PropertySet ps;
+    ps.set("n", 1);
+    dafBase::PropertyList pl;
+    pl.set("N", 2, "second");
+    std::string buffer;
+    dafBase::MessagePackWriter::encode(ps, buffer);
+    dafBase::MessagePackWriter::encode(pl, buffer);
+
+    dafBase::MessagePackReader reader(buffer.data(), buffer.size());
+    BOOST_CHECK(!reader.isOrdered());
+    dafBase::PropertySet::Ptr first(new dafBase::PropertySet);
+    dafBase::PropertyBuilder firstBuilder(first);
+    reader.read(firstBuilder);
+    BOOST_CHECK(reader.isOrdered());
+    dafBase::PropertyList::Ptr second(new dafBase::PropertyList);
+    dafBase::PropertyBuilder secondBuilder(second);
+    reader.read(secondBuilder);
+    BOOST_CHECK(reader.atEnd());
+    BOOST_CHECK_EQUAL(first->get<int>("n"), 1);
+    BOOST_CHECK_EQUAL(second->getComment("N"), "second");
+    BOOST_CHECK_THROW(dafBase::MessagePackReader::decode(buffer), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+    dafBase::PropertySet ps;
+    ps.set("ts", std::static_pointer_cast<dafBase::Persistable>(std::make_shared<dafBase::TimeSeries>()));
+    BOOST_CHECK_THROW(dafBase::MessagePackWriter::encode(ps), pexExcept::TypeError);
+
+    std::string const encoded = dafBase::MessagePackWriter::encode(dafBase::PropertyList());
+    BOOST_CHECK_EQUAL(dafBase::MessagePackReader::decode(encoded)->nameCount(), 0U);
+
+    // Truncated data and a bad format byte
+    std::vector<std::string> const invalid = {
+            bytes({}), bytes({0x81, 0xa1, 'a'}), bytes({0x81, 0xa1, 'a', 0xd2, 0}),
+            bytes({0x81, 0xa5, 'a'}), bytes({0xdd, 0xff, 0xff, 0xff, 0xff}), bytes({0x81, 0xa1, 'a', 0xc1}),
+            bytes({0x05}), bytes({0x91, 0x91, 0xa1, 'A'})};
+    for (auto const& data : invalid) {
+        BOOST_CHECK_THROW(dafBase::MessagePackReader::decode(data), pexExcept::InvalidParameterError);
+    }
+    // Values that cannot be stored
+    std::vector<std::string> const unstorable = {
+            bytes({0x81, 0xa1, 'a', 0x91, 0x91, 0x01}), bytes({0x81, 0xa1, 'a', 0x92, 0x01, 0xa1, 'x'}),
+            bytes({0x81, 0xa1, 'a', 0x92, 0xd0, 0xff, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}),
+            bytes({0x81, 0xa1, 'a', 0xd4, 0x05, 0x00})};
+    for (auto const& data : unstorable) {
+        BOOST_CHECK_THROW(dafBase::MessagePackReader::decode(data), pexExcept::TypeError);
+    }
+    std::string deep;
+    for (int i = 0; i < 1000; ++i) deep += bytes({0x81, 0xa1, 'a'});
+    BOOST_CHECK_THROW(dafBase::MessagePackReader::decode(deep), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
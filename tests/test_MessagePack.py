@@ -0,0 +1,120 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Test MessagePack encoding of PropertySet and PropertyList"""
+
+import pickle
+import struct
+import unittest
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+try:
+    import msgpack
+except ImportError:
+    msgpack = None
+
+
+class MessagePackTestCase(unittest.TestCase):
+
+    def makeList(self):
+        header = dafBase.PropertyList()
+        header.set("INSTRUME", "LATISS", "instrument")
+        header.setShort("NAMP", 16, "number of amplifiers")
+        header.setInt("EXPID", 42)
+        header.set("EXPTIME", 30.5, "exposure time")
+        header.set("GAINS", [1.1, 1.2, 1.3])
+        header.set("DATE-AVG", dafBase.DateTime("2023-01-15T03:04:05Z", dafBase.DateTime.UTC))
+        header.set("UNDEF", None, "undefined")
+        return header
+
+    def testPropertyList(self):
+        header = self.makeList()
+        data = dafBase.encodeMessagePack(header)
+        self.assertIsInstance(data, bytes)
+        copy = dafBase.decodeMessagePack(data)
+        self.assertIsInstance(copy, dafBase.PropertyList)
+        self.assertEqual(copy, header)
+        self.assertEqual(copy.getOrderedNames(), header.getOrderedNames())
+        for name in header.getOrderedNames():
+            self.assertEqual(copy.getComment(name), header.getComment(name))
+            self.assertEqual(copy.typeOf(name), header.typeOf(name))
+
+    def testPropertySet(self):
+        ps = dafBase.PropertySet()
+        ps.set("a.b", 1)
+        ps.set("a.c", "x")
+        ps.setLongLong("big", 2**40)
+        ps.set("flags", [True, False])
+        copy = dafBase.decodeMessagePack(bytearray(dafBase.encodeMessagePack(ps)))
+        self.assertNotIsInstance(copy, dafBase.PropertyList)
+        self.assertEqual(copy, ps)
+        self.assertEqual(copy.typeOf("big"), ps.typeOf("big"))
+
+    def testDateTime(self):
+        ps = dafBase.PropertySet()
+        date = dafBase.DateTime("2023-01-15T03:04:05Z", dafBase.DateTime.UTC)
+        ps.set("t", date)
+        data = dafBase.encodeMessagePack(ps)
+        self.assertEqual(data, b"\x81\xa1t\xd7" + struct.pack(">bq", dafBase.DATETIME_EXT_TYPE,
+                                                              date.nsecs(dafBase.DateTime.TAI)))
+
+    def testInvalid(self):
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            dafBase.decodeMessagePack(b"\x81\xa1a")
+        with self.assertRaises(lsst.pex.exceptions.TypeError):
+            dafBase.decodeMessagePack(b"\x81\xa1a\x92\x01\xa1x")
+
+    @unittest.skipIf(msgpack is None, "msgpack is not available")
+    def testInteroperability(self):
+        header = self.makeList()
+        entries = msgpack.unpackb(dafBase.encodeMessagePack(header), raw=False)
+        self.assertEqual([entry[0] for entry in entries], header.getOrderedNames())
+        self.assertEqual(entries[0], ["INSTRUME", "LATISS", "instrument"])
+        self.assertEqual(entries[4][1], [1.1, 1.2, 1.3])
+        date = entries[5][1]
+        self.assertEqual(date.code, dafBase.DATETIME_EXT_TYPE)
+        self.assertEqual(struct.unpack(">q", date.data)[0], header.get("DATE-AVG").nsecs())
+
+        data = msgpack.packb({"a": 1, "b": {"c": [1, 300, -5]}, "d": "x"})
+        ps = dafBase.decodeMessagePack(data)
+        self.assertEqual(ps.get("a"), 1)
+        self.assertEqual(ps.getArray("b.c"), [1, 300, -5])
+        self.assertEqual(ps.get("d"), "x")
+
+    def testSize(self):
+        header = self.makeList()
+        self.assertLess(len(dafBase.encodeMessagePack(header)), len(pickle.dumps(header)))
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -0,0 +1,213 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/MinHash.h"
+#include "lsst/daf/base/MinHashIndex.h"
+#include "lsst/daf/base/PropertyList.h"
+
+#define BOOST_TEST_MODULE MinHash
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// A header of an instrument in a given mode; `variant` changes the last nChanged cards
+std::shared_ptr<dafBase::PropertyList> makeHeader(std::string const& mode, int variant, int nChanged) {
+    auto header = std::make_shared<dafBase::PropertyList>();
+    header->set("INSTRUME", std::string("CAM"), "instrument");
+    header->set("MODE", mode, "readout mode");
+    for (int i = 0; i < 50; ++i) {
+        std::string const name = "KEY" + std::to_string(i);
+        if (i >= 50 - nChanged) {
+            header->set(name, mode + std::to_string(variant * 100 + i));
+        } else {
+            header->set(name, mode + std::to_string(i));
+        }
+    }
+    return header;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(MinHashSuite)
+
+BOOST_AUTO_TEST_CASE(normalization) {
+    dafBase::MinHash const minHash(64);
+    BOOST_CHECK_EQUAL(minHash.getNumHashes(), 64);
+
+    dafBase::PropertyList empty;
+    BOOST_CHECK(minHash(empty) == dafBase::MinHash::Signature(64, std::numeric_limits<std::uint32_t>::max()));
+
+    dafBase::PropertyList a;
+    a.set("EXPTIME", 30, "integer");
+    a.set("FILTER", std::string("r   "));
+    a.set("GAIN", 1.2345678);
+    a.set("sub.x", 1);
+    dafBase::PropertySet b;
+    b.set("EXPTIME", 30.0);
+    b.set("FILTER", std::string(" r"));
+    b.set("GAIN", 1.2345679f);
+    b.set("sub.x", 1LL);
+    BOOST_CHECK(minHash(a) == minHash(b));
+    BOOST_CHECK_EQUAL(dafBase::MinHash::similarity(minHash(a), minHash(b)), 1.0);
+
+    b.set("GAIN", 1.2346);
+    BOOST_CHECK(minHash(a) != minHash(b));
+    dafBase::MinHash const coarse(64, {}, 3);
+    BOOST_CHECK(coarse(a) == coarse(b));
+
+    // Strings are not numbers and names matter
+    b.set("GAIN", 1.2345678);
+    b.set("EXPTIME", std::string("30"));
+    BOOST_CHECK(minHash(a) != minHash(b));
+    b.set("EXPTIME", 30);
+    b.set("sub.y", 1);
+    b.remove("sub.x");
+    BOOST_CHECK(minHash(a) != minHash(b));
+
+    // Ignored names, including whole subproperties
+    dafBase::MinHash const ignoring(64, {"sub", "GAIN"});
+    BOOST_CHECK(ignoring(a) == ignoring(b));
+    std::vector<std::string> const ignored = {"GAIN", "sub"};
+    BOOST_CHECK(ignoring.getIgnored() == ignored);
+
+    // Signatures depend on the seed
+    BOOST_CHECK(dafBase::MinHash(64, {}, 6, 1)(a) != minHash(a));
+    BOOST_CHECK(dafBase::MinHash(64)(a) == minHash(a));
+}
+
+BOOST_AUTO_TEST_CASE(similarity) {
+    // 100 shared pairs and 100 of each own: Jaccard similarity 1/3
+    dafBase::PropertySet a, b;
+    for (int i = 0; i < 200; ++i) {
+        a.set("K" + std::to_string(i), i);
+        b.set("K" + std::to_string(i + 100), i + 100);
+    }
+    dafBase::MinHash const minHash(512);
+    BOOST_CHECK_CLOSE(dafBase::MinHash::similarity(minHash(a), minHash(b)), 1.0 / 3.0, 20.0);
+    BOOST_CHECK_EQUAL(dafBase::MinHash::similarity(minHash(a), minHash(a)), 1.0);
+
+    BOOST_CHECK_THROW(dafBase::MinHash::similarity(minHash(a), dafBase::MinHash(8)(a)),
+                      pexExcept::LengthError);
+    BOOST_CHECK_THROW(dafBase::MinHash(0), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::MinHash(8, {}, 0), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(batch) {
+    dafBase::MinHash const minHash;
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < 300; ++i) {
+        headers.push_back(makeHeader(i % 2 ? "FAST" : "SLOW", i, 5));
+    }
+    std::vector<dafBase::MinHash::Signature> const signatures = minHash(headers, 4);
+    BOOST_REQUIRE_EQUAL(signatures.size(), headers.size());
+    for (std::size_t i = 0; i < headers.size(); ++i) {
+        BOOST_CHECK(signatures[i] == minHash(*headers[i]));
+    }
+
+    headers.push_back(nullptr);
+    BOOST_CHECK_THROW(minHash(headers), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(index) {
+    dafBase::MinHash const minHash;
+    dafBase::MinHashIndex index;
+    BOOST_CHECK_EQUAL(index.getNumBands(), 32);
+    BOOST_CHECK_EQUAL(index.getRowsPerBand(), 4);
+    BOOST_CHECK_CLOSE(index.getThreshold(), 0.42, 1.0);
+    BOOST_CHECK(index.query(minHash(*makeHeader("FAST", 0, 0))).empty());
+
+    std::vector<dafBase::MinHash::Signature> signatures;
+    for (int i = 0; i < 100; ++i) {
+        signatures.push_back(minHash(*makeHeader(i < 50 ? "FAST" : "SLOW", i, 2)));
+    }
+    BOOST_CHECK_EQUAL(index.insert(signatures[0]), 0u);
+    BOOST_CHECK_EQUAL(index.insert(std::vector<dafBase::MinHash::Signature>(signatures.begin() + 1,
+                                                                           signatures.end()), 2),
+                      1u);
+    BOOST_CHECK_EQUAL(index.size(), 100u);
+    BOOST_CHECK(index.getSignature(42) == signatures[42]);
+    BOOST_CHECK_THROW(index.getSignature(100), pexExcept::OutOfRangeError);
+
+    // A near duplicate finds its own mode only, the exact match first
+    std::vector<std::size_t> const found = index.query(signatures[7], 0.5);
+    BOOST_REQUIRE(!found.empty());
+    BOOST_CHECK_EQUAL(found.front(), 7u);
+    BOOST_CHECK_EQUAL(found.size(), 50u);
+    for (std::size_t id : found) {
+        BOOST_CHECK_LT(id, 50u);
+    }
+    BOOST_CHECK_EQUAL(index.query(signatures[7], 1.0).size(), 1u);
+
+    std::vector<std::vector<std::size_t>> const results = index.query(signatures, 0.5, 2);
+    BOOST_REQUIRE_EQUAL(results.size(), signatures.size());
+    BOOST_CHECK(results[7] == found);
+
+    BOOST_CHECK_THROW(index.insert(dafBase::MinHash(64)(*makeHeader("FAST", 0, 0))), pexExcept::LengthError);
+    BOOST_CHECK_THROW(index.insert(dafBase::MinHash(256)(*makeHeader("FAST", 0, 0))), pexExcept::LengthError);
+    BOOST_CHECK_THROW(index.query(dafBase::MinHash(256)(*makeHeader("FAST", 0, 0))), pexExcept::LengthError);
+    BOOST_CHECK_EQUAL(index.size(), 100u);
+
+    index.clear();
+    BOOST_CHECK_EQUAL(index.size(), 0u);
+    BOOST_CHECK_EQUAL(index.insert(dafBase::MinHash(256)(*makeHeader("FAST", 0, 0))), 0u);
+    BOOST_CHECK_THROW(dafBase::MinHashIndex(0, 4), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(cluster) {
+    dafBase::MinHash const minHash;
+    dafBase::MinHashIndex index;
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < 60; ++i) {
+        headers.push_back(makeHeader(i % 3 == 0 ? "FAST" : "SLOW", i, 3));
+    }
+    index.insert(minHash(headers));
+    std::vector<std::size_t> const labels = index.cluster(0.7);
+    BOOST_REQUIRE_EQUAL(labels.size(), headers.size());
+    for (std::size_t i = 0; i < labels.size(); ++i) {
+        BOOST_CHECK_EQUAL(labels[i], i % 3 == 0 ? 0u : 1u);
+    }
+
+    // Nothing is similar enough to join at 1
+    std::vector<std::size_t> const singles = index.cluster(1.0);
+    for (std::size_t i = 0; i < singles.size(); ++i) {
+        BOOST_CHECK_EQUAL(singles[i], i);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,106 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+"""Test MinHash signatures and MinHashIndex"""
+
+import unittest
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+
+def makeHeader(mode, variant):
+    header = dafBase.PropertyList()
+    header.set("INSTRUME", "CAM", "instrument")
+    header.set("MODE", mode, "readout mode")
+    for i in range(30):
+        header.set(f"KEY{i}", f"{mode}{i}")
+    header.set("EXPID", variant)
+    header.set("DATE-OBS", f"2023-01-15T03:04:{variant % 60:02d}")
+    return header
+
+
+class MinHashTestCase(unittest.TestCase):
+
+    def testSignature(self):
+        minHash = dafBase.MinHash(64, ignore=["DATE-OBS"])
+        self.assertEqual(minHash.getNumHashes(), 64)
+        self.assertEqual(minHash.getIgnored(), ["DATE-OBS"])
+        self.assertEqual(minHash.getPrecision(), 6)
+        a = makeHeader("FAST", 1)
+        b = makeHeader("FAST", 2)
+        signature = minHash(a)
+        self.assertEqual(len(signature), 64)
+        self.assertEqual(minHash(a), signature)
+        similarity = dafBase.MinHash.similarity(signature, minHash(b))
+        self.assertGreater(similarity, 0.8)
+
+        b.set("EXPID", 1)
+        self.assertEqual(dafBase.MinHash.similarity(signature, minHash(b)), 1.0)
+
+        headers = [makeHeader("FAST" if i % 2 else "SLOW", i) for i in range(20)]
+        signatures = minHash(headers, nThreads=2)
+        self.assertEqual(signatures, [minHash(h) for h in headers])
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            dafBase.MinHash.similarity(signature, dafBase.MinHash(8)(a))
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            dafBase.MinHash(0)
+
+    def testIndex(self):
+        minHash = dafBase.MinHash(ignore=["DATE-OBS"])
+        index = dafBase.MinHashIndex()
+        self.assertEqual(index.getNumBands(), 32)
+        self.assertEqual(index.getRowsPerBand(), 4)
+        self.assertAlmostEqual(index.getThreshold(), 32**-0.25)
+
+        headers = [makeHeader("FAST" if i % 2 else "SLOW", i) for i in range(40)]
+        self.assertEqual(index.insert(minHash(headers[0])), 0)
+        self.assertEqual(index.insert(minHash(headers[1:])), 1)
+        self.assertEqual(len(index), 40)
+        self.assertEqual(index.getSignature(3), minHash(headers[3]))
+
+        found = index.query(minHash(headers[3]), threshold=0.5)
+        self.assertEqual(sorted(found), list(range(1, 40, 2)))
+        self.assertEqual(index.query([minHash(headers[3])], threshold=0.5), [found])
+
+        labels = index.cluster(0.7)
+        self.assertEqual(labels, [i % 2 for i in range(40)])
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            index.insert(dafBase.MinHash(64)(headers[0]))
+        index.clear()
+        self.assertEqual(len(index), 0)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
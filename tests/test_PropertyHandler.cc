@@ -0,0 +1,209 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/daf/base/PropertyBuilder.h"
+#include "lsst/daf/base/PropertyHandler.h"
+#include "lsst/daf/base/PropertyList.h"
+
+#define BOOST_TEST_MODULE PropertyHandler
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Record events as a compact string
+class Recorder : public dafBase::PropertyHandler {
+public:
+    void beginSet(std::size_t size) override { s << "{" << size << " "; }
+    void endSet() override { s << "} "; }
+    void key(std::string const& name) override { s << name << "="; }
+    void comment(std::string const& comment) override { s << "#" << comment << " "; }
+    void beginArray(std::size_t size) override { s << "[" << size << " "; }
+    void endArray() override { s << "] "; }
+
+    void value(bool v) override { s << "b:" << v << " "; }
+    void value(char v) override { s << "c:" << v << " "; }
+    void value(signed char v) override { s << "sc:" << int(v) << " "; }
+    void value(unsigned char v) override { s << "uc:" << int(v) << " "; }
+    void value(short v) override { s << "h:" << v << " "; }
+    void value(unsigned short v) override { s << "uh:" << v << " "; }
+    void value(int v) override { s << "i:" << v << " "; }
+    void value(unsigned int v) override { s << "ui:" << v << " "; }
+    void value(long v) override { s << "l:" << v << " "; }
+    void value(unsigned long v) override { s << "ul:" << v << " "; }
+    void value(long long v) override { s << "ll:" << v << " "; }
+    void value(unsigned long long v) override { s << "ull:" << v << " "; }
+    void value(float v) override { s << "f:" << v << " "; }
+    void value(double v) override { s << "d:" << v << " "; }
+    void value(std::nullptr_t) override { s << "undef "; }
+    void value(std::string const& v) override { s << "s:" << v << " "; }
+    void value(dafBase::DateTime const& v) override { s << "t:" << v.nsecs() << " "; }
+    void value(dafBase::Persistable::Ptr const&) override { s << "p "; }
+
+    std::ostringstream s;
+};
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PropertyHandlerSuite)
+
+BOOST_AUTO_TEST_CASE(walkPropertySet) {
+    dafBase::PropertySet ps;
+    ps.set("a.b", std::vector<int>{1, 2});
+    Recorder r;
+    ps.walk(r);
+    BOOST_CHECK_EQUAL(r.s.str(), "{1 a={1 b=[2 i:1 i:2 ] } } ");
+
+    Recorder single;
+    ps.walk("a.b", single);
+    BOOST_CHECK_EQUAL(single.s.str(), "[2 i:1 i:2 ] ");
+    BOOST_CHECK_THROW(ps.walk("a.c", single), pexExcept::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(walkPropertyList) {
+    dafBase::PropertyList pl;
+    pl.set("ZED", 1.5, "last letter");
+    pl.set("ALPHA", std::string("x"));
+    pl.add<short>("BETA", 3);
+    pl.add<short>("BETA", 4, "two values");
+    pl.set("UNDEF", nullptr);
+    Recorder r;
+    pl.walk(r);
+    BOOST_CHECK_EQUAL(r.s.str(),
+                      "{4 ZED=d:1.5 #last letter ALPHA=s:x # BETA=[2 h:3 h:4 ] #two values UNDEF=undef # } ");
+}
+
+BOOST_AUTO_TEST_CASE(buildPropertySet) {
+    dafBase::PropertySet::Ptr ps(new dafBase::PropertySet);
+    ps->set("int", 42);
+    ps->set("ull", std::vector<unsigned long long>{1ULL, 2ULL, 3ULL});
+    ps->set("str", std::string("foo"));
+    ps->set("dt", dafBase::DateTime(1234567890LL));
+    ps->set("a.b.c", 2.5f);
+    ps->set("a.d", true);
+    dafBase::PropertySet::Ptr x(new dafBase::PropertySet);
+    x->set("e", 'e');
+    ps->add("sets", x);
+    ps->add("sets", x->deepCopy());
+
+    dafBase::PropertySet::Ptr copy(new dafBase::PropertySet);
+    dafBase::PropertyBuilder builder(copy);
+    ps->walk(builder);
+
+    BOOST_CHECK_EQUAL(copy->toString(), ps->toString());
+    BOOST_CHECK(copy->typeOf("ull") == typeid(unsigned long long));
+    BOOST_CHECK(copy->typeOf("a.b.c") == typeid(float));
+    BOOST_CHECK_EQUAL(copy->get<dafBase::DateTime>("dt").nsecs(), 1234567890LL);
+    BOOST_CHECK_EQUAL(copy->valueCount("sets"), 2U);
+    BOOST_CHECK_EQUAL(copy->getArray<dafBase::PropertySet::Ptr>("sets")[1]->get<char>("e"), 'e');
+    BOOST_CHECK(copy->getAsPropertySetPtr("a") != ps->getAsPropertySetPtr("a"));
+}
+
+BOOST_AUTO_TEST_CASE(buildConcurrent) {
+    dafBase::PropertySet::Ptr ps(new dafBase::PropertySet);
+    for (int i = 0; i < 200; ++i) {
+        dafBase::PropertySet::Ptr x(new dafBase::PropertySet);
+        x->set("i", i);
+        x->set("b.c", std::vector<int>{i, i + 1});
+        ps->add("sets", x);
+        ps->set("s" + std::to_string(i) + ".v", i);
+    }
+
+    // Readers see the target while it is being filled
+    dafBase::PropertySet::Ptr copy(new dafBase::PropertySet);
+    copy->makeConcurrent();
+    std::atomic<bool> done(false);
+    std::thread reader([&copy, &done]() {
+        while (!done) {
+            copy->deepCopy();
+            copy->toString();
+        }
+    });
+    dafBase::PropertyBuilder builder(copy);
+    ps->walk(builder);
+    done = true;
+    reader.join();
+
+    BOOST_CHECK_EQUAL(copy->toString(), ps->toString());
+    for (auto const& x : copy->getArray<dafBase::PropertySet::Ptr>("sets")) {
+        BOOST_CHECK(x->isConcurrent());
+        BOOST_CHECK(x->getAsPropertySetPtr("b")->isConcurrent());
+    }
+    BOOST_CHECK(copy->getAsPropertySetPtr("s7")->isConcurrent());
+}
+
+BOOST_AUTO_TEST_CASE(buildPropertyList) {
+    dafBase::PropertyList::Ptr pl(new dafBase::PropertyList);
+    pl->set("ZED", 1.5, "last letter");
+    pl->set("ALPHA", std::string("x"));
+    pl->add("BETA", 3L);
+    pl->add("BETA", 4L, "two values");
+
+    dafBase::PropertyList::Ptr copy(new dafBase::PropertyList);
+    dafBase::PropertyBuilder builder(copy);
+    pl->walk(builder);
+
+    BOOST_CHECK_EQUAL(copy->toString(), pl->toString());
+    BOOST_CHECK(copy->getOrderedNames() == pl->getOrderedNames());
+    BOOST_CHECK_EQUAL(copy->getComment("BETA"), "two values");
+    BOOST_CHECK(copy->getArray<long>("BETA") == (std::vector<long>{3L, 4L}));
+}
+
+BOOST_AUTO_TEST_CASE(buildFlattened) {
+    dafBase::PropertySet ps;
+    ps.set("a.b", 1);
+    ps.set("a.c.d", std::string("deep"));
+
+    dafBase::PropertyList::Ptr pl(new dafBase::PropertyList);
+    dafBase::PropertyBuilder builder(pl);
+    ps.walk(builder);
+
+    BOOST_CHECK_EQUAL(pl->nameCount(), 2U);
+    BOOST_CHECK_EQUAL(pl->get<int>("a.b"), 1);
+    BOOST_CHECK_EQUAL(pl->get<std::string>("a.c.d"), "deep");
+    BOOST_CHECK(!pl->exists("a"));
+}
+
+BOOST_AUTO_TEST_CASE(builderThrow) {
+    BOOST_CHECK_THROW(dafBase::PropertyBuilder(dafBase::PropertySet::Ptr()),
+                      pexExcept::InvalidParameterError);
+    dafBase::PropertyBuilder builder(std::make_shared<dafBase::PropertySet>());
+    BOOST_CHECK_THROW(builder.key("a"), pexExcept::LogicError);
+    BOOST_CHECK_THROW(builder.endSet(), pexExcept::LogicError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
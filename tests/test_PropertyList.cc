@@ -30,6 +30,10 @@
 #pragma clang diagnostic pop
 
 #include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "lsst/pex/exceptions/Runtime.h"
 
@@ -454,4 +458,122 @@ BOOST_AUTO_TEST_CASE(combineAsPS) { /* parasoft-suppress LsstDm-3-1 LsstDm-3-4a
     BOOST_CHECK_EQUAL(newPlp->getComment("float"), "stuff");
 }
 
+BOOST_AUTO_TEST_CASE(removeBulk) {
+    dafBase::PropertyList pl;
+    for (int i = 0; i < 10; ++i) {
+        pl.set("KEY" + std::to_string(i), i, "comment " + std::to_string(i));
+    }
+    std::vector<std::string> names = {"KEY1", "KEY3", "MISSING", "KEY8", "KEY3"};
+    BOOST_CHECK_EQUAL(pl.remove(names), 3u);
+
+    std::vector<std::string> expected = {"KEY0", "KEY2", "KEY4", "KEY5", "KEY6", "KEY7", "KEY9"};
+    std::vector<std::string> ordered = pl.getOrderedNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(pl.getComment("KEY2"), "comment 2");
+
+    // A re-added name goes to the end without its old comment
+    pl.set("KEY1", 1);
+    BOOST_CHECK_EQUAL(pl.getComment("KEY1"), "");
+    BOOST_CHECK_EQUAL(pl.getOrderedNames().back(), "KEY1");
+
+    // Removing through a PropertySet that holds the list keeps the order and comments in step
+    auto child = std::make_shared<dafBase::PropertyList>();
+    child->set("A", 1, "first");
+    child->set("B", 2, "second");
+    dafBase::PropertySet ps;
+    ps.set("list", std::static_pointer_cast<dafBase::PropertySet>(child));
+    ps.remove("list.A");
+    BOOST_CHECK_EQUAL(ps.remove(std::vector<std::string>{"list.B", "list.missing"}), 1u);
+    BOOST_CHECK(child->getOrderedNames().empty());
+    child->set("A", 3);
+    BOOST_CHECK_EQUAL(child->getComment("A"), "");
+}
+
+BOOST_AUTO_TEST_CASE(removeIf) {
+    dafBase::PropertyList pl;
+    pl.set("SIMPLE", true, "conforms");
+    pl.set("NAXIS", 2, "axes");
+    pl.set("HIERARCH.INST.A", 1.5, "inst a");
+    pl.set("HIERARCH.INST.B", std::string("x"), "inst b");
+    pl.set("EXPTIME", 30.0, "seconds");
+
+    std::size_t removed = pl.removeIf([](std::string const& name, std::type_info const&, boost::any const&) {
+        return name.compare(0, 14, "HIERARCH.INST.") == 0;
+    });
+    BOOST_CHECK_EQUAL(removed, 2u);
+    std::vector<std::string> expected = {"SIMPLE", "NAXIS", "EXPTIME"};
+    std::vector<std::string> ordered = pl.getOrderedNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(pl.getComment("EXPTIME"), "seconds");
+
+    // Order and comments stay consistent if the predicate throws part way
+    auto stop = [](std::string const&, std::type_info const&, boost::any const&) -> bool {
+        throw std::runtime_error("stop");
+    };
+    BOOST_CHECK_THROW(pl.removeIf(stop), std::runtime_error);
+    BOOST_CHECK_EQUAL(pl.getOrderedNames().size(), pl.nameCount());
+
+    std::size_t calls = 0;
+    removed = pl.removeIf([&calls](std::string const&, std::type_info const& type, boost::any const&) {
+        ++calls;
+        return type == typeid(double);
+    });
+    BOOST_CHECK_EQUAL(calls, 3u);
+    BOOST_CHECK_EQUAL(removed, 1u);
+    BOOST_CHECK_EQUAL(pl.nameCount(), 2u);
+    BOOST_CHECK_EQUAL(pl.getOrderedNames().size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(savepoint) {
+    dafBase::PropertyList pl;
+    pl.set("SIMPLE", true, "conforms");
+    pl.set("NAXIS", 2, "axes");
+    pl.set("EXPTIME", 30.0, "seconds");
+    pl.set("OBJECT", std::string("M31"), "target");
+    std::string const before = pl.toString();
+    std::vector<std::string> const order = pl.getOrderedNames();
+
+    dafBase::PropertyList::Ptr other(new dafBase::PropertyList);
+    other->set("FILTER", std::string("r"), "band");
+    other->set("EXPTIME", 15.0, "half");
+    other->set("AIRMASS", 1.2, "at start");
+
+    pl.savepoint();
+    pl.set("NAXIS", 3, "three axes");
+    pl.remove("SIMPLE");
+    pl.set("DATE", std::string("2023-01-15"), "date");
+    pl.combine(other);
+    pl.remove(std::vector<std::string>{"OBJECT", "DATE"});
+    pl.set("SIMPLE", false);
+    pl.add("NAXIS", 4, "four axes");
+    pl.removeIf([](std::string const& name, std::type_info const&, boost::any const&) {
+        return name == "FILTER";
+    });
+    BOOST_CHECK_EQUAL(pl.getOrderedNames().back(), "SIMPLE");
+    pl.rollback();
+
+    BOOST_CHECK_EQUAL(pl.toString(), before);
+    std::vector<std::string> ordered = pl.getOrderedNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), order.begin(), order.end());
+    BOOST_CHECK_EQUAL(pl.getComment("EXPTIME"), "seconds");
+    BOOST_CHECK_EQUAL(pl.getComment("SIMPLE"), "conforms");
+
+    // Nested savepoints; combine orders the names it adds like the source
+    pl.savepoint();
+    pl.combine(other);
+    std::vector<std::string> combined = pl.getOrderedNames();
+    std::vector<std::string> expected = {"SIMPLE", "NAXIS", "EXPTIME", "OBJECT", "FILTER", "AIRMASS"};
+    BOOST_CHECK_EQUAL_COLLECTIONS(combined.begin(), combined.end(), expected.begin(), expected.end());
+    pl.savepoint();
+    pl.remove("NAXIS");
+    pl.set("NAXIS", 5, "moved");
+    pl.rollback();
+    ordered = pl.getOrderedNames();
+    BOOST_CHECK_EQUAL_COLLECTIONS(ordered.begin(), ordered.end(), combined.begin(), combined.end());
+    BOOST_CHECK_EQUAL(pl.getComment("EXPTIME"), "half");
+    pl.release();
+    BOOST_CHECK(!pl.hasSavepoint());
+    BOOST_CHECK_EQUAL(pl.getComment("AIRMASS"), "at start");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -740,6 +740,44 @@ class PropertyListTestCase(unittest.TestCase):
         apl.remove("apl1.minus")
         self.assertEqual(apl.nameCount(False), 0)
 
+    def testRemoveBulk(self):
+        apl = dafBase.PropertyList()
+        for i in range(6):
+            apl.set(f"KEY{i}", i, f"comment {i}")
+        apl.set("INST.A", 1.5, "inst a")
+        apl.set("INST.B", "x", "inst b")
+
+        self.assertEqual(apl.remove(["KEY1", "KEY4", "MISSING"]), 2)
+        self.assertEqual(apl.getOrderedNames(), ["KEY0", "KEY2", "KEY3", "KEY5", "INST.A", "INST.B"])
+
+        self.assertEqual(apl.removeIf(lambda name, value: name.startswith("INST.")), 2)
+        self.assertEqual(apl.getOrderedNames(), ["KEY0", "KEY2", "KEY3", "KEY5"])
+        self.assertEqual(apl.removeIf(lambda name, value: value % 2 == 1), 2)
+        self.assertEqual(apl.getOrderedNames(), ["KEY0", "KEY2"])
+        self.assertEqual(apl.getComment("KEY2"), "comment 2")
+        self.assertEqual(apl.removeIf(lambda name, value: False), 0)
+
+    def testSavepoint(self):
+        apl = dafBase.PropertyList()
+        apl.set("SIMPLE", True, "conforms")
+        apl.set("NAXIS", 2, "axes")
+        apl.set("EXPTIME", 30.0, "seconds")
+        other = dafBase.PropertyList()
+        other.set("FILTER", "r", "band")
+        other.set("EXPTIME", 15.0, "half")
+
+        apl.savepoint()
+        apl.remove("SIMPLE")
+        apl.set("NAXIS", 3, "three axes")
+        apl.combine(other)
+        apl.set("SIMPLE", False)
+        self.assertEqual(apl.getOrderedNames(), ["NAXIS", "EXPTIME", "FILTER", "SIMPLE"])
+        apl.rollback()
+        self.assertEqual(apl.getOrderedNames(), ["SIMPLE", "NAXIS", "EXPTIME"])
+        self.assertEqual(apl.getComment("NAXIS"), "axes")
+        self.assertEqual(apl.getComment("EXPTIME"), "seconds")
+        self.assertEqual(apl.getScalar("SIMPLE"), True)
+
     def testdeepCopy(self):
         apl = dafBase.PropertyList()
         apl.set("int", 42)
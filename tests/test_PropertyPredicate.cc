@@ -0,0 +1,214 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/PropertyPredicate.h"
+
+#define BOOST_TEST_MODULE PropertyPredicate
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+std::shared_ptr<dafBase::PropertyList> makeHeader() {
+    auto header = std::make_shared<dafBase::PropertyList>();
+    header->set("INSTRUME", std::string("LATISS"));
+    header->set("FILTER", std::string("r"));
+    header->set("DATE-OBS", std::string("2023-01-15T03:04:05.123"));
+    header->set("EXPID", 42);
+    header->set("EXPTIME", 30.5);
+    header->set("AIRMASS", 1.1f);
+    header->set("VISIT", 2023011500042LL);
+    header->set("FLAG", true);
+    header->set("ZERO", 0);
+    header->set("MJD-OBS", dafBase::DateTime("2023-01-15T03:04:05Z", dafBase::DateTime::UTC));
+    header->set("GAINS", std::vector<double>{1.0, 2.0, 3.0});
+    return header;
+}
+
+bool evaluate(std::string const& expression) { return dafBase::PropertyPredicate(expression)(*makeHeader()); }
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PropertyPredicateSuite)
+
+BOOST_AUTO_TEST_CASE(numbers) {
+    BOOST_CHECK(evaluate("EXPTIME > 30"));
+    BOOST_CHECK(evaluate("EXPTIME >= 30.5"));
+    BOOST_CHECK(!evaluate("EXPTIME < 30.5"));
+    BOOST_CHECK(evaluate("EXPID == 42"));
+    BOOST_CHECK(evaluate("EXPID = 42.0"));
+    BOOST_CHECK(!evaluate("EXPID == 42.5"));
+    BOOST_CHECK(evaluate("EXPID != 41"));
+    BOOST_CHECK(evaluate("EXPID <= 42 and EXPID > -1e3"));
+    BOOST_CHECK(evaluate("VISIT > 2023011500041"));
+    BOOST_CHECK(evaluate("AIRMASS < 1.2"));
+    BOOST_CHECK(evaluate("GAINS == 3"));  // last value of an array
+    BOOST_CHECK(evaluate("30 < EXPTIME"));
+}
+
+BOOST_AUTO_TEST_CASE(strings) {
+    BOOST_CHECK(evaluate("INSTRUME == 'LATISS'"));
+    BOOST_CHECK(evaluate("FILTER != \"g\""));
+    BOOST_CHECK(evaluate("FILTER > 'g'"));
+    BOOST_CHECK(evaluate("`DATE-OBS` >= '2023-01-15'"));
+    BOOST_CHECK(!evaluate("DATE-OBS < '2023-01-15'"));
+    BOOST_CHECK(evaluate("INSTRUME == 'it\\'s' or true"));
+}
+
+BOOST_AUTO_TEST_CASE(dates) {
+    BOOST_CHECK(evaluate("MJD-OBS > '2023-01-15'"));
+    BOOST_CHECK(evaluate("MJD-OBS < '2023-01-16T00:00:00Z'"));
+    BOOST_CHECK(evaluate("MJD-OBS == '2023-01-15T03:04:05Z'"));
+    // The same instant in TAI is 37 seconds later
+    BOOST_CHECK(evaluate("MJD-OBS == '2023-01-15T03:04:42'"));
+    BOOST_CHECK(!evaluate("MJD-OBS == 'LATISS'"));
+    BOOST_CHECK(!evaluate("MJD-OBS > 0"));
+}
+
+BOOST_AUTO_TEST_CASE(membership) {
+    BOOST_CHECK(evaluate("FILTER in ('g', 'r', 'i')"));
+    BOOST_CHECK(!evaluate("FILTER not in ('g', 'r', 'i')"));
+    BOOST_CHECK(evaluate("EXPID in (1, 42)"));
+    BOOST_CHECK(evaluate("EXPTIME IN (15, 30.5)"));
+    BOOST_CHECK(!evaluate("EXPID in ('42')"));
+    BOOST_CHECK(evaluate("MJD-OBS in ('2023-01-15T03:04:05Z')"));
+    BOOST_CHECK(!evaluate("MISSING in (1, 2)"));
+}
+
+BOOST_AUTO_TEST_CASE(existence) {
+    BOOST_CHECK(evaluate("exists(EXPID)"));
+    BOOST_CHECK(!evaluate("EXISTS(MISSING)"));
+    BOOST_CHECK(evaluate("FLAG"));
+    BOOST_CHECK(!evaluate("ZERO"));
+    BOOST_CHECK(!evaluate("MISSING"));
+    BOOST_CHECK(!evaluate("INSTRUME"));
+    // Comparisons with a missing property are false, whatever the operator
+    BOOST_CHECK(!evaluate("MISSING == 1"));
+    BOOST_CHECK(!evaluate("MISSING != 1"));
+    BOOST_CHECK(evaluate("not MISSING == 1"));
+    BOOST_CHECK(!evaluate("EXPTIME == 'LATISS'"));
+    BOOST_CHECK(!evaluate("EXPTIME != 'LATISS'"));
+}
+
+BOOST_AUTO_TEST_CASE(logic) {
+    BOOST_CHECK(evaluate("true or false and false"));
+    BOOST_CHECK(!evaluate("(true or false) and false"));
+    BOOST_CHECK(evaluate("not false and true"));
+    BOOST_CHECK(!evaluate("not (EXPID == 42 or MISSING)"));
+    BOOST_CHECK(evaluate("FLAG == true and ZERO == false"));
+    BOOST_CHECK(evaluate("EXPID == EXPID and EXPTIME < EXPID and not EXPTIME > EXPID"));
+    BOOST_CHECK(evaluate("1 < 2"));
+    BOOST_CHECK(!evaluate("'a' == 'b'"));
+    BOOST_CHECK(evaluate("INSTRUME == 'LATISS' AND (FILTER == 'g' OR FILTER == 'r') AND EXPTIME > 10"));
+}
+
+BOOST_AUTO_TEST_CASE(compiled) {
+    dafBase::PropertyPredicate predicate(
+            "EXPID > 1 and (EXPTIME > 1 or `DATE-OBS` == '2023') and EXPID < 100");
+    BOOST_CHECK_EQUAL(predicate.getExpression(),
+                      "EXPID > 1 and (EXPTIME > 1 or `DATE-OBS` == '2023') and EXPID < 100");
+    BOOST_CHECK((predicate.getNames() == std::vector<std::string>{"EXPID", "EXPTIME", "DATE-OBS"}));
+
+    // Deep nesting exceeds the fixed evaluation buffers
+    std::string deep = "EXPID == 42";
+    for (int i = 0; i < 40; ++i) {
+        deep = "(K" + std::to_string(i) + " or " + deep + ")";
+    }
+    BOOST_CHECK(evaluate(deep));
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+    for (std::string const expression :
+         {"", "EXPID >", "EXPID == 1 and", "(EXPID", "EXPID == 'a", "EXPID ! 1", "'a'", "1 in (1)",
+          "EXPID in 1", "EXPID in ()", "exists(1)", "EXPID == 1 EXPTIME", "EXPID # 1", "`EXPID"}) {
+        BOOST_CHECK_THROW(dafBase::PropertyPredicate{expression}, pexExcept::InvalidParameterError);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(batch) {
+    dafBase::PropertyPredicate const predicate("exists(EXPTIME) or EXPID > 900");
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < 1000; ++i) {
+        auto header = std::make_shared<dafBase::PropertyList>();
+        header->set("EXPID", i);
+        if (i % 3 == 0) {
+            header->set("EXPTIME", 30.0);
+        }
+        headers.push_back(header);
+    }
+    std::vector<bool> const serial = predicate(headers, 1);
+    BOOST_REQUIRE_EQUAL(serial.size(), headers.size());
+    for (int i = 0; i < 1000; ++i) {
+        BOOST_CHECK_EQUAL(serial[i], i % 3 == 0 || i > 900);
+    }
+    BOOST_CHECK(predicate(headers, 4) == serial);
+    BOOST_CHECK(predicate(headers) == serial);
+    BOOST_CHECK(predicate(std::vector<dafBase::PropertySet::ConstPtr>()).empty());
+
+    headers[500].reset();
+    BOOST_CHECK_THROW(predicate(headers, 4), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent) {
+    // Strings too long for the small string optimization, so that replacing one frees it
+    std::string const first(40, 'a');
+    std::string const second(50, 'b');
+    auto ps = std::make_shared<dafBase::PropertySet>();
+    ps->set("obs.object", first);
+    ps->makeConcurrent();
+    dafBase::PropertyPredicate const predicate("obs.object == \"" + first + "\"");
+
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        for (int i = 0; !done; ++i) {
+            ps->set("obs.object", i % 2 == 0 ? second : first);
+        }
+    });
+    int matches = 0;
+    for (int i = 0; i < 20000; ++i) {
+        matches += predicate(*ps);
+    }
+    done = true;
+    writer.join();
+    BOOST_CHECK(matches <= 20000);
+    BOOST_CHECK_EQUAL(predicate(*ps), ps->get<std::string>("obs.object") == first);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
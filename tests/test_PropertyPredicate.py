@@ -0,0 +1,75 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Test evaluation of PropertyPredicate"""
+
+import unittest
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+
+class PropertyPredicateTestCase(unittest.TestCase):
+
+    def makeHeader(self, expId):
+        header = dafBase.PropertyList()
+        header.set("INSTRUME", "LATISS")
+        header.set("FILTER", "r")
+        header.set("EXPID", expId)
+        header.set("EXPTIME", 30.5)
+        header.set("DATE-AVG", dafBase.DateTime("2023-01-15T03:04:05Z", dafBase.DateTime.UTC))
+        return header
+
+    def testEvaluate(self):
+        header = self.makeHeader(42)
+        predicate = dafBase.PropertyPredicate("EXPTIME > 30 and FILTER in ('g', 'r')")
+        self.assertEqual(predicate.getExpression(), "EXPTIME > 30 and FILTER in ('g', 'r')")
+        self.assertEqual(predicate.getNames(), ["EXPTIME", "FILTER"])
+        self.assertTrue(predicate(header))
+        self.assertFalse(dafBase.PropertyPredicate("EXPID < 10 or INSTRUME != 'LATISS'")(header))
+        self.assertTrue(dafBase.PropertyPredicate("`DATE-AVG` >= '2023-01-15'")(header))
+        self.assertFalse(dafBase.PropertyPredicate("MISSING == 1")(header))
+        self.assertTrue(dafBase.PropertyPredicate("not exists(MISSING)")(header))
+
+    def testBatch(self):
+        predicate = dafBase.PropertyPredicate("EXPID > 1")
+        headers = [self.makeHeader(i) for i in range(4)]
+        self.assertEqual(predicate(headers), [False, False, True, True])
+        self.assertEqual(predicate(headers, nThreads=2), [False, False, True, True])
+
+    def testErrors(self):
+        for expression in ("EXPID >", "(EXPID == 1", "EXPID == 'a", "'a'"):
+            with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+                dafBase.PropertyPredicate(expression)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
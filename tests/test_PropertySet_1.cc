@@ -20,6 +20,7 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include "lsst/daf/base/DateTime.h"
 #include "lsst/daf/base/PropertySet.h"
 
 #define BOOST_TEST_MODULE PropertySet_1
@@ -30,8 +31,13 @@
 #pragma clang diagnostic pop
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
 
 #include "lsst/pex/exceptions/Runtime.h"
+#include "lsst/daf/base/TimeSeries.h"
 
 #define INT64CONST(x) static_cast<int64_t>(x##LL)
 #define UINT64CONST(x) static_cast<uint64_t>(x##ULL)
@@ -785,4 +791,319 @@ BOOST_AUTO_TEST_CASE(cycle) { /* parasoft-suppress LsstDm-3-1 LsstDm-3-4a LsstDm
     BOOST_CHECK_THROW(a->set("t", psp), pexExcept::InvalidParameterError);
 }
 
+BOOST_AUTO_TEST_CASE(getAsDateTime) {
+    dafBase::PropertySet ps;
+    dafBase::DateTime const date("2023-01-15T03:04:05.5Z", dafBase::DateTime::UTC);
+    ps.set("dt", date);
+    ps.set("iso", std::string("2023-01-15T03:04:05.5Z"));
+    ps.set("fits", std::string("2023-01-15T03:04:05.5"));
+    ps.set("day", std::string("2023-01-15"));
+    ps.set("a.mjd", date.get(dafBase::DateTime::MJD, dafBase::DateTime::UTC));
+    ps.set("intMjd", 59959);
+    ps.set("bool", true);
+    ps.set("text", std::string("yesterday"));
+
+    dafBase::DateTime::Timescale const utc = dafBase::DateTime::UTC;
+    BOOST_CHECK(ps.getAsDateTime("dt", dafBase::DateTime::TAI) == date);
+    BOOST_CHECK(ps.getAsDateTime("iso", utc) == date);
+    BOOST_CHECK(ps.getAsDateTime("fits", utc) == date);
+    BOOST_CHECK_EQUAL(ps.getAsDateTime("fits", dafBase::DateTime::TAI).nsecs(), date.nsecs(utc));
+    BOOST_CHECK(ps.getAsDateTime("day", utc) == dafBase::DateTime("2023-01-15T00:00:00Z", utc));
+    BOOST_CHECK(std::abs(ps.getAsDateTime("a.mjd", utc).nsecs() - date.nsecs()) < 1000);
+    BOOST_CHECK(ps.getAsDateTime("intMjd", utc) == dafBase::DateTime("2023-01-15T00:00:00Z", utc));
+    BOOST_CHECK_THROW(ps.getAsDateTime("missing", utc), pexExcept::NotFoundError);
+    BOOST_CHECK_THROW(ps.getAsDateTime("bool", utc), pexExcept::TypeError);
+    BOOST_CHECK_THROW(ps.getAsDateTime("text", utc), pexExcept::TypeError);
+    BOOST_CHECK_THROW(ps.getAsDateTime("a", utc), pexExcept::TypeError);
+    BOOST_CHECK_THROW(ps.getAsDateTime("iso", dafBase::DateTime::TAI), pexExcept::TypeError);
+}
+
+BOOST_AUTO_TEST_CASE(getAsDateTimeCache) {
+    dafBase::PropertySet ps;
+    dafBase::DateTime::Timescale const utc = dafBase::DateTime::UTC;
+    ps.set("DATE-OBS", std::string("2023-01-15T03:04:05"));
+    dafBase::DateTime const first = ps.getAsDateTime("DATE-OBS", utc);
+    BOOST_CHECK(ps.getAsDateTime("DATE-OBS", utc) == first);
+    // The cached value depends on the time scale
+    BOOST_CHECK_EQUAL(ps.getAsDateTime("DATE-OBS", dafBase::DateTime::TAI).nsecs(), first.nsecs(utc));
+    BOOST_CHECK(ps.getAsDateTime("DATE-OBS", utc) == first);
+
+    // Every kind of mutation invalidates the cached value
+    ps.set("DATE-OBS", std::string("2024-02-29T12:00:00"));
+    dafBase::DateTime const second("2024-02-29T12:00:00Z", utc);
+    BOOST_CHECK(ps.getAsDateTime("DATE-OBS", utc) == second);
+    ps.add("DATE-OBS", std::string("2025-03-01T00:00:00"));
+    BOOST_CHECK(ps.getAsDateTime("DATE-OBS", utc) == dafBase::DateTime("2025-03-01T00:00:00Z", utc));
+    ps.remove("DATE-OBS");
+    BOOST_CHECK_THROW(ps.getAsDateTime("DATE-OBS", utc), pexExcept::NotFoundError);
+    ps.set("DATE-OBS", 60000.0);
+    BOOST_CHECK(ps.getAsDateTime("DATE-OBS", utc) == dafBase::DateTime(60000.0, dafBase::DateTime::MJD, utc));
+
+    // Subproperties changed through another handle
+    ps.set("sub.DATE", std::string("2023-01-15"));
+    BOOST_CHECK(ps.getAsDateTime("sub.DATE", utc) == dafBase::DateTime("2023-01-15T00:00:00Z", utc));
+    ps.getAsPropertySetPtr("sub")->set("DATE", std::string("2023-01-16"));
+    BOOST_CHECK(ps.getAsDateTime("sub.DATE", utc) == dafBase::DateTime("2023-01-16T00:00:00Z", utc));
+
+    // Concurrent readers of a shared header
+    ps.set("DATE-OBS", std::string("2023-01-15T03:04:05"));
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches(0);
+    for (int i = 0; i < 4; ++i) {
+        threads.emplace_back([&]() {
+            for (int j = 0; j < 1000; ++j) {
+                if (!(ps.getAsDateTime("DATE-OBS", utc) == first)) ++mismatches;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(mismatches, 0);
+}
+
+BOOST_AUTO_TEST_CASE(removeBulk) {
+    dafBase::PropertySet ps;
+    ps.set("int", 42);
+    ps.set("double", 3.14);
+    ps.set("string", std::string("foo"));
+    ps.set("ps1.a", 1);
+    ps.set("ps1.b", 2);
+
+    std::vector<std::string> names = {"int", "ps1.a", "missing", "ps1.missing", "int.sub", "int"};
+    BOOST_CHECK_EQUAL(ps.remove(names), 2u);
+    BOOST_CHECK(!ps.exists("int"));
+    BOOST_CHECK(!ps.exists("ps1.a"));
+    BOOST_CHECK(ps.exists("ps1.b"));
+    BOOST_CHECK(ps.exists("double"));
+    BOOST_CHECK_EQUAL(ps.remove(std::vector<std::string>()), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(removeIf) {
+    dafBase::PropertySet ps;
+    ps.set("int", 42);
+    ps.set("ints", std::vector<int>{1, 2, 3});
+    ps.set("double", 3.14);
+    ps.set("HIERARCH_X", std::string("foo"));
+    ps.set("ps1.a", 1);
+
+    std::size_t removed = ps.removeIf([](std::string const& name, std::type_info const& type,
+                                         boost::any const& value) {
+        return (type == typeid(int) && boost::any_cast<int>(value) == 3) ||
+               name.compare(0, 9, "HIERARCH_") == 0;
+    });
+    BOOST_CHECK_EQUAL(removed, 2u);
+    BOOST_CHECK(!ps.exists("ints"));
+    BOOST_CHECK(!ps.exists("HIERARCH_X"));
+    BOOST_CHECK(ps.exists("int"));
+    BOOST_CHECK(ps.exists("double"));
+    BOOST_CHECK(ps.exists("ps1.a"));
+
+    // Subproperties are passed as a whole
+    removed = ps.removeIf([](std::string const&, std::type_info const& type, boost::any const&) {
+        return type == typeid(dafBase::PropertySet::Ptr);
+    });
+    BOOST_CHECK_EQUAL(removed, 1u);
+    BOOST_CHECK(!ps.exists("ps1"));
+    BOOST_CHECK_EQUAL(ps.nameCount(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(makeConcurrent) {
+    auto ps = std::make_shared<dafBase::PropertySet>();
+    ps->set("a.b.c", 1);
+    auto other = std::make_shared<dafBase::PropertySet>();
+    other->set("x.y", 2);
+    BOOST_CHECK(!ps->isConcurrent());
+    ps->makeConcurrent();
+    ps->makeConcurrent();
+    BOOST_CHECK(ps->isConcurrent());
+    BOOST_CHECK(ps->getAsPropertySetPtr("a.b")->isConcurrent());
+
+    // Subproperties inserted later become concurrent
+    ps->set("d.e", 3);
+    ps->set("other", other);
+    ps->add("more", std::make_shared<dafBase::PropertySet>());
+    BOOST_CHECK(ps->getAsPropertySetPtr("d")->isConcurrent());
+    BOOST_CHECK(other->isConcurrent());
+    BOOST_CHECK(other->getAsPropertySetPtr("x")->isConcurrent());
+    BOOST_CHECK(ps->getAsPropertySetPtr("more")->isConcurrent());
+    BOOST_CHECK_THROW(ps->add("other", ps), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(ps->add("a.b.c", 1.0), pexExcept::TypeError);
+    BOOST_CHECK_EQUAL(ps->getAsInt("other.x.y"), 2);
+    BOOST_CHECK(!ps->deepCopy()->isConcurrent());
+
+    dafBase::PropertySet flat(true);
+    BOOST_CHECK_THROW(flat.makeConcurrent(), pexExcept::LogicError);
+}
+
+BOOST_AUTO_TEST_CASE(concurrentWriters) {
+    int const nThreads = 8;
+    int const nValues = 2000;
+    dafBase::PropertySet ps;
+    ps.makeConcurrent();
+    std::atomic<bool> done(false);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nThreads; ++t) {
+        threads.emplace_back([&ps, t]() {
+            std::string const branch = "tasks.t" + std::to_string(t) + ".";
+            for (int i = 0; i < nValues; ++i) {
+                ps.set(branch + "v" + std::to_string(i % 10), i);
+                ps.add(branch + "all", i);
+                ps.add("shared", t);  // the same property from every thread
+                ps.add("branches.b" + std::to_string(i % 50) + ".n", i);
+                if (i % 100 == 99) {
+                    ps.remove(branch + "v0");
+                }
+            }
+        });
+    }
+    // Readers, while the tree is being modified
+    std::thread reader([&ps, &done]() {
+        while (!done) {
+            ps.names(false);
+            ps.toString();
+            ps.deepCopy();
+            ps.exists("tasks.t0.all");
+            ps.get<int>("tasks.t1.v1", 0);
+            ps.valueCount();
+        }
+    });
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    done = true;
+    reader.join();
+
+    for (int t = 0; t < nThreads; ++t) {
+        std::string const branch = "tasks.t" + std::to_string(t) + ".";
+        std::vector<int> all = ps.getArray<int>(branch + "all");
+        BOOST_REQUIRE_EQUAL(all.size(), static_cast<std::size_t>(nValues));
+        for (int i = 0; i < nValues; ++i) {
+            BOOST_CHECK_EQUAL(all[i], i);
+        }
+        BOOST_CHECK(!ps.exists(branch + "v0"));
+        BOOST_CHECK_EQUAL(ps.getAsInt(branch + "v9"), nValues - 1);
+    }
+    BOOST_CHECK_EQUAL(ps.valueCount("shared"), static_cast<std::size_t>(nThreads * nValues));
+    BOOST_CHECK_EQUAL(ps.getAsPropertySetPtr("branches")->nameCount(), 50u);
+    BOOST_CHECK_EQUAL(ps.valueCount("branches.b7.n"), static_cast<std::size_t>(nThreads * nValues / 50));
+}
+
+BOOST_AUTO_TEST_CASE(concurrentRemove) {
+    int const nThreads = 8;
+    int const nNames = 100;
+    std::vector<std::string> names;
+    for (int i = 0; i < nNames; ++i) {
+        names.push_back("a.b.v" + std::to_string(i));
+    }
+    for (int round = 0; round < 200; ++round) {
+        dafBase::PropertySet ps;
+        for (auto const& name : names) {
+            ps.set(name, round);
+        }
+        ps.makeConcurrent();
+
+        // Each property is removed, and counted, by exactly one thread
+        std::atomic<std::size_t> removed(0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nThreads; ++t) {
+            threads.emplace_back([&ps, &names, &removed]() { removed += ps.remove(names); });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        BOOST_REQUIRE_EQUAL(removed, static_cast<std::size_t>(nNames));
+        BOOST_CHECK_EQUAL(ps.getAsPropertySetPtr("a.b")->nameCount(), 0u);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(savepoint) {
+    dafBase::PropertySet ps;
+    ps.set("int", 1);
+    ps.add("int", 2);
+    ps.set("a.b.c", std::string("abc"));
+    ps.set("a.x", 1.5);
+    ps.set("gone", true);
+    ps.set("ts", 1.0, dafBase::DateTime(100, dafBase::DateTime::TAI));
+    std::string const before = ps.toString();
+
+    ps.savepoint();
+    BOOST_CHECK(ps.hasSavepoint());
+    ps.add("int", 3);
+    ps.add("int", std::vector<int>{4, 5});
+    ps.set("a.x", 2.5);
+    ps.add("a.b.c", std::string("def"));
+    ps.set("new.branch.value", 7);
+    ps.set("a.b.d", 8);
+    ps.remove("gone");
+    ps.set("ts", 2.0, dafBase::DateTime(200, dafBase::DateTime::TAI));
+    ps.removeIf([](std::string const& name, std::type_info const&, boost::any const&) {
+        return name == "int";
+    });
+    // A partial failure, after some of the changes
+    BOOST_CHECK_THROW(ps.add("a.x", 3), pexExcept::TypeError);
+    ps.rollback();
+
+    BOOST_CHECK(!ps.hasSavepoint());
+    BOOST_CHECK_EQUAL(ps.toString(), before);
+    std::vector<int> ints = ps.getArray<int>("int");
+    BOOST_CHECK_EQUAL(ints.size(), 2u);
+    BOOST_CHECK(!ps.exists("new"));
+    BOOST_CHECK(!ps.exists("a.b.d"));
+    BOOST_CHECK_EQUAL(ps.valueCount("a.b.c"), 1u);
+    BOOST_CHECK_EQUAL(ps.getTimeSeries("ts")->size(), 1u);
+
+    // Appending after a rollback does not resurrect the values rolled back
+    ps.add("int", 9);
+    ints = ps.getArray<int>("int");
+    BOOST_CHECK_EQUAL(ints.size(), 3u);
+    BOOST_CHECK_EQUAL(ints.back(), 9);
+
+    BOOST_CHECK_THROW(ps.rollback(), pexExcept::LogicError);
+    BOOST_CHECK_THROW(ps.release(), pexExcept::LogicError);
+}
+
+BOOST_AUTO_TEST_CASE(savepointNested) {
+    dafBase::PropertySet ps;
+    ps.set("a", 1);
+
+    ps.savepoint();
+    ps.set("a", 2);
+    ps.set("b.c", 3);
+    ps.savepoint();
+    ps.set("a", 4);
+    ps.add("b.c", 5);
+    ps.set("d", 6);
+    ps.release();  // kept, but still undone by the outer savepoint
+    BOOST_CHECK_EQUAL(ps.get<int>("a"), 4);
+    BOOST_CHECK_EQUAL(ps.valueCount("b.c"), 2u);
+
+    ps.savepoint();
+    ps.set("a", 7);
+    ps.remove("b");
+    ps.rollback();
+    BOOST_CHECK_EQUAL(ps.get<int>("a"), 4);
+    BOOST_CHECK_EQUAL(ps.valueCount("b.c"), 2u);
+    BOOST_CHECK(ps.exists("d"));
+
+    ps.rollback();
+    BOOST_CHECK_EQUAL(ps.get<int>("a"), 1);
+    BOOST_CHECK(!ps.exists("b"));
+    BOOST_CHECK(!ps.exists("d"));
+
+    // Released changes are kept
+    ps.savepoint();
+    ps.set("e", 8);
+    ps.release();
+    BOOST_CHECK_EQUAL(ps.get<int>("e"), 8);
+    BOOST_CHECK(!ps.hasSavepoint());
+
+    // Savepoints and concurrency exclude each other
+    ps.savepoint();
+    BOOST_CHECK_THROW(ps.makeConcurrent(), pexExcept::LogicError);
+    ps.release();
+    ps.makeConcurrent();
+    BOOST_CHECK_THROW(ps.savepoint(), pexExcept::LogicError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
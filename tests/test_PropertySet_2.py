@@ -903,6 +903,27 @@ class FlatTestCase(unittest.TestCase):
         with self.assertRaises(TypeError):
             ps.getAsPropertySetPtr("top.bottom")
 
+    def testGetAsDateTime(self):
+        ps = dafBase.PropertySet()
+        date = dafBase.DateTime("2023-01-15T03:04:05Z", dafBase.DateTime.UTC)
+        ps.set("DATE-AVG", date)
+        ps.set("DATE-OBS", "2023-01-15T03:04:05")
+        ps.set("MJD-OBS", date.get(dafBase.DateTime.MJD, dafBase.DateTime.UTC))
+        ps.set("EXPTIME", True)
+
+        self.assertEqual(ps.getAsDateTime("DATE-AVG", dafBase.DateTime.TAI), date)
+        for i in range(2):
+            self.assertEqual(ps.getAsDateTime("DATE-OBS", dafBase.DateTime.UTC), date)
+        self.assertAlmostEqual(ps.getAsDateTime("MJD-OBS", dafBase.DateTime.UTC).nsecs(), date.nsecs(),
+                               delta=1000)
+        ps.set("DATE-OBS", "2024-02-29")
+        self.assertEqual(ps.getAsDateTime("DATE-OBS", dafBase.DateTime.UTC),
+                         dafBase.DateTime("2024-02-29T00:00:00Z", dafBase.DateTime.UTC))
+        with self.assertRaises(TypeError):
+            ps.getAsDateTime("EXPTIME", dafBase.DateTime.UTC)
+        with self.assertRaises(pexExcept.NotFoundError):
+            ps.getAsDateTime("DATE-END", dafBase.DateTime.UTC)
+
     def testRemove(self):
         ps = dafBase.PropertySet()
         ps.set("int", 42)
@@ -946,6 +967,56 @@ class FlatTestCase(unittest.TestCase):
         self.assertFalse(ps.exists("ps1.zero"))
         self.assertEqual(ps.nameCount(False), 0)
 
+    def testRemoveBulk(self):
+        ps = dafBase.PropertySet()
+        ps.set("int", 42)
+        ps.set("double", 3.14159)
+        ps.set("ps1.plus", 1)
+        ps.set("ps1.minus", -1)
+
+        self.assertEqual(ps.remove(["int", "ps1.plus", "missing"]), 2)
+        self.assertEqual(set(ps.names(False)), {"double", "ps1", "ps1.minus"})
+
+        self.assertEqual(ps.removeIf(lambda name, value: isinstance(value, dafBase.PropertySet)), 1)
+        self.assertEqual(ps.names(False), ["double"])
+
+    def testMakeConcurrent(self):
+        ps = dafBase.PropertySet()
+        ps.set("tasks.a.x", 1)
+        self.assertFalse(ps.isConcurrent())
+        ps.makeConcurrent()
+        self.assertTrue(ps.isConcurrent())
+        self.assertTrue(ps.getScalar("tasks.a").isConcurrent())
+        ps.set("tasks.b.y", 2)
+        ps.add("tasks.b.y", 3)
+        self.assertTrue(ps.getScalar("tasks.b").isConcurrent())
+        self.assertEqual(ps.getArray("tasks.b.y"), [2, 3])
+        self.assertFalse(ps.deepCopy().isConcurrent())
+        with self.assertRaises(pexExcept.LogicError):
+            dafBase.PropertyList().makeConcurrent()
+
+    def testSavepoint(self):
+        ps = dafBase.PropertySet()
+        ps.set("int", [1, 2])
+        ps.set("a.b", "x")
+        before = ps.toString()
+        ps.savepoint()
+        ps.add("int", 3)
+        ps.set("a.b", "y")
+        ps.set("c.d", 4.5)
+        ps.remove("int")
+        ps.rollback()
+        self.assertFalse(ps.hasSavepoint())
+        self.assertEqual(ps.toString(), before)
+        self.assertEqual(ps.getArray("int"), [1, 2])
+        self.assertFalse(ps.exists("c"))
+        ps.savepoint()
+        ps.set("e", 1)
+        ps.release()
+        self.assertTrue(ps.exists("e"))
+        with self.assertRaises(pexExcept.LogicError):
+            ps.rollback()
+
     def testDeepCopy(self):
         ps = dafBase.PropertySet()
         ps.set("int", 42)
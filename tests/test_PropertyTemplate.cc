@@ -0,0 +1,194 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/PropertyTemplate.h"
+
+#define BOOST_TEST_MODULE PropertyTemplate
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+std::shared_ptr<dafBase::PropertyList> makeHeader() {
+    auto header = std::make_shared<dafBase::PropertyList>();
+    header->set("INSTRUME", std::string("LATISS"), "instrument");
+    header->set("DATE-OBS", std::string("2023-01-15T03:04:05.123456789"), "start of exposure");
+    header->set("EXPID", 42);
+    header->set("EXPTIME", 30.5);
+    header->set("AIRMASS", 1.1f);
+    header->set("VISIT", 2023011500042LL);
+    header->set("FLAG", true);
+    header->set("MJD-OBS", dafBase::DateTime("2023-01-15T03:04:05.5Z", dafBase::DateTime::UTC));
+    header->set("FILTERS", std::vector<std::string>{"g", "r"});
+    return header;
+}
+
+std::string render(std::string const& format, dafBase::PropertySet const& properties) {
+    return dafBase::PropertyTemplate(format).render(properties);
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(PropertyTemplateSuite)
+
+BOOST_AUTO_TEST_CASE(basic) {
+    auto const header = makeHeader();
+    dafBase::PropertyTemplate const path("{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}");
+    BOOST_CHECK_EQUAL(path.render(*header), "LATISS/20230115/000042");
+    BOOST_CHECK_EQUAL(path.getFormat(), "{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}");
+    BOOST_CHECK((path.getNames() == std::vector<std::string>{"INSTRUME", "DATE-OBS", "EXPID"}));
+
+    BOOST_CHECK_EQUAL(render("plain text", *header), "plain text");
+    BOOST_CHECK_EQUAL(render("{{literal}} {EXPID}{EXPID}", *header), "{literal} 4242");
+    BOOST_CHECK_EQUAL(render("{FILTERS}", *header), "r");
+
+    // Appending to an existing string
+    std::string out("prefix:");
+    path.render(*header, out);
+    BOOST_CHECK_EQUAL(out, "prefix:LATISS/20230115/000042");
+
+    // Hierarchical names
+    dafBase::PropertySet ps;
+    ps.set("a.b", 7);
+    BOOST_CHECK_EQUAL(render("{a.b:>3}", ps), "  7");
+}
+
+BOOST_AUTO_TEST_CASE(numbers) {
+    auto const header = makeHeader();
+    BOOST_CHECK_EQUAL(render("{EXPID}", *header), "42");
+    BOOST_CHECK_EQUAL(render("{EXPID:+d}", *header), "+42");
+    BOOST_CHECK_EQUAL(render("{EXPID:x}|{EXPID:X}|{EXPID:o}", *header), "2a|2A|52");
+    BOOST_CHECK_EQUAL(render("{EXPID:*^8}", *header), "***42***");
+    BOOST_CHECK_EQUAL(render("{EXPID:<5}|", *header), "42   |");
+    BOOST_CHECK_EQUAL(render("{EXPID:.2f}", *header), "42.00");
+    BOOST_CHECK_EQUAL(render("{VISIT}", *header), "2023011500042");
+
+    BOOST_CHECK_EQUAL(render("{EXPTIME}", *header), "30.5");
+    BOOST_CHECK_EQUAL(render("{EXPTIME:.3f}", *header), "30.500");
+    BOOST_CHECK_EQUAL(render("{EXPTIME:08.2f}", *header), "00030.50");
+    BOOST_CHECK_EQUAL(render("{EXPTIME:.2e}", *header), "3.05e+01");
+    BOOST_CHECK_EQUAL(render("{AIRMASS}", *header), "1.1");
+    BOOST_CHECK_EQUAL(render("{FLAG}|{FLAG:d}", *header), "True|1");
+
+    dafBase::PropertySet ps;
+    ps.set("n", -5);
+    ps.set("x", 0.1);
+    ps.set("y", 2.0);
+    ps.set("z", 1.0 / 3.0);
+    ps.set("f", 0.25);
+    BOOST_CHECK_EQUAL(render("{n:05d}|{n:x}|{n:>4}", ps), "-0005|-5|  -5");
+    BOOST_CHECK_EQUAL(render("{x}|{y}|{z}", ps), "0.1|2.0|0.3333333333333333");
+    BOOST_CHECK_EQUAL(render("{f:.1%}|{f:+g}", ps), "25.0%|+0.25");
+    BOOST_CHECK_EQUAL(render("{f:%}|{f:>10.1%}", ps), "25.000000%|     25.0%");
+}
+
+BOOST_AUTO_TEST_CASE(repr) {
+    // Python switches from fixed to scientific notation at these exponents
+    dafBase::PropertySet ps;
+    ps.set("big", 1e15);
+    ps.set("bigger", 1e16);
+    ps.set("small", 1e-4);
+    ps.set("smaller", 1e-5);
+    ps.set("digits", 123456789012345.6);
+    ps.set("negative", -1.5e16);
+    ps.set("zero", -0.0);
+    ps.set("single", 0.1f);
+    BOOST_CHECK_EQUAL(render("{big}|{bigger}|{small}|{smaller}", ps),
+                      "1000000000000000.0|1e+16|0.0001|1e-05");
+    BOOST_CHECK_EQUAL(render("{digits}|{negative}|{zero}|{single}", ps),
+                      "123456789012345.6|-1.5e+16|-0.0|0.1");
+    BOOST_CHECK_EQUAL(render("{big:+}|{smaller:>8}", ps), "+1000000000000000.0|   1e-05");
+}
+
+BOOST_AUTO_TEST_CASE(strings) {
+    auto const header = makeHeader();
+    BOOST_CHECK_EQUAL(render("{INSTRUME:.3}", *header), "LAT");
+    BOOST_CHECK_EQUAL(render("[{INSTRUME:>8}]", *header), "[  LATISS]");
+    BOOST_CHECK_EQUAL(render("[{INSTRUME:8s}]", *header), "[LATISS  ]");
+    BOOST_CHECK_EQUAL(render("[{INSTRUME:_^10}]", *header), "[__LATISS__]");
+}
+
+BOOST_AUTO_TEST_CASE(dates) {
+    auto const header = makeHeader();
+    BOOST_CHECK_EQUAL(render("{DATE-OBS:%Y-%m-%dT%H:%M:%S.%f}", *header), "2023-01-15T03:04:05.123456");
+    BOOST_CHECK_EQUAL(render("{DATE-OBS:%y%j 100%%}", *header), "23015 100%");
+    BOOST_CHECK_EQUAL(render("{MJD-OBS:%Y%m%d %H%M%S.%f}", *header), "20230115 030405.500000");
+    BOOST_CHECK_EQUAL(render("{MJD-OBS}", *header), "2023-01-15T03:04:05.500000000Z");
+
+    dafBase::PropertySet ps;
+    ps.set("compact", std::string("20240229"));
+    ps.set("old", dafBase::DateTime("1965-12-31T23:59:59Z", dafBase::DateTime::UTC));
+    BOOST_CHECK_EQUAL(render("{compact:%j}", ps), "060");
+    BOOST_CHECK_EQUAL(render("{old:%Y-%m-%d %H:%M:%S}", ps), "1965-12-31 23:59:59");
+}
+
+BOOST_AUTO_TEST_CASE(batch) {
+    std::vector<dafBase::PropertySet::ConstPtr> headers;
+    for (int i = 0; i < 3; ++i) {
+        auto header = makeHeader();
+        header->set("EXPID", i);
+        headers.push_back(header);
+    }
+    dafBase::PropertyTemplate const path("{INSTRUME}_{EXPID:03d}");
+    std::vector<std::string> const names = path.render(headers);
+    BOOST_CHECK((names == std::vector<std::string>{"LATISS_000", "LATISS_001", "LATISS_002"}));
+}
+
+BOOST_AUTO_TEST_CASE(errors) {
+    auto const header = makeHeader();
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{EXPID"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("EXPID}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{:d}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{EXPID:q}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{EXPID:.d}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{DATE-OBS:%Q}"), pexExcept::InvalidParameterError);
+    BOOST_CHECK_THROW(dafBase::PropertyTemplate("{DATE-OBS:%Y%}"), pexExcept::InvalidParameterError);
+
+    BOOST_CHECK_THROW(render("{MISSING}", *header), pexExcept::NotFoundError);
+    BOOST_CHECK_THROW(render("{INSTRUME:d}", *header), pexExcept::TypeError);
+    BOOST_CHECK_THROW(render("{EXPTIME:d}", *header), pexExcept::TypeError);
+    BOOST_CHECK_THROW(render("{EXPID:%Y}", *header), pexExcept::TypeError);
+    BOOST_CHECK_THROW(render("{INSTRUME:%Y}", *header), pexExcept::TypeError);
+
+    dafBase::PropertySet ps;
+    ps.set("a.b", 1);
+    BOOST_CHECK_THROW(render("{a}", ps), pexExcept::TypeError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
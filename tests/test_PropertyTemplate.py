@@ -0,0 +1,90 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Test rendering of PropertyTemplate"""
+
+import unittest
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+
+class PropertyTemplateTestCase(unittest.TestCase):
+
+    def makeHeader(self, expId):
+        header = dafBase.PropertyList()
+        header.set("INSTRUME", "LATISS")
+        header.set("DATE-OBS", "2023-01-15T03:04:05.123")
+        header.set("EXPID", expId)
+        header.set("EXPTIME", 30.5)
+        return header
+
+    def testRender(self):
+        template = dafBase.PropertyTemplate("{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}")
+        self.assertEqual(template.getFormat(), "{INSTRUME}/{DATE-OBS:%Y%m%d}/{EXPID:06d}")
+        self.assertEqual(template.getNames(), ["INSTRUME", "DATE-OBS", "EXPID"])
+        self.assertEqual(template.render(self.makeHeader(42)), "LATISS/20230115/000042")
+
+    def testMatchesPython(self):
+        header = self.makeHeader(42)
+        for spec in ("", ">8", "<8", "^8", "*^9", "+d", "05d", "x", "X", "o", ".2f", "e", ".3g", "08.1f"):
+            self.assertEqual(dafBase.PropertyTemplate("{EXPID:%s}" % spec).render(header),
+                             format(42, spec), spec)
+        for spec in ("", ".2f", "010.3f", "e", "+g", "%", ".1%"):
+            self.assertEqual(dafBase.PropertyTemplate("{EXPTIME:%s}" % spec).render(header),
+                             format(30.5, spec), spec)
+        for spec in ("", ".3", ">10", "_^10", "10s"):
+            self.assertEqual(dafBase.PropertyTemplate("{INSTRUME:%s}" % spec).render(header),
+                             format("LATISS", spec), spec)
+
+    def testRepr(self):
+        template = dafBase.PropertyTemplate("{X}")
+        for value in (1e15, 1e16, 1e-4, 1e-5, 123456789012345.6, -1.5e16, -0.0, 1/3):
+            header = dafBase.PropertySet()
+            header.set("X", value)
+            self.assertEqual(template.render(header), repr(value))
+
+    def testBatch(self):
+        template = dafBase.PropertyTemplate("{INSTRUME}_{EXPID:03d}")
+        headers = [self.makeHeader(i) for i in range(3)]
+        self.assertEqual(template.render(headers), ["LATISS_000", "LATISS_001", "LATISS_002"])
+
+    def testErrors(self):
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            dafBase.PropertyTemplate("{EXPID")
+        with self.assertRaises(lsst.pex.exceptions.NotFoundError):
+            dafBase.PropertyTemplate("{MISSING}").render(self.makeHeader(1))
+        with self.assertRaises(lsst.pex.exceptions.TypeError):
+            dafBase.PropertyTemplate("{INSTRUME:d}").render(self.makeHeader(1))
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
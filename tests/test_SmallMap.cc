@@ -0,0 +1,166 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include "lsst/daf/base/detail/SmallMap.h"
+
+#define BOOST_TEST_MODULE SmallMap
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+namespace detail = lsst::daf::base::detail;
+
+namespace {
+
+typedef detail::SmallMap<int, 8> Map;
+
+// Check that a SmallMap has the same contents as a reference map
+void checkSame(Map const& map, std::unordered_map<std::string, int> const& reference) {
+    BOOST_REQUIRE_EQUAL(map.size(), reference.size());
+    for (auto const& entry : map) {
+        auto const i = reference.find(entry.first);
+        BOOST_REQUIRE(i != reference.end());
+        BOOST_CHECK_EQUAL(entry.second, i->second);
+    }
+    for (auto const& entry : reference) {
+        auto const i = map.find(entry.first);
+        BOOST_REQUIRE(i != map.end());
+        BOOST_CHECK_EQUAL(i->second, entry.second);
+    }
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(SmallMapSuite)
+
+BOOST_AUTO_TEST_CASE(basics) {
+    Map map;
+    BOOST_CHECK(map.empty());
+    BOOST_CHECK(map.find("a") == map.end());
+    map["a"] = 1;
+    map["b"] = 2;
+    map["a"] = 3;
+    BOOST_CHECK_EQUAL(map.size(), 2u);
+    BOOST_CHECK_EQUAL(map.find("a")->second, 3);
+    BOOST_CHECK_EQUAL(map.count("b"), 1u);
+    BOOST_CHECK_EQUAL(map.count("c"), 0u);
+    BOOST_CHECK(!map.isIndexed());
+
+    BOOST_CHECK_EQUAL(map.erase("c"), 0u);
+    BOOST_CHECK_EQUAL(map.erase("a"), 1u);
+    BOOST_CHECK_EQUAL(map.size(), 1u);
+    BOOST_CHECK(map.find("a") == map.end());
+
+    Map copy(map);
+    copy["c"] = 4;
+    BOOST_CHECK_EQUAL(map.size(), 1u);
+    BOOST_CHECK_EQUAL(copy.size(), 2u);
+    map.clear();
+    BOOST_CHECK(map.empty());
+}
+
+BOOST_AUTO_TEST_CASE(promotion) {
+    Map map;
+    for (int i = 0; i < 8; ++i) {
+        map["key" + std::to_string(i)] = i;
+    }
+    BOOST_CHECK(!map.isIndexed());
+    map["key8"] = 8;
+    BOOST_CHECK(map.isIndexed());
+    for (int i = 0; i < 9; ++i) {
+        BOOST_CHECK_EQUAL(map.find("key" + std::to_string(i))->second, i);
+    }
+
+    // Copies keep a working index
+    Map copy;
+    copy = map;
+    BOOST_CHECK(copy.isIndexed());
+    BOOST_CHECK_EQUAL(copy.find("key5")->second, 5);
+
+    // Shrinking to half the threshold drops the index
+    for (int i = 0; i < 5; ++i) {
+        map.erase("key" + std::to_string(i));
+    }
+    BOOST_CHECK(!map.isIndexed());
+    BOOST_CHECK_EQUAL(map.find("key7")->second, 7);
+
+    Map reserved;
+    reserved.reserve(100);
+    BOOST_CHECK(reserved.isIndexed());
+    reserved["x"] = 1;
+    BOOST_CHECK_EQUAL(reserved.find("x")->second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(eraseWhileIterating) {
+    Map map;
+    std::unordered_map<std::string, int> reference;
+    for (int i = 0; i < 100; ++i) {
+        map["k" + std::to_string(i)] = i;
+        reference["k" + std::to_string(i)] = i;
+    }
+    int visited = 0;
+    for (auto i = map.begin(); i != map.end();) {
+        ++visited;
+        if (i->second % 3 == 0) {
+            reference.erase(i->first);
+            i = map.erase(i);
+        } else {
+            ++i;
+        }
+    }
+    BOOST_CHECK_EQUAL(visited, 100);
+    checkSame(map, reference);
+}
+
+BOOST_AUTO_TEST_CASE(random) {
+    // Mixed insertions and deletions across the threshold in both directions
+    std::mt19937 rng(42);
+    Map map;
+    std::unordered_map<std::string, int> reference;
+    for (int step = 0; step < 20000; ++step) {
+        bool const shrinking = (step / 2000) % 2;
+        if (rng() % 3 == 0 || shrinking) {
+            std::string const key = "key" + std::to_string(rng() % 64);
+            BOOST_REQUIRE_EQUAL(map.erase(key), reference.erase(key));
+        }
+        if (rng() % 3 != 0) {
+            std::string const key = "key" + std::to_string(rng() % (shrinking ? 6 : 64));
+            map[key] = step;
+            reference[key] = step;
+        }
+        if (step % 97 == 0) {
+            checkSame(map, reference);
+        }
+    }
+    checkSame(map, reference);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
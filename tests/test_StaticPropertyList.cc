@@ -0,0 +1,209 @@
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/StaticPropertyList.h"
+
+#define BOOST_TEST_MODULE StaticPropertyList
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+std::atomic<long> allocations(0);
+
+void* countedAlloc(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+}  // namespace
+
+// Count every allocation made by this program; each replaced form of new has its matching delete
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+BOOST_AUTO_TEST_SUITE(StaticPropertyListSuite)
+
+BOOST_AUTO_TEST_CASE(setGet) {
+    dafBase::StaticPropertyList<16, 1024> md;
+    BOOST_CHECK_EQUAL(md.size(), 0U);
+    BOOST_CHECK_EQUAL(md.getMaxKeys(), 16U);
+    BOOST_CHECK_EQUAL(md.getMaxBytes(), 1024U);
+
+    dafBase::DateTime const date(1234567890123456789LL, dafBase::DateTime::TAI);
+    md.set("EXPTIME", 15.0, "exposure time");
+    md.set<short>("NAMP", 16);
+    md.set("OBSID", 12345678901LL, "observation");
+    md.set("SHUTTER", true);
+    md.set("FILTER", "r", "filter name");
+    md.set("DATE-BEG", date);
+    md.set("GAIN", 1.5f);
+
+    BOOST_CHECK_EQUAL(md.size(), 7U);
+    BOOST_CHECK(md.exists("EXPTIME"));
+    BOOST_CHECK(!md.exists("EXPTIM"));
+    BOOST_CHECK_EQUAL(md.get<double>("EXPTIME"), 15.0);
+    BOOST_CHECK_EQUAL(md.get<short>("NAMP"), 16);
+    BOOST_CHECK_EQUAL(md.get<long long>("OBSID"), 12345678901LL);
+    BOOST_CHECK_EQUAL(md.get<bool>("SHUTTER"), true);
+    BOOST_CHECK_EQUAL(md.get<std::string>("FILTER"), "r");
+    BOOST_CHECK_EQUAL(md.get<dafBase::DateTime>("DATE-BEG").nsecs(), date.nsecs());
+    BOOST_CHECK_EQUAL(md.get<float>("GAIN"), 1.5f);
+    BOOST_CHECK(md.typeOf("FILTER") == typeid(std::string));
+    BOOST_CHECK(md.typeOf("DATE-BEG") == typeid(dafBase::DateTime));
+    BOOST_CHECK(md.typeOf("NAMP") == typeid(short));
+    BOOST_CHECK_EQUAL(std::string(md.getComment("EXPTIME")), "exposure time");
+    BOOST_CHECK_EQUAL(std::string(md.getComment("NAMP")), "");
+
+    BOOST_CHECK_THROW(md.get<int>("NAMP"), pexExcept::TypeError);
+    BOOST_CHECK_THROW(md.get<std::string>("NAMP"), pexExcept::TypeError);
+    BOOST_CHECK_THROW(md.get<dafBase::DateTime>("FILTER"), pexExcept::TypeError);
+    BOOST_CHECK_THROW(md.get<double>("MISSING"), pexExcept::NotFoundError);
+    BOOST_CHECK_THROW(md.getComment("MISSING"), pexExcept::NotFoundError);
+    BOOST_CHECK_THROW(md.typeOf("MISSING"), pexExcept::NotFoundError);
+    BOOST_CHECK_THROW(md.setComment("MISSING", "x"), pexExcept::NotFoundError);
+}
+
+BOOST_AUTO_TEST_CASE(replace) {
+    dafBase::StaticPropertyList<4, 256> md;
+    md.set("A", 1, "first");
+    md.set("B", "a long string value", "second");
+    md.set("C", 3);
+    std::size_t const used = md.getBytesUsed();
+
+    // Values and comments are replaced in place, keeping order and unchanged comments
+    md.set("A", 2.5);
+    md.set("B", "shorter");
+    md.setComment("B", "new");
+    md.set("C", 4, "third");
+    BOOST_CHECK_EQUAL(md.getBytesUsed(), used + 6);  // only the new comment of C needs space
+    BOOST_CHECK_EQUAL(md.get<double>("A"), 2.5);
+    BOOST_CHECK_EQUAL(std::string(md.getComment("A")), "first");
+    BOOST_CHECK_EQUAL(md.get<std::string>("B"), "shorter");
+    BOOST_CHECK_EQUAL(std::string(md.getComment("B")), "new");
+    BOOST_CHECK_EQUAL(md.get<int>("C"), 4);
+
+    auto const pl = md.toPropertyList();
+    BOOST_CHECK(pl->getOrderedNames() == (std::vector<std::string>{"A", "B", "C"}));
+
+    md.clear();
+    BOOST_CHECK_EQUAL(md.size(), 0U);
+    BOOST_CHECK_EQUAL(md.getBytesUsed(), 0U);
+    BOOST_CHECK(!md.exists("A"));
+}
+
+BOOST_AUTO_TEST_CASE(capacity) {
+    dafBase::StaticPropertyList<2, 16> md;
+    md.set("A", 1);
+    md.set("B", 2, "comment");
+    BOOST_CHECK_THROW(md.set("C", 3), pexExcept::LengthError);
+    BOOST_CHECK_THROW(md.set("A", "this string is too long"), pexExcept::LengthError);
+    BOOST_CHECK_THROW(md.set("A", 5, "this comment is too long"), pexExcept::LengthError);
+    // Failed operations leave the contents unchanged
+    BOOST_CHECK_EQUAL(md.size(), 2U);
+    BOOST_CHECK_EQUAL(md.get<int>("A"), 1);
+    BOOST_CHECK_EQUAL(std::string(md.getComment("A")), "");
+    BOOST_CHECK_EQUAL(md.getBytesUsed(), 12U);
+    md.set("A", "abc");
+    BOOST_CHECK_EQUAL(md.getBytesUsed(), 16U);
+    BOOST_CHECK_EQUAL(md.get<std::string>("A"), "abc");
+}
+
+BOOST_AUTO_TEST_CASE(noAllocation) {
+    dafBase::StaticPropertyList<64, 4096> md;
+    dafBase::DateTime const date(1234567890123456789LL, dafBase::DateTime::TAI);
+    char names[32][8];
+    for (int i = 0; i < 32; ++i) {
+        std::snprintf(names[i], sizeof(names[i]), "KEY%d", i);
+    }
+    long const before = allocations;
+    for (int iter = 0; iter < 1000; ++iter) {
+        md.clear();
+        for (int i = 0; i < 32; ++i) {
+            switch (i % 4) {
+                case 0:
+                    md.set(names[i], iter, "an integer");
+                    break;
+                case 1:
+                    md.set(names[i], 0.5 * iter, "a double");
+                    break;
+                case 2:
+                    md.set(names[i], "a string value", "a string");
+                    break;
+                default:
+                    md.set(names[i], date);
+                    break;
+            }
+        }
+        md.set("KEY0", iter + 1);
+        md.setComment("KEY1", "changed");
+    }
+    long const after = allocations;
+    BOOST_CHECK_EQUAL(after - before, 0);
+    BOOST_CHECK_EQUAL(md.get<int>("KEY0"), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(toPropertyList) {
+    dafBase::StaticPropertyList<8, 512> md;
+    dafBase::DateTime const date(1234567890123456789LL, dafBase::DateTime::TAI);
+    md.set("ZED", 1.5, "last letter");
+    md.set("ALPHA", "x");
+    md.set<unsigned char>("BYTE", 7, "a byte");
+    md.set("HIER.KEY", date, "hierarchical");
+
+    auto const pl = md.toPropertyList();
+    BOOST_CHECK(pl->getOrderedNames() == (std::vector<std::string>{"ZED", "ALPHA", "BYTE", "HIER.KEY"}));
+    BOOST_CHECK_EQUAL(pl->get<double>("ZED"), 1.5);
+    BOOST_CHECK_EQUAL(pl->getComment("ZED"), "last letter");
+    BOOST_CHECK_EQUAL(pl->get<std::string>("ALPHA"), "x");
+    BOOST_CHECK_EQUAL(pl->getComment("ALPHA"), "");
+    BOOST_CHECK(pl->typeOf("BYTE") == typeid(unsigned char));
+    BOOST_CHECK_EQUAL(pl->get<dafBase::DateTime>("HIER.KEY").nsecs(), date.nsecs());
+    BOOST_CHECK_EQUAL(pl->getComment("HIER.KEY"), "hierarchical");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,217 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/TimeSeries.h"
+
+#define BOOST_TEST_MODULE TimeSeries
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+long long const SECOND = 1000000000LL;
+long long const T0 = 1700000000LL * SECOND;
+
+dafBase::DateTime at(long long seconds) {
+    return dafBase::DateTime(T0 + seconds * SECOND, dafBase::DateTime::TAI);
+}
+
+std::vector<double> valuesOf(dafBase::TimeSeries const& series) {
+    std::vector<double> values;
+    for (std::size_t i = 0; i < series.size(); ++i) {
+        values.push_back(series.getValue(i));
+    }
+    return values;
+}
+
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(TimeSeriesSuite)
+
+BOOST_AUTO_TEST_CASE(valueAt) {
+    dafBase::TimeSeries series;
+    BOOST_CHECK(series.empty());
+    BOOST_CHECK(!series.getTimes());
+    BOOST_CHECK_THROW(series.valueAt(at(0)), pexExcept::NotFoundError);
+    for (int i = 0; i < 100; ++i) {
+        series.append(at(10 * i), i);
+    }
+    BOOST_CHECK_EQUAL(series.size(), 100u);
+    BOOST_CHECK_EQUAL(series.getCapacity(), 0u);
+    BOOST_CHECK_EQUAL(series.valueAt(at(0)), 0.0);
+    BOOST_CHECK_EQUAL(series.valueAt(at(9)), 0.0);
+    BOOST_CHECK_EQUAL(series.valueAt(at(10)), 1.0);
+    BOOST_CHECK_EQUAL(series.valueAt(at(100000)), 99.0);
+    BOOST_CHECK_THROW(series.valueAt(at(-1)), pexExcept::NotFoundError);
+    BOOST_CHECK(series.getTime(42) == at(420));
+    BOOST_CHECK_EQUAL(series.getTimes().get()[42], T0 + 420 * SECOND);
+    BOOST_CHECK_EQUAL(series.getValues().get()[42], 42.0);
+    BOOST_CHECK_THROW(series.getValue(100), pexExcept::OutOfRangeError);
+    BOOST_CHECK_THROW(series.append(dafBase::DateTime(), 1.0), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(outOfOrder) {
+    dafBase::TimeSeries series;
+    series.append(at(10), 1.0);
+    series.append(at(30), 3.0);
+    series.append(at(20), 2.0);
+    series.append(at(0), 0.0);
+    series.append(at(20), 2.5);  // after the existing sample with the same time
+    BOOST_CHECK((valuesOf(series) == std::vector<double>{0.0, 1.0, 2.0, 2.5, 3.0}));
+    BOOST_CHECK_EQUAL(series.valueAt(at(25)), 2.5);
+}
+
+BOOST_AUTO_TEST_CASE(retention) {
+    dafBase::TimeSeries series(3);
+    BOOST_CHECK_EQUAL(series.getCapacity(), 3u);
+    for (int i = 0; i < 1000; ++i) {
+        series.append(at(i), i);
+        BOOST_REQUIRE_EQUAL(series.size(), std::min(i + 1, 3));
+    }
+    BOOST_CHECK((valuesOf(series) == std::vector<double>{997.0, 998.0, 999.0}));
+    BOOST_CHECK_THROW(series.valueAt(at(996)), pexExcept::NotFoundError);
+
+    series.append(at(0), -1.0);  // older than everything retained
+    BOOST_CHECK((valuesOf(series) == std::vector<double>{997.0, 998.0, 999.0}));
+    series.append(at(998), 1.5);
+    BOOST_CHECK((valuesOf(series) == std::vector<double>{998.0, 1.5, 999.0}));
+}
+
+BOOST_AUTO_TEST_CASE(sharing) {
+    dafBase::TimeSeries series(4);
+    for (int i = 0; i < 4; ++i) {
+        series.append(at(i), i);
+    }
+    auto const times = series.getTimes();
+    auto const values = series.getValues();
+    auto const range = series.range(at(1), at(3));
+    dafBase::TimeSeries copy(series);
+    BOOST_CHECK((valuesOf(*range) == std::vector<double>{1.0, 2.0}));
+    BOOST_CHECK_EQUAL(range->getCapacity(), 0u);
+
+    // Modifications do not affect the samples seen by the arrays, the range or the copy
+    for (int i = 4; i < 20; ++i) {
+        series.append(at(i), i);
+    }
+    series.append(at(17), 100.0);
+    range->append(at(100), 100.0);
+    copy.append(at(2), 100.0);
+    BOOST_CHECK((valuesOf(series) == std::vector<double>{17.0, 100.0, 18.0, 19.0}));
+    BOOST_CHECK((valuesOf(*range) == std::vector<double>{1.0, 2.0, 100.0}));
+    BOOST_CHECK((valuesOf(copy) == std::vector<double>{1.0, 2.0, 100.0, 3.0}));
+    for (int i = 0; i < 4; ++i) {
+        BOOST_CHECK_EQUAL(times.get()[i], T0 + i * SECOND);
+        BOOST_CHECK_EQUAL(values.get()[i], i);
+    }
+
+    BOOST_CHECK_EQUAL(series.range(at(50), at(60))->size(), 0u);
+    BOOST_CHECK_EQUAL(series.range(at(60), at(50))->size(), 0u);
+    BOOST_CHECK_EQUAL(series.range(dafBase::DateTime(), at(18))->size(), 2u);
+}
+
+BOOST_AUTO_TEST_CASE(downsample) {
+    dafBase::TimeSeries series;
+    for (int i = -6; i < 6; ++i) {
+        series.append(at(i), i);
+    }
+    auto const mean = series.downsample(std::chrono::seconds(4));
+    BOOST_REQUIRE_EQUAL(mean->size(), 4u);
+    BOOST_CHECK(mean->getTime(0) == at(-8));  // T0 is a multiple of 4 seconds
+    BOOST_CHECK((valuesOf(*mean) == std::vector<double>{-5.5, -2.5, 1.5, 4.5}));
+    BOOST_CHECK((valuesOf(*series.downsample(std::chrono::seconds(4), dafBase::TimeSeries::FIRST)) ==
+                 std::vector<double>{-6.0, -4.0, 0.0, 4.0}));
+    BOOST_CHECK((valuesOf(*series.downsample(std::chrono::seconds(4), dafBase::TimeSeries::LAST)) ==
+                 std::vector<double>{-5.0, -1.0, 3.0, 5.0}));
+    BOOST_CHECK((valuesOf(*series.downsample(std::chrono::seconds(5), dafBase::TimeSeries::MIN)) ==
+                 std::vector<double>{-6.0, -5.0, 0.0, 5.0}));
+    BOOST_CHECK((valuesOf(*series.downsample(std::chrono::seconds(5), dafBase::TimeSeries::MAX)) ==
+                 std::vector<double>{-6.0, -1.0, 4.0, 5.0}));
+
+    // Times before the epoch
+    dafBase::TimeSeries early;
+    early.append(dafBase::DateTime(-3, dafBase::DateTime::TAI), 1.0);
+    early.append(dafBase::DateTime(-1, dafBase::DateTime::TAI), 2.0);
+    early.append(dafBase::DateTime(0, dafBase::DateTime::TAI), 3.0);
+    auto const binned = early.downsample(std::chrono::nanoseconds(2));
+    BOOST_REQUIRE_EQUAL(binned->size(), 3u);
+    BOOST_CHECK_EQUAL(binned->getTime(0).nsecs(), -4);
+    BOOST_CHECK_EQUAL(binned->getTime(1).nsecs(), -2);
+    BOOST_CHECK_EQUAL(binned->getTime(2).nsecs(), 0);
+
+    BOOST_CHECK_THROW(series.downsample(std::chrono::seconds(0)), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(propertySet) {
+    auto const properties = std::make_shared<dafBase::PropertyList>();
+    properties->set("AIRMASS", 1.2);
+    properties->set("TEMP", 20.0, at(0));
+    properties->set("TEMP", 21.0, at(60));
+    properties->set("FOCUS", 5, at(0));
+    BOOST_CHECK((properties->getOrderedNames() == std::vector<std::string>{"AIRMASS", "TEMP", "FOCUS"}));
+
+    auto const temp = properties->getTimeSeries("TEMP");
+    BOOST_CHECK_EQUAL(temp->size(), 2u);
+    BOOST_CHECK_EQUAL(temp->valueAt(at(30)), 20.0);
+    BOOST_CHECK(properties->typeOf("TEMP") == typeid(dafBase::Persistable::Ptr));
+    BOOST_CHECK_THROW(properties->getTimeSeries("AIRMASS"), pexExcept::TypeError);
+    BOOST_CHECK_THROW(properties->getTimeSeries("MISSING"), pexExcept::NotFoundError);
+
+    // A series with limited retention
+    properties->set("AIRMASS", dafBase::Persistable::Ptr(std::make_shared<dafBase::TimeSeries>(2)));
+    for (int i = 0; i < 10; ++i) {
+        properties->set("AIRMASS", 1.0 + i / 10.0, at(i));
+    }
+    BOOST_CHECK_EQUAL(properties->getTimeSeries("AIRMASS")->size(), 2u);
+
+    // Copies are independent
+    auto const copy = properties->deepCopy();
+    copy->set("TEMP", 22.0, at(120));
+    BOOST_CHECK_EQUAL(copy->getTimeSeries("TEMP")->size(), 3u);
+    BOOST_CHECK_EQUAL(temp->size(), 2u);
+
+    // Hierarchical names, and replacement of other values
+    dafBase::PropertySet set;
+    set.set("dome.temp", 1.0, at(0));
+    set.set("dome.temp", 2.0, at(1));
+    BOOST_CHECK_EQUAL(set.getTimeSeries("dome.temp")->size(), 2u);
+    set.set("dome.temp", std::string("warm"));
+    set.set("dome.temp", 3.0, at(2));
+    BOOST_CHECK_EQUAL(set.getTimeSeries("dome.temp")->size(), 1u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
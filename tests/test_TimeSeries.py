@@ -0,0 +1,108 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+
+"""Test TimeSeries and time-stamped property values"""
+
+import datetime
+import unittest
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.pex.exceptions
+import lsst.daf.base as dafBase
+
+T0 = 1700000000*10**9
+
+
+def at(seconds):
+    return dafBase.DateTime(T0 + seconds*10**9, dafBase.DateTime.TAI)
+
+
+class TimeSeriesTestCase(unittest.TestCase):
+
+    def testPropertySet(self):
+        for container in (dafBase.PropertySet(), dafBase.PropertyList()):
+            container.setTimeSeries("TEMP", 20.0, at(0))
+            container.setTimeSeries("TEMP", 21.0, at(60))
+            series = container.getTimeSeries("TEMP")
+            self.assertIsInstance(series, dafBase.TimeSeries)
+            self.assertIsInstance(container.getScalar("TEMP"), dafBase.TimeSeries)
+            self.assertEqual(len(series), 2)
+            self.assertEqual(series.valueAt(at(30)), 20.0)
+            self.assertEqual(series.valueAt(at(60)), 21.0)
+            with self.assertRaises(lsst.pex.exceptions.NotFoundError):
+                series.valueAt(at(-1))
+
+    def testRetention(self):
+        container = dafBase.PropertyList()
+        container.setTimeSeries("FOCUS", dafBase.TimeSeries(capacity=3))
+        for i in range(10):
+            container.setTimeSeries("FOCUS", float(i), at(i))
+        series = container.getTimeSeries("FOCUS")
+        self.assertEqual(series.getCapacity(), 3)
+        np.testing.assert_array_equal(series.getValues(), [7.0, 8.0, 9.0])
+
+    def testArrays(self):
+        series = dafBase.TimeSeries()
+        times = T0 + 10**9*np.arange(1000, dtype=np.int64)
+        values = np.arange(1000, dtype=np.float64)
+        series.append(times, values)
+        viewTimes = series.getTimes()
+        viewValues = series.getValues()
+        np.testing.assert_array_equal(viewTimes, times)
+        np.testing.assert_array_equal(viewValues, values)
+        self.assertFalse(viewValues.flags.writeable)
+
+        # Arrays are snapshots, unaffected by later changes to the series
+        series.append(at(500), -1.0)
+        del series
+        np.testing.assert_array_equal(viewValues, values)
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            dafBase.TimeSeries().append(times, values[:10])
+
+    def testRangeAndDownsample(self):
+        series = dafBase.TimeSeries()
+        series.append(T0 + 10**9*np.arange(120, dtype=np.int64), np.arange(120, dtype=np.float64))
+        subset = series.range(at(10), at(20))
+        np.testing.assert_array_equal(subset.getValues(), np.arange(10, 20))
+        means = series.downsample(datetime.timedelta(seconds=60))
+        # T0 is 20 s past a minute
+        self.assertEqual(len(means), 3)
+        self.assertEqual(means.getTime(0), at(-20))
+        self.assertEqual(means.getValue(0), 19.5)
+        maxima = series.downsample(datetime.timedelta(seconds=60), dafBase.TimeSeries.MAX)
+        self.assertEqual(maxima.getValue(0), 39.0)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
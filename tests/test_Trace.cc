@@ -0,0 +1,239 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "boost/regex.hpp"
+
+#include "lsst/daf/base/DateTime.h"
+#include "lsst/daf/base/PropertyList.h"
+#include "lsst/daf/base/Trace.h"
+
+#define BOOST_TEST_MODULE Trace
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/pex/exceptions/Runtime.h"
+
+namespace dafBase = lsst::daf::base;
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace {
+
+// Allocations made by the current thread
+thread_local long allocations = 0;
+
+void* countedAlloc(std::size_t size) {
+    ++allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+// Allocations made by a new thread while it runs func
+template <typename F>
+long allocationsIn(F func) {
+    long result = -1;
+    std::thread thread([&]() {
+        long const before = allocations;
+        func();
+        result = allocations - before;
+    });
+    thread.join();
+    return result;
+}
+
+// Names of the spans in a trace, in order
+std::vector<std::string> spanNames(std::string const& json) {
+    static boost::regex const name("\\{\"name\":\"([^\"]*)\",\"cat\":\"daf_base\",\"ph\":\"X\"");
+    std::vector<std::string> names;
+    for (boost::sregex_iterator i(json.begin(), json.end(), name), end; i != end; ++i) {
+        names.push_back((*i)[1]);
+    }
+    return names;
+}
+
+std::string flush() {
+    std::ostringstream os;
+    dafBase::Trace::flush(os);
+    return os.str();
+}
+
+// Restore the default state after each test
+struct TraceFixture {
+    TraceFixture() { dafBase::Trace::clear(); }
+    ~TraceFixture() {
+        dafBase::Trace::disable();
+        dafBase::Trace::clear();
+    }
+};
+
+}  // namespace
+
+// Count every allocation made by this program; each replaced form of new has its matching delete
+void* operator new(std::size_t size) { return countedAlloc(size); }
+void* operator new[](std::size_t size) { return countedAlloc(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+BOOST_FIXTURE_TEST_SUITE(TraceSuite, TraceFixture)
+
+BOOST_AUTO_TEST_CASE(disabled) {
+    BOOST_CHECK(!dafBase::Trace::isEnabled());
+    dafBase::PropertyList list;
+    list.set("A", 1);
+    list.deepCopy();
+    BOOST_CHECK_EQUAL(flush(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+
+    // A disabled span records nothing, and its thread never allocates a buffer
+    auto const spans = []() {
+        for (int i = 0; i < 1000; ++i) {
+            LSST_DAF_BASE_TRACE_SPAN("disabled");
+        }
+    };
+    BOOST_CHECK_EQUAL(allocationsIn(spans), 0);
+    BOOST_CHECK(spanNames(flush()).empty());
+    BOOST_CHECK_EQUAL(dafBase::Trace::getDropped(), 0u);
+
+    dafBase::Trace::enable();
+    BOOST_CHECK_GT(allocationsIn(spans), 0);
+    BOOST_CHECK_EQUAL(spanNames(flush()).size(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(enabled) {
+    dafBase::Trace::enable();
+    BOOST_CHECK(dafBase::Trace::isEnabled());
+    dafBase::PropertyList list;
+    list.set("A", 1);
+    list.deepCopy();
+    dafBase::DateTime("2023-01-15T03:04:05Z", dafBase::DateTime::UTC).toString(dafBase::DateTime::UTC);
+    {
+        dafBase::TraceSpan span(dafBase::Trace::intern("quote\" and backslash\\"), "custom");
+    }
+    dafBase::Trace::disable();
+    list.deepCopy();
+
+    std::string const json = flush();
+    // Spans are recorded when they end, so nested spans come first
+    std::vector<std::string> const expected = {"PropertySet::deepCopy", "PropertySet::combine",
+                                               "PropertyList::deepCopy", "DateTime::DateTime(iso8601)",
+                                               "DateTime::toString"};
+    BOOST_CHECK(spanNames(json) == expected);
+    std::string const escaped = "{\"name\":\"quote\\\" and backslash\\\\\",\"cat\":\"custom\"";
+    BOOST_CHECK(json.find(escaped) != std::string::npos);
+    BOOST_CHECK(spanNames(flush()).empty());  // flushed spans are discarded
+}
+
+BOOST_AUTO_TEST_CASE(sampling) {
+    dafBase::Trace::enable(10);
+    for (int i = 0; i < 100; ++i) {
+        dafBase::TraceSpan outer("outer");
+        dafBase::TraceSpan inner("inner");
+    }
+    auto const names = spanNames(flush());
+    BOOST_CHECK_EQUAL(names.size(), 20u);
+    BOOST_CHECK_EQUAL(std::count(names.begin(), names.end(), "inner"), 10);
+
+    dafBase::Trace::enable(1, std::chrono::seconds(1));
+    {
+        LSST_DAF_BASE_TRACE_SPAN("short");
+    }
+    BOOST_CHECK(spanNames(flush()).empty());
+
+    BOOST_CHECK_THROW(dafBase::Trace::enable(0), pexExcept::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(threads) {
+    dafBase::Trace::enable();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 100; ++i) {
+                LSST_DAF_BASE_TRACE_SPAN("thread");
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    std::string const json = flush();
+    BOOST_CHECK_EQUAL(spanNames(json).size(), 400u);
+    static boost::regex const tid("\"tid\":(\\d+)");
+    std::set<std::string> tids;
+    for (boost::sregex_iterator i(json.begin(), json.end(), tid), end; i != end; ++i) {
+        tids.insert((*i)[1]);
+    }
+    BOOST_CHECK_EQUAL(tids.size(), 4u);
+}
+
+BOOST_AUTO_TEST_CASE(overflow) {
+    dafBase::Trace::enable();
+    for (std::size_t i = 0; i < dafBase::Trace::BUFFER_SIZE + 10; ++i) {
+        LSST_DAF_BASE_TRACE_SPAN("overflow");
+    }
+    BOOST_CHECK_EQUAL(dafBase::Trace::getDropped(), 10u);
+    std::ostringstream os;
+    BOOST_CHECK_EQUAL(dafBase::Trace::flush(os), dafBase::Trace::BUFFER_SIZE);
+    dafBase::Trace::clear();
+    BOOST_CHECK_EQUAL(dafBase::Trace::getDropped(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE(file) {
+    dafBase::Trace::enable();
+    {
+        LSST_DAF_BASE_TRACE_SPAN("file");
+    }
+    char name[] = "/tmp/test_Trace_XXXXXX";
+    int const fd = mkstemp(name);
+    BOOST_REQUIRE(fd >= 0);
+    close(fd);
+    BOOST_CHECK_EQUAL(dafBase::Trace::flush(std::string(name)), 1u);
+    std::ifstream in(name);
+    std::string const json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::remove(name);
+    BOOST_CHECK((spanNames(json) == std::vector<std::string>{"file"}));
+    BOOST_CHECK_THROW(dafBase::Trace::flush(std::string("/nonexistent/directory/trace.json")),
+                      pexExcept::IoError);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
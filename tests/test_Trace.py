@@ -0,0 +1,108 @@
+# This file is part of daf_base
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (http://www.lsst.org/).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+"""Test recording of trace spans"""
+
+import json
+import os
+import pickle
+import tempfile
+import unittest
+
+import lsst.utils.tests
+import lsst.daf.base as dafBase
+
+
+class TraceTestCase(unittest.TestCase):
+
+    def setUp(self):
+        dafBase.Trace.disable()
+        dafBase.Trace.clear()
+
+    def tearDown(self):
+        dafBase.Trace.disable()
+        dafBase.Trace.clear()
+
+    def flush(self):
+        with tempfile.NamedTemporaryFile(suffix=".json", delete=False) as f:
+            path = f.name
+        try:
+            count = dafBase.Trace.flush(path)
+            with open(path) as f:
+                events = json.load(f)["traceEvents"]
+        finally:
+            os.remove(path)
+        self.assertEqual(count, len(events))
+        return events
+
+    def testDisabled(self):
+        self.assertFalse(dafBase.Trace.isEnabled())
+        with dafBase.TraceSpan("ignored"):
+            pass
+        self.assertEqual(self.flush(), [])
+
+    def testSpans(self):
+        dafBase.Trace.enable()
+        self.assertTrue(dafBase.Trace.isEnabled())
+        with dafBase.TraceSpan("outer", "test"):
+            with dafBase.TraceSpan("inner"):
+                pass
+        dafBase.Trace.disable()
+        events = self.flush()
+        self.assertEqual([e["name"] for e in events], ["inner", "outer"])
+        self.assertEqual(events[0]["cat"], "python")
+        self.assertEqual(events[1]["cat"], "test")
+        for event in events:
+            self.assertEqual(event["ph"], "X")
+            self.assertGreaterEqual(event["dur"], 0.0)
+
+    def testPickle(self):
+        header = dafBase.PropertyList()
+        header.set("EXPTIME", 30.5, "exposure time")
+        header.set("DATE-OBS", dafBase.DateTime("2023-01-15T03:04:05Z", dafBase.DateTime.UTC))
+        dafBase.Trace.enable()
+        copy = pickle.loads(pickle.dumps(header))
+        dafBase.Trace.disable()
+        self.assertEqual(copy, header)
+        names = set(e["name"] for e in self.flush())
+        self.assertIn("getPropertyListState", names)
+        self.assertIn("setPropertyListState", names)
+
+    def testSampling(self):
+        dafBase.Trace.enable(10)
+        for i in range(100):
+            with dafBase.TraceSpan("sampled"):
+                pass
+        dafBase.Trace.disable()
+        self.assertEqual(len(self.flush()), 10)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -0,0 +1,62 @@
+// -*- lsst-c++ -*-
+/*
+ * This file is part of daf_base.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Compile the spans out, as a build with tracing removed would
+#define LSST_DAF_BASE_NO_TRACE
+
+#include <sstream>
+#include <string>
+
+#include "lsst/daf/base/Trace.h"
+
+#define BOOST_TEST_MODULE TraceDisabled
+#define BOOST_TEST_DYN_LINK
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+namespace dafBase = lsst::daf::base;
+
+#define STRINGIFY2(x) #x
+#define STRINGIFY(x) STRINGIFY2(x)
+
+// The span expands to nothing, so it cannot construct a TraceSpan
+static_assert(sizeof(STRINGIFY(LSST_DAF_BASE_TRACE_SPAN("removed"))) == 1,
+              "LSST_DAF_BASE_TRACE_SPAN must expand to nothing under LSST_DAF_BASE_NO_TRACE");
+
+BOOST_AUTO_TEST_SUITE(TraceDisabledSuite)
+
+BOOST_AUTO_TEST_CASE(compiledOut) {
+    dafBase::Trace::enable();
+    for (int i = 0; i < 10; ++i) {
+        LSST_DAF_BASE_TRACE_SPAN("removed");
+    }
+    dafBase::Trace::disable();
+    std::ostringstream os;
+    BOOST_CHECK_EQUAL(dafBase::Trace::flush(os), 0u);
+    BOOST_CHECK_EQUAL(os.str(), "{\"traceEvents\":[\n],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
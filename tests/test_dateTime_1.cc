@@ -20,6 +20,8 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <chrono>
+
 #include "lsst/daf/base/DateTime.h"
 
 #define BOOST_TEST_MODULE DateTime_1
@@ -97,4 +99,58 @@ BOOST_AUTO_TEST_CASE(Hash) {
     lsst::utils::assertHashesEqual(date1, DateTime(date1.nsecs()));
 }
 
+BOOST_AUTO_TEST_CASE(SystemClock) {
+    using namespace std::chrono;
+    DateTime dt("20090402T072639.314159265Z", DateTime::UTC);
+    DateTime::SystemTime const st = dt.toSystemTime();
+    BOOST_CHECK_EQUAL(st.time_since_epoch().count(), dt.nsecs(DateTime::UTC));
+    BOOST_CHECK(DateTime(st) == dt);
+    // Coarser durations are accepted
+    BOOST_CHECK(DateTime(time_point_cast<seconds>(st)) == DateTime("20090402T072639Z", DateTime::UTC));
+
+    // Across a leap second, UTC without leap seconds advances by one second less than TAI
+    DateTime before("2016-12-31T23:59:59Z", DateTime::UTC);
+    DateTime after("2017-01-01T00:00:00Z", DateTime::UTC);
+    BOOST_CHECK(after - before == seconds(2));
+    BOOST_CHECK(after.toSystemTime() - before.toSystemTime() == seconds(1));
+
+    BOOST_CHECK_THROW(DateTime().toSystemTime(), lsst::pex::exceptions::RuntimeError);
+    BOOST_CHECK_THROW(DateTime(DateTime::SystemTime(seconds(-500000000))),
+                      lsst::pex::exceptions::DomainError);
+}
+
+BOOST_AUTO_TEST_CASE(Durations) {
+    using namespace std::chrono;
+    DateTime dt("2009-04-02T07:26:39.314159265", DateTime::TAI);
+    BOOST_CHECK_EQUAL((dt + milliseconds(1500)).nsecs(), dt.nsecs() + 1500000000LL);
+    BOOST_CHECK_EQUAL((dt - nanoseconds(265)).nsecs(), dt.nsecs() - 265);
+    BOOST_CHECK(dt + hours(1) - dt == hours(1));
+    DateTime later(dt);
+    later += minutes(2);
+    later -= seconds(30);
+    BOOST_CHECK(later - dt == seconds(90));
+
+    DateTime invalid;
+    BOOST_CHECK(!(invalid + seconds(1)).isValid());
+    BOOST_CHECK_THROW(invalid - dt, lsst::pex::exceptions::RuntimeError);
+    BOOST_CHECK_THROW(dt - invalid, lsst::pex::exceptions::RuntimeError);
+}
+
+#if LSST_DAF_BASE_HAVE_TAI_CLOCK
+BOOST_AUTO_TEST_CASE(TaiUtcClocks) {
+    using namespace std::chrono;
+    // The epoch of tai_clock is 1958-01-01 TAI
+    constexpr DateTime taiEpoch{tai_seconds(seconds(0))};
+    static_assert(taiEpoch.toTaiTime().time_since_epoch() == seconds(0), "constexpr round trip");
+    BOOST_CHECK(taiEpoch == DateTime("1958-01-01T00:00:00", DateTime::TAI));
+
+    DateTime dt("20090402T072639.314159265Z", DateTime::UTC);
+    BOOST_CHECK(DateTime(dt.toTaiTime()) == dt);
+    BOOST_CHECK(DateTime(dt.toUtcTime()) == dt);
+    BOOST_CHECK(dt.toTaiTime() == clock_cast<tai_clock>(dt.toUtcTime()));
+    BOOST_CHECK(clock_cast<system_clock>(dt.toUtcTime()) == dt.toSystemTime());
+    BOOST_CHECK(DateTime(clock_cast<utc_clock>(dt.toSystemTime())) == dt);
+}
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()